@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include "categories.h"
 
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
 struct _category {
   enum category cat: 8;
   uint_least32_t first: 24;
@@ -38,3 +39,17 @@ enum category category(wint_t ucs)
   return bisearch_cat(ucs, categories,
 		      sizeof(categories) / sizeof(*categories) - 1);
 }
+#else /* !PREFER_SIZE_OVER_SPEED */
+/* The same data as categories.t in a two-stage table, indexed by the
+   block of 128 characters and the character within it; blocks with
+   the same contents share their leaf.  */
+#include "categories2.t"
+
+enum category category(wint_t ucs)
+{
+  if (ucs >= CATEGORY_LIMIT)
+    return -1;
+  return category_values[category_leaf[category_index[ucs >> CATEGORY_SHIFT]]
+					[ucs & ((1 << CATEGORY_SHIFT) - 1)]];
+}
+#endif /* !PREFER_SIZE_OVER_SPEED */
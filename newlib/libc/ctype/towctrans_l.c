@@ -35,13 +35,15 @@
  */
 enum {TO1, TOLO, TOUP, TOBOTH};
 enum {EVENCAP, ODDCAP};
-static struct caseconv_entry {
+struct caseconv_entry {
   uint_least32_t first: 21;
   uint_least32_t diff: 8;
   uint_least32_t mode: 2;
   int_least32_t delta: 17;
-} __attribute__ ((packed))
-caseconv_table [] = {
+} __attribute__ ((packed));
+
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+static const struct caseconv_entry caseconv_table [] = {
 #include "caseconv.t"
 };
 #define first(ce)	ce.first
@@ -69,12 +71,35 @@ bisearch (wint_t ucs, const struct caseconv_entry *table, int max)
   return 0;
 }
 
+static const struct caseconv_entry *
+lookup (wint_t ucs)
+{
+  return bisearch(ucs, caseconv_table,
+		  sizeof(caseconv_table) / sizeof(*caseconv_table) - 1);
+}
+#else /* !PREFER_SIZE_OVER_SPEED */
+/* caseconv.t as a two-stage table: per block of 128 characters, a
+   leaf of indices into caseconv_values, whose first and diff fields
+   are unused.  Index 0 means no conversion.  */
+#include "caseconv2.t"
+
+static const struct caseconv_entry *
+lookup (wint_t ucs)
+{
+  unsigned int i;
+
+  if (ucs >= CASECONV_LIMIT)
+    return 0;
+  i = caseconv_leaf[caseconv_index[ucs >> CASECONV_SHIFT]]
+		   [ucs & ((1 << CASECONV_SHIFT) - 1)];
+  return i ? &caseconv_values[i] : 0;
+}
+#endif /* !PREFER_SIZE_OVER_SPEED */
+
 static wint_t
 toulower (wint_t c)
 {
-  const struct caseconv_entry * cce =
-    bisearch(c, caseconv_table,
-             sizeof(caseconv_table) / sizeof(*caseconv_table) - 1);
+  const struct caseconv_entry * cce = lookup (c);
 
   if (cce)
     switch (cce->mode)
@@ -107,9 +132,7 @@ toulower (wint_t c)
 static wint_t
 touupper (wint_t c)
 {
-  const struct caseconv_entry * cce =
-    bisearch(c, caseconv_table,
-             sizeof(caseconv_table) / sizeof(*caseconv_table) - 1);
+  const struct caseconv_entry * cce = lookup (c);
 
   if (cce)
     switch (cce->mode)
@@ -100,6 +100,39 @@ ucs_4_convert_from_ucs (void *data,
 
   return sizeof (ucs4_t);
 }
+
+static size_t
+ucs_4_convert_from_ucs_block (void *data,
+                              const ucs4_t *in,
+                              size_t n,
+                              unsigned char **outbuf,
+                              size_t *outbytesleft)
+{
+  unsigned char *cp = *outbuf;
+  size_t i;
+  ucs4_t c;
+  int s = *((int *)data) == UCS_4_BIG_ENDIAN ? 0 : 3;
+
+  if (n > *outbytesleft / sizeof (ucs4_t))
+    n = *outbytesleft / sizeof (ucs4_t);
+
+  for (i = 0; i < n; i++, cp += sizeof (ucs4_t))
+    {
+      c = in[i];
+      if ((c >= 0x0000D800 && c <= 0x0000DFFF)
+          || c > 0x7FFFFFFF || c == 0x0000FFFF || c == 0x0000FFFE)
+        break;
+      cp[0 ^ s] = (unsigned char)(c >> 24);
+      cp[1 ^ s] = (unsigned char)(c >> 16);
+      cp[2 ^ s] = (unsigned char)(c >> 8);
+      cp[3 ^ s] = (unsigned char)c;
+    }
+
+  *outbytesleft -= cp - *outbuf;
+  *outbuf = cp;
+
+  return i;
+}
 #endif /* ICONV_FROM_UCS_CES_UCS_4 */
 
 #if defined (ICONV_TO_UCS_CES_UCS_4)
@@ -127,6 +160,37 @@ ucs_4_convert_to_ucs (void *data,
   
   return res;
 }
+
+static size_t
+ucs_4_convert_to_ucs_block (void *data,
+                            const unsigned char **inbuf,
+                            size_t *inbytesleft,
+                            ucs4_t *out,
+                            size_t n)
+{
+  const unsigned char *cp = *inbuf;
+  size_t i;
+  ucs4_t c;
+  int s = *((int *)data) == UCS_4_BIG_ENDIAN ? 0 : 3;
+
+  if (n > *inbytesleft / sizeof (ucs4_t))
+    n = *inbytesleft / sizeof (ucs4_t);
+
+  for (i = 0; i < n; i++, cp += sizeof (ucs4_t))
+    {
+      c = ((ucs4_t)cp[0 ^ s] << 24) | ((ucs4_t)cp[1 ^ s] << 16)
+          | ((ucs4_t)cp[2 ^ s] << 8) | cp[3 ^ s];
+      if ((c >= 0x0000D800 && c <= 0x0000DFFF)
+          || c > 0x7FFFFFFF || c == 0x0000FFFF || c == 0x0000FFFE)
+        break;
+      out[i] = c;
+    }
+
+  *inbytesleft -= cp - *inbuf;
+  *inbuf = cp;
+
+  return i;
+}
 #endif /* ICONV_TO_UCS_CES_UCS_4 */
 
 static int
@@ -145,7 +209,8 @@ _iconv_to_ucs_ces_handlers_ucs_4 =
   NULL,
   NULL,
   NULL,
-  ucs_4_convert_to_ucs
+  ucs_4_convert_to_ucs,
+  ucs_4_convert_to_ucs_block
 };
 #endif
 
@@ -159,7 +224,8 @@ _iconv_from_ucs_ces_handlers_ucs_4 =
   NULL,
   NULL,
   NULL,
-  ucs_4_convert_from_ucs
+  ucs_4_convert_from_ucs,
+  ucs_4_convert_from_ucs_block
 };
 #endif
 
@@ -163,6 +163,63 @@ utf_16_convert_from_ucs (void *data,
 
   return bytes;
 }
+
+static size_t
+utf_16_convert_from_ucs_block (void *data,
+                               const ucs4_t *in,
+                               size_t n,
+                               unsigned char **outbuf,
+                               size_t *outbytesleft)
+{
+  unsigned char *cp = *outbuf;
+  unsigned char *end = cp + *outbytesleft;
+  const ucs4_t *ip = in;
+  const ucs4_t *iend = in + n;
+  int state = *(int *)data;
+  int big;
+  ucs4_t c;
+  ucs2_t w1, w2;
+
+  /* The BOM is written by utf_16_convert_from_ucs */
+  if (state == UTF16_SYSTEM_ENDIAN)
+    return 0;
+  if (state == (UTF16_SYSTEM_ENDIAN | UTF16_BOM_WRITTEN))
+    big = ICONV_HTOBES (1) == 1;
+  else
+    big = state == UTF16_BIG_ENDIAN;
+
+  for (; ip < iend; ip++)
+    {
+      c = *ip;
+      if (c < 0x10000)
+        {
+          if ((c >= 0xD800 && c <= 0xDFFF) || c >= 0xFFFE || end - cp < 2)
+            break;
+          w1 = (ucs2_t)c;
+          cp[big ? 0 : 1] = (unsigned char)(w1 >> 8);
+          cp[big ? 1 : 0] = (unsigned char)w1;
+          cp += 2;
+        }
+      else
+        {
+          if (c > 0x0010FFFF || end - cp < 4)
+            break;
+          c -= 0x00010000;
+          w1 = (ucs2_t)(c >> 10) | 0xD800;
+          w2 = (ucs2_t)(c & 0x000003FF) | 0xDC00;
+          cp[big ? 0 : 1] = (unsigned char)(w1 >> 8);
+          cp[big ? 1 : 0] = (unsigned char)w1;
+          cp[big ? 2 : 3] = (unsigned char)(w2 >> 8);
+          cp[big ? 3 : 2] = (unsigned char)w2;
+          cp += 4;
+        }
+    }
+
+  *outbytesleft -= cp - *outbuf;
+  *outbuf = cp;
+
+  return ip - in;
+}
 #endif /* ICONV_FROM_UCS_CES_UTF_16 */
 
 #if defined (ICONV_TO_UCS_CES_UTF_16)
@@ -260,6 +317,55 @@ utf_16_convert_to_ucs (void *data,
   
   return res;
 }
+
+static size_t
+utf_16_convert_to_ucs_block (void *data,
+                             const unsigned char **inbuf,
+                             size_t *inbytesleft,
+                             ucs4_t *out,
+                             size_t n)
+{
+  const unsigned char *in = *inbuf;
+  const unsigned char *end = in + (*inbytesleft & ~(size_t)1);
+  ucs4_t *op = out;
+  ucs4_t *oend = out + n;
+  int state = *(int *)data;
+  int hi, lo;
+  ucs2_t w1, w2;
+
+  /* The BOM is looked for by utf_16_convert_to_ucs */
+  if (state == UTF16_UNDEFINED)
+    return 0;
+  hi = state == UTF16_LITTLE_ENDIAN;
+  lo = !hi;
+
+  for (; op < oend && in < end; op++)
+    {
+      w1 = (ucs2_t)(in[hi] << 8) | in[lo];
+      if (w1 < 0xD800 || w1 > 0xDFFF)
+        {
+          if (w1 >= 0xFFFE)
+            break;
+          *op = w1;
+          in += 2;
+        }
+      else
+        {
+          if (w1 > 0xDBFF || end - in < 4)
+            break;
+          w2 = (ucs2_t)(in[2 + hi] << 8) | in[2 + lo];
+          if (w2 < 0xDC00 || w2 > 0xDFFF)
+            break;
+          *op = (((ucs4_t)(w1 & 0x03FF) << 10) | (w2 & 0x03FF)) + 0x00010000;
+          in += 4;
+        }
+    }
+
+  *inbytesleft -= in - *inbuf;
+  *inbuf = in;
+
+  return op - out;
+}
 #endif /* ICONV_TO_UCS_CES_UTF_16 */
 
 static int
@@ -278,7 +384,8 @@ _iconv_to_ucs_ces_handlers_utf_16 =
   NULL,
   NULL,
   NULL,
-  utf_16_convert_to_ucs
+  utf_16_convert_to_ucs,
+  utf_16_convert_to_ucs_block
 };
 #endif
 
@@ -292,7 +399,8 @@ _iconv_from_ucs_ces_handlers_utf_16 =
   NULL,
   NULL,
   NULL,
-  utf_16_convert_from_ucs
+  utf_16_convert_from_ucs,
+  utf_16_convert_from_ucs_block
 };
 #endif
 
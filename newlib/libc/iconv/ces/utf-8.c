@@ -31,6 +31,7 @@
 #include <_ansi.h>
 #include <reent.h>
 #include <sys/types.h>
+#include <string.h>
 #include "../lib/local.h"
 #include "../lib/ucsconv.h"
 
@@ -120,6 +121,77 @@ convert_from_ucs (void *data,
   
   return bytes;
 }
+
+static size_t
+convert_from_ucs_block (void *data,
+                        const ucs4_t *in,
+                        size_t n,
+                        unsigned char **outbuf,
+                        size_t *outbytesleft)
+{
+  unsigned char *cp = *outbuf;
+  unsigned char *end = cp + *outbytesleft;
+  const ucs4_t *ip = in;
+  const ucs4_t *iend = in + n;
+  ucs4_t c;
+
+  while (ip < iend)
+    {
+      /* Four ASCII characters at a time */
+      if (iend - ip >= 4 && end - cp >= 4
+          && (ip[0] | ip[1] | ip[2] | ip[3]) < 0x80)
+        {
+          cp[0] = (unsigned char)ip[0];
+          cp[1] = (unsigned char)ip[1];
+          cp[2] = (unsigned char)ip[2];
+          cp[3] = (unsigned char)ip[3];
+          cp += 4;
+          ip += 4;
+          continue;
+        }
+
+      c = *ip;
+      if (c < 0x80)
+        {
+          if (cp == end)
+            break;
+          *cp++ = (unsigned char)c;
+        }
+      else if (c < 0x800)
+        {
+          if (end - cp < 2)
+            break;
+          *cp++ = (unsigned char)((c >> 6) | 0xC0);
+          *cp++ = (unsigned char)((c & 0x3F) | 0x80);
+        }
+      else if (c < 0x10000)
+        {
+          if ((c >= 0xD800 && c <= 0xDFFF) || c >= 0xFFFE || end - cp < 3)
+            break;
+          *cp++ = (unsigned char)((c >> 12) | 0xE0);
+          *cp++ = (unsigned char)(((c >> 6) & 0x3F) | 0x80);
+          *cp++ = (unsigned char)((c & 0x3F) | 0x80);
+        }
+      else if (c < 0x200000)
+        {
+          if (end - cp < 4)
+            break;
+          *cp++ = (unsigned char)((c >> 18) | 0xF0);
+          *cp++ = (unsigned char)(((c >> 12) & 0x3F) | 0x80);
+          *cp++ = (unsigned char)(((c >> 6) & 0x3F) | 0x80);
+          *cp++ = (unsigned char)((c & 0x3F) | 0x80);
+        }
+      else
+        /* Five and six byte forms and errors are left to convert_from_ucs */
+        break;
+      ip++;
+    }
+
+  *outbytesleft -= cp - *outbuf;
+  *outbuf = cp;
+
+  return ip - in;
+}
 #endif /* ICONV_FROM_UCS_CES_UTF_8 */
 
 #if defined (ICONV_TO_UCS_CES_UTF_8)
@@ -254,6 +326,90 @@ convert_to_ucs (void *data,
 
   return res;
 }
+
+/* Mask of the high bits of the bytes of an unsigned long */
+#define HIGH_BITS (~0UL / 0xFF * 0x80)
+
+static size_t
+convert_to_ucs_block (void *data,
+                      const unsigned char **inbuf,
+                      size_t *inbytesleft,
+                      ucs4_t *out,
+                      size_t n)
+{
+  const unsigned char *in = *inbuf;
+  const unsigned char *end = in + *inbytesleft;
+  ucs4_t *op = out;
+  ucs4_t *oend = out + n;
+  unsigned long w;
+  ucs4_t c;
+  size_t i;
+
+  while (op < oend && in < end)
+    {
+      /* A word of ASCII at a time */
+      if ((size_t)(end - in) >= sizeof (w)
+          && (size_t)(oend - op) >= sizeof (w))
+        {
+          memcpy (&w, in, sizeof (w));
+          if ((w & HIGH_BITS) == 0)
+            {
+              for (i = 0; i < sizeof (w); i++)
+                op[i] = in[i];
+              op += sizeof (w);
+              in += sizeof (w);
+              continue;
+            }
+        }
+
+      c = in[0];
+      if (c < 0x80)
+        {
+          *op++ = c;
+          in++;
+        }
+      else if (c >= 0xC2 && c < 0xE0)
+        {
+          if (end - in < 2 || (in[1] & 0xC0) != 0x80)
+            break;
+          *op++ = ((c & 0x1F) << 6) | (in[1] & 0x3F);
+          in += 2;
+        }
+      else if (c >= 0xE0 && c < 0xF0)
+        {
+          if (end - in < 3 || (in[1] & 0xC0) != 0x80
+              || (in[2] & 0xC0) != 0x80)
+            break;
+          c = ((c & 0x0F) << 12) | ((ucs4_t)(in[1] & 0x3F) << 6)
+              | (in[2] & 0x3F);
+          /* Overlong, surrogate, U'FFFE and U'FFFF */
+          if (c < 0x800 || (c >= 0xD800 && c <= 0xDFFF) || c >= 0xFFFE)
+            break;
+          *op++ = c;
+          in += 3;
+        }
+      else if (c >= 0xF0 && c < 0xF8)
+        {
+          if (end - in < 4 || (in[1] & 0xC0) != 0x80
+              || (in[2] & 0xC0) != 0x80 || (in[3] & 0xC0) != 0x80)
+            break;
+          c = ((c & 0x07) << 18) | ((ucs4_t)(in[1] & 0x3F) << 12)
+              | ((ucs4_t)(in[2] & 0x3F) << 6) | (in[3] & 0x3F);
+          if (c < 0x10000)
+            break;
+          *op++ = c;
+          in += 4;
+        }
+      else
+        /* Five and six byte forms and errors are left to convert_to_ucs */
+        break;
+    }
+
+  *inbytesleft -= in - *inbuf;
+  *inbuf = in;
+
+  return op - out;
+}
 #endif /* ICONV_TO_UCS_CES_UTF_8 */
 
 static int
@@ -272,7 +428,8 @@ _iconv_to_ucs_ces_handlers_utf_8 =
   NULL,
   NULL,
   NULL,
-  convert_to_ucs
+  convert_to_ucs,
+  convert_to_ucs_block
 };
 #endif
 
@@ -286,7 +443,8 @@ _iconv_from_ucs_ces_handlers_utf_8 =
   NULL,
   NULL,
   NULL,
-  convert_from_ucs
+  convert_from_ucs,
+  convert_from_ucs_block
 };
 #endif
 
@@ -141,6 +141,55 @@ ucs_based_conversion_close (struct _reent *rptr,
 }
 
 
+/*
+ * Convert as much of the input as both CES converters can handle in blocks,
+ * passing runs of up to ICONV_UCS_BLOCK_LEN characters through a UCS-4
+ * array instead of making two calls per character. Stops before the first
+ * character either converter leaves to its per-character function; that
+ * also reports errors.
+ */
+#define ICONV_UCS_BLOCK_LEN 64
+
+static void
+ucs_based_conversion_convert_blocks (iconv_ucs_conversion_t *uc,
+                                     const unsigned char **inbuf,
+                                     size_t *inbytesleft,
+                                     unsigned char **outbuf,
+                                     size_t *outbytesleft)
+{
+  ucs4_t buf[ICONV_UCS_BLOCK_LEN];
+  const unsigned char *inbuf_save;
+  size_t inbytesleft_save;
+  size_t n, m;
+
+  while (*inbytesleft > 0)
+    {
+      inbuf_save = *inbuf;
+      inbytesleft_save = *inbytesleft;
+
+      n = uc->to_ucs.handlers->convert_to_ucs_block (uc->to_ucs.data,
+                                                     inbuf, inbytesleft,
+                                                     buf, ICONV_UCS_BLOCK_LEN);
+      if (n == 0)
+        return;
+
+      m = uc->from_ucs.handlers->convert_from_ucs_block (uc->from_ucs.data,
+                                                         buf, n, outbuf,
+                                                         outbytesleft);
+      if (m < n)
+        {
+          /* Consume only the input of the characters written */
+          *inbuf = inbuf_save;
+          *inbytesleft = inbytesleft_save;
+          if (m > 0)
+            uc->to_ucs.handlers->convert_to_ucs_block (uc->to_ucs.data,
+                                                       inbuf, inbytesleft,
+                                                       buf, m);
+          return;
+        }
+    }
+}
+
 static size_t
 ucs_based_conversion_convert (struct _reent *rptr,
                  void *data,
@@ -154,13 +203,27 @@ ucs_based_conversion_convert (struct _reent *rptr,
   unsigned char *poutbuf1;
   size_t res = 0;
   iconv_ucs_conversion_t *uc = (iconv_ucs_conversion_t *)data;
+  int blocks = uc->to_ucs.handlers->convert_to_ucs_block != NULL
+               && uc->from_ucs.handlers->convert_from_ucs_block != NULL
+               && !(flags & ICONV_DONT_SAVE_BIT);
 
   while (*inbytesleft > 0)
     {
       register size_t bytes;
       register ucs4_t ch;
-      const unsigned char *inbuf_save = *inbuf;
-      size_t inbyteslef_save = *inbytesleft;
+      const unsigned char *inbuf_save;
+      size_t inbyteslef_save;
+
+      if (blocks)
+        {
+          ucs_based_conversion_convert_blocks (uc, inbuf, inbytesleft,
+                                               outbuf, outbytesleft);
+          if (*inbytesleft == 0)
+            break;
+        }
+
+      inbuf_save = *inbuf;
+      inbyteslef_save = *inbytesleft;
 
       if (*outbytesleft == 0)
         {
@@ -158,6 +158,32 @@ typedef struct
   ucs4_t (*convert_to_ucs) (void *data,
                                  const unsigned char **inbuf,
                                  size_t *inbytesleft);
+
+  /*
+   * convert_to_ucs_block - convert a run of characters to UCS.
+   *
+   * PARAMETERS:
+   *   void *data               - CES converter-specific data;
+   *   const unsigned char **inbuf - buffer with input byte sequence;
+   *   size_t *inbytesleft          - input buffer bytes count;
+   *   ucs4_t *out                  - array for the resulting UCS codes;
+   *   size_t n                     - size of 'out' array.
+   *
+   * DESCRIPTION:
+   *   Optional. Converts up to 'n' input characters into 'out', giving the
+   *   same codes as 'convert_to_ucs' would, and stops before the first
+   *   invalid or incomplete character, or any character it leaves to
+   *   'convert_to_ucs'. 'inbuf' and 'inbytesleft' are updated past the
+   *   converted characters. Must not change the converter's state.
+   *
+   * RETURN:
+   *   Returns the number of characters converted, which may be 0.
+   */
+  size_t (*convert_to_ucs_block) (void *data,
+                                  const unsigned char **inbuf,
+                                  size_t *inbytesleft,
+                                  ucs4_t *out,
+                                  size_t n);
 } iconv_to_ucs_ces_handlers_t;
 
 
@@ -219,6 +245,32 @@ typedef struct
                                    ucs4_t in,
                                    unsigned char **outbuf,
                                    size_t *outbytesleft);
+
+  /*
+   * convert_from_ucs_block - convert a run of UCS characters.
+   *
+   * PARAMETERS:
+   *   void *data         - CES converter-specific data;
+   *   const ucs4_t *in       - input UCS-4 characters;
+   *   size_t n               - number of input characters;
+   *   unsigned char **outbuf - output buffer for the result;
+   *   size_t *outbytesleft   - output buffer bytes count.
+   *
+   * DESCRIPTION:
+   *   Optional. Converts characters from 'in' as 'convert_from_ucs' would,
+   *   and stops before the first one which has no correspondent character
+   *   in destination encoding or does not fit in the output buffer, or
+   *   which it leaves to 'convert_from_ucs'. 'outbuf' and 'outbytesleft'
+   *   are updated accordingly. Must not change the converter's state.
+   *
+   * RETURN:
+   *   Returns the number of characters converted, which may be 0.
+   */
+  size_t (*convert_from_ucs_block) (void *data,
+                                    const ucs4_t *in,
+                                    size_t n,
+                                    unsigned char **outbuf,
+                                    size_t *outbytesleft);
 } iconv_from_ucs_ces_handlers_t;
 
 
@@ -0,0 +1,68 @@
+/* Fixed-point arithmetic for programs that cannot use floating point.
+
+   Two formats are provided, both 128 bits wide and computed with 64-bit
+   integer operations only:
+
+   fxq64_t	signed binary fixed point, HI + LO / 2^64, with HI the
+		integer part rounded down and LO the fraction.
+   fxd18_t	unsigned decimal fixed point, (HI * 2^64 + LO) / 10^18,
+		the "18 decimals" scaling used for token amounts.
+
+   Every function stores its result through the first argument and
+   returns 0, or EDOM or ERANGE from <errno.h> when the argument is out
+   of the domain or the result does not fit, leaving the result alone.
+   Results are the same on every target.  */
+
+#ifndef _FIXMATH_H_
+#define _FIXMATH_H_
+
+#include <sys/cdefs.h>
+#include <machine/_default_types.h>
+
+typedef struct
+{
+  __int64_t hi;
+  __uint64_t lo;
+} fxq64_t;
+
+typedef struct
+{
+  __uint64_t hi;
+  __uint64_t lo;
+} fxd18_t;
+
+/* Rounding of the multiplications, divisions and square roots.  */
+#define FX_TONEAREST	0	/* to nearest, ties to even */
+#define FX_TOWARDZERO	1
+#define FX_UPWARD	2
+#define FX_DOWNWARD	3
+
+__BEGIN_DECLS
+int	fxq64_add (fxq64_t *, fxq64_t, fxq64_t);
+int	fxq64_sub (fxq64_t *, fxq64_t, fxq64_t);
+int	fxq64_mul (fxq64_t *, fxq64_t, fxq64_t, int);
+int	fxq64_div (fxq64_t *, fxq64_t, fxq64_t, int);
+int	fxq64_sqrt (fxq64_t *, fxq64_t, int);
+int	fxq64_log2 (fxq64_t *, fxq64_t);
+int	fxq64_ln (fxq64_t *, fxq64_t);
+int	fxq64_exp2 (fxq64_t *, fxq64_t);
+int	fxq64_exp (fxq64_t *, fxq64_t);
+int	fxq64_pow (fxq64_t *, fxq64_t, fxq64_t);
+
+int	fxd18_add (fxd18_t *, fxd18_t, fxd18_t);
+int	fxd18_sub (fxd18_t *, fxd18_t, fxd18_t);
+int	fxd18_mul (fxd18_t *, fxd18_t, fxd18_t, int);
+int	fxd18_div (fxd18_t *, fxd18_t, fxd18_t, int);
+int	fxd18_sqrt (fxd18_t *, fxd18_t, int);
+int	fxd18_log2 (fxd18_t *, fxd18_t);
+int	fxd18_ln (fxd18_t *, fxd18_t);
+int	fxd18_exp2 (fxd18_t *, fxd18_t);
+int	fxd18_exp (fxd18_t *, fxd18_t);
+int	fxd18_pow (fxd18_t *, fxd18_t, fxd18_t);
+
+fxd18_t	fxd18_from_uint (__uint64_t);
+int	fxd18_from_q64 (fxd18_t *, fxq64_t, int);
+int	fxq64_from_d18 (fxq64_t *, fxd18_t, int);
+__END_DECLS
+
+#endif /* _FIXMATH_H_ */
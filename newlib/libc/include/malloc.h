@@ -166,6 +166,54 @@ extern void _mstats_r (struct _reent *, char *);
 extern void cfree (void *);
 #endif /* __CYGWIN__ */
 
+#ifdef _MALLOC_STATS
+
+/* Allocator instrumentation, available when newlib is configured with
+   --enable-newlib-malloc-stats.  */
+
+#define MALLSTATS_NCLASSES 16
+
+struct mallstats {
+  size_t nmalloc;      /* chunks handed out */
+  size_t nfree;        /* chunks given back */
+  size_t nrealloc;     /* calls to realloc with a non-NULL pointer */
+  size_t nfail;        /* allocation requests that failed */
+  size_t requested;    /* total bytes requested */
+  size_t granted;      /* total bytes granted, overhead included */
+  size_t inuse;        /* bytes in chunks currently allocated */
+  size_t peak_inuse;   /* high-water mark of inuse */
+  size_t heap;         /* bytes currently obtained from the system */
+  size_t peak_heap;    /* high-water mark of heap */
+  size_t free_chunks;  /* number of chunks on the free lists */
+  size_t free_bytes;   /* total size of those chunks */
+  size_t largest_free; /* size of the largest of them */
+  size_t trace_lost;   /* trace events overwritten before being read */
+  /* Allocations by requested size: class 0 counts requests of up to
+     8 bytes, class N those of up to 8 << N bytes, and the last class
+     everything larger.  */
+  size_t hist[MALLSTATS_NCLASSES];
+};
+
+#define MALLOC_EVENT_ALLOC   1  /* ptr, chunk size */
+#define MALLOC_EVENT_FREE    2  /* ptr, chunk size */
+#define MALLOC_EVENT_REALLOC 3  /* old ptr, requested size */
+#define MALLOC_EVENT_RESIZE  4  /* ptr, new chunk size (resized in place) */
+#define MALLOC_EVENT_FAIL    5  /* NULL, requested size */
+
+struct malloc_event {
+  int type;
+  void *ptr;
+  size_t size;
+};
+
+extern int mallstats (struct mallstats *);
+extern int _mallstats_r (struct _reent *, struct mallstats *);
+
+extern int malloc_trace (int);
+extern size_t malloc_trace_read (struct malloc_event *, size_t);
+
+#endif /* _MALLOC_STATS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -349,7 +349,7 @@ extern double lgamma (double);
 extern double erf (double);
 extern double erfc (double);
 extern double log2 (double);
-#if !defined(__cplusplus)
+#if !defined(__cplusplus) && !defined(_INTEGER_MATH)
 #define log2(x) (log (x) / _M_LN2)
 #endif
 
@@ -318,6 +318,8 @@ extern bool_t xdr_enum (XDR *, enum_t *);
 extern bool_t xdr_array (XDR *, char **, u_int *, u_int, u_int, xdrproc_t);
 extern bool_t xdr_bytes (XDR *, char **, u_int *, u_int);
 extern bool_t xdr_opaque (XDR *, char *, u_int);
+extern bool_t xdr_opaque_ref (XDR *, char **, u_int);
+extern bool_t xdr_bytes_ref (XDR *, char **, u_int *, u_int);
 extern bool_t xdr_string (XDR *, char **, u_int);
 extern bool_t xdr_union (XDR *, enum_t *, char *,
                                   const struct xdr_discrim *, xdrproc_t);
@@ -326,6 +328,14 @@ extern bool_t xdr_u_char (XDR *, u_char *);
 extern bool_t xdr_vector (XDR *, char *, u_int, u_int, xdrproc_t);
 extern bool_t xdr_float (XDR *, float *);
 extern bool_t xdr_double (XDR *, double *);
+extern bool_t xdr_int32_array (XDR *, int32_t *, u_int);
+extern bool_t xdr_uint32_array (XDR *, uint32_t *, u_int);
+#if defined(___int64_t_defined)
+extern bool_t xdr_int64_array (XDR *, int64_t *, u_int);
+extern bool_t xdr_uint64_array (XDR *, uint64_t *, u_int);
+#endif /* ___int64_t_defined */
+extern bool_t xdr_float_array (XDR *, float *, u_int);
+extern bool_t xdr_double_array (XDR *, double *, u_int);
 /* extern bool_t xdr_quadruple (XDR *, long double *); */
 extern bool_t xdr_reference (XDR *, char **, u_int, xdrproc_t);
 extern bool_t xdr_pointer (XDR *, char **, u_int, xdrproc_t);
@@ -359,6 +369,15 @@ extern bool_t xdr_netobj (XDR *, struct netobj *);
 /* XDR using memory buffers */
 extern void xdrmem_create (XDR *, char *, u_int, enum xdr_op);
 
+/* XDR using a chain of memory buffers, without copying */
+struct xdr_iovec
+{
+  void *iov_base;
+  size_t iov_len;
+};
+extern void xdriov_create (XDR *, const struct xdr_iovec *, u_int,
+                                    enum xdr_op);
+
 /* XDR using stdio library */
 #if defined(_STDIO_H_)
 extern void xdrstdio_create (XDR *, FILE *, enum xdr_op);
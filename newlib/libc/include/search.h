@@ -33,13 +33,15 @@ typedef enum {
 typedef struct node {
 	char         *key;
 	struct node  *llink, *rlink;
+	int           height;		/* of the AVL subtree rooted here */
 } node_t;
 #endif
 
 struct hsearch_data
 {
-  struct internal_head *htable;
+  void *htable;
   size_t htablesize;
+  size_t hfilled;
 };
 
 #ifndef __compar_fn_t_defined
@@ -59,6 +61,26 @@ void	tdestroy (void *, void (*)(void *));
 void	*tfind(const void *, void **, __compar_fn_t);
 void	*tsearch(const void *, void **, __compar_fn_t);
 void      twalk(const void *, void (*)(const void *, VISIT, int));
+#if __MISC_VISIBLE || defined(_SEARCH_PRIVATE)
+/* Node allocator for tsearch_pool and friends.  Zero-initialize it
+   before first use; tpool_destroy hands its memory back.  */
+struct tpool {
+	void	*__free;		/* recycled nodes */
+	void	*__chunks;		/* blocks the nodes are carved from */
+	size_t	 __left;		/* unused nodes in the newest block */
+};
+
+void	*tdelete_pool(const void *__restrict, void **__restrict,
+	    __compar_fn_t, struct tpool *);
+void	tdestroy_pool(void *, void (*)(void *), struct tpool *);
+void	*tsearch_pool(const void *, void **, __compar_fn_t, struct tpool *);
+void	tpool_destroy(struct tpool *);
+#endif
+#ifdef _SEARCH_PRIVATE
+int	__tbalance(node_t **);
+node_t	*__tnode_alloc(struct tpool *);
+void	__tnode_free(struct tpool *, node_t *);
+#endif
 __END_DECLS
 
 #endif /* !_SEARCH_H_ */
@@ -328,6 +328,14 @@ int	vsiscanf (const char *, const char *, __VALIST)
 int	vsniprintf (char *, size_t, const char *, __VALIST)
                _ATTRIBUTE ((__format__ (__printf__, 3, 0)));
 #endif /* __MISC_VISIBLE */
+#elif defined (_SOLANA_SOURCE)
+/* SBF is _REENT_ONLY, but libc/machine/sbf provides these.  */
+int	sprintf (char *__restrict, const char *__restrict, ...)
+               _ATTRIBUTE ((__format__ (__printf__, 2, 3)));
+int	snprintf (char *__restrict, size_t, const char *__restrict, ...)
+               _ATTRIBUTE ((__format__ (__printf__, 3, 4)));
+int	vsnprintf (char *__restrict, size_t, const char *__restrict, __VALIST)
+               _ATTRIBUTE ((__format__ (__printf__, 3, 0)));
 #endif /* !_REENT_ONLY */
 
 /*
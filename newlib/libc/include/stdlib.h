@@ -87,6 +87,15 @@ void *	bsearch (const void *__key,
 		       size_t __nmemb,
 		       size_t __size,
 		       __compar_fn_t _compar);
+#if __MISC_VISIBLE
+size_t	bsearch_batch (void *__keys,
+		       size_t __nkeys,
+		       const void *__base,
+		       size_t __nmemb,
+		       size_t __size,
+		       __compar_fn_t _compar,
+		       void **__found);
+#endif
 void	*calloc(size_t, size_t) __malloc_like __result_use_check
 	     __alloc_size2(1, 2) _NOTHROW;
 div_t	div (int __numer, int __denom);
@@ -223,9 +232,13 @@ char *	ecvtf (float,int,int *,int *);
 #endif
 char *	__itoa (int, char *, int);
 char *	__utoa (unsigned, char *, int);
+char *	__ltoa (long, char *, int);
+char *	__ultoa (unsigned long, char *, int);
 #if __MISC_VISIBLE
 char *	itoa (int, char *, int);
 char *	utoa (unsigned, char *, int);
+char *	ltoa (long, char *, int);
+char *	ultoa (unsigned long, char *, int);
 #endif
 #if __POSIX_VISIBLE
 int	rand_r (unsigned *__seed);
@@ -80,6 +80,9 @@ struct tm *gmtime_r 	(const time_t *__restrict,
 				 struct tm *__restrict);
 struct tm *localtime_r 	(const time_t *__restrict,
 				 struct tm *__restrict);
+#if __MISC_VISIBLE
+time_t	   timegm (struct tm *_timeptr);
+#endif
 
 _END_STD_C
 
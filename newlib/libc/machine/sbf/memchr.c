@@ -0,0 +1,51 @@
+/*
+ * memchr.c -- memchr function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+void *
+memchr (const void *src_void,
+	int c,
+	size_t length)
+{
+  const unsigned char *src = (const unsigned char *) src_void;
+  unsigned char d = c;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *aligned;
+  uint64_t rep, mask;
+
+  while (SBF_UNALIGNED (src))
+    {
+      if (!length--)
+	return NULL;
+      if (*src == d)
+	return (void *) src;
+      src++;
+    }
+
+  rep = __sbf_repeat (d);
+  aligned = (const uint64_t *) src;
+  while (length >= SBF_WORD_SIZE)
+    {
+      if ((mask = __sbf_zero_bytes (*aligned ^ rep)) != 0)
+	return (void *) ((const unsigned char *) aligned
+			 + __sbf_first_byte (mask));
+      length -= SBF_WORD_SIZE;
+      aligned++;
+    }
+
+  src = (const unsigned char *) aligned;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while (length--)
+    {
+      if (*src == d)
+	return (void *) src;
+      src++;
+    }
+
+  return NULL;
+}
@@ -0,0 +1,84 @@
+/*
+ * memcmp.c -- memcmp function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+int
+memcmp (const void *m1,
+	const void *m2,
+	size_t n)
+{
+  const unsigned char *s1 = (const unsigned char *) m1;
+  const unsigned char *s2 = (const unsigned char *) m2;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *a1;
+  const uint64_t *a2;
+  uint64_t w1, w2, lo, hi;
+  unsigned int shift, idx;
+
+  if (!SBF_TOO_SMALL (n))
+    {
+      while (SBF_UNALIGNED (s1))
+	{
+	  if (*s1 != *s2)
+	    return *s1 - *s2;
+	  s1++;
+	  s2++;
+	  n--;
+	}
+
+      a1 = (const uint64_t *) s1;
+      if (!SBF_UNALIGNED (s2))
+	{
+	  a2 = (const uint64_t *) s2;
+	  for (; n >= SBF_WORD_SIZE; n -= SBF_WORD_SIZE)
+	    {
+	      w1 = *a1++;
+	      w2 = *a2++;
+	      if (w1 != w2)
+		goto differ;
+	    }
+	}
+      else
+	{
+	  /* Keep S1 aligned and rebuild each S2 word from two aligned
+	     loads, as __sbf_copy_forward does for memcpy.  */
+	  shift = SBF_UNALIGNED (s2) * 8;
+	  a2 = (const uint64_t *) (s2 - SBF_UNALIGNED (s2));
+	  lo = *a2++;
+	  for (; n >= SBF_WORD_SIZE; n -= SBF_WORD_SIZE)
+	    {
+	      hi = *a2++;
+	      w1 = *a1++;
+	      w2 = __sbf_merge (lo, hi, shift);
+	      if (w1 != w2)
+		goto differ;
+	      lo = hi;
+	    }
+	}
+
+      s2 += (const unsigned char *) a1 - s1;
+      s1 = (const unsigned char *) a1;
+    }
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while (n--)
+    {
+      if (*s1 != *s2)
+	return *s1 - *s2;
+      s1++;
+      s2++;
+    }
+
+  return 0;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+differ:
+  /* Words are little-endian, so the lowest differing byte comes first.  */
+  idx = __sbf_first_byte (__sbf_nonzero_bytes (w1 ^ w2)) * 8;
+  return (int) ((w1 >> idx) & 0xff) - (int) ((w2 >> idx) & 0xff);
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
@@ -0,0 +1,32 @@
+/*
+ * memcpy.c -- memcpy function for SBF.
+ */
+
+#include <string.h>
+#include "../../string/local.h"
+#include "sbf_string.h"
+
+void *
+__inhibit_loop_to_libcall
+memcpy (void *__restrict dst0,
+	const void *__restrict src0,
+	size_t len0)
+{
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+  char *dst = (char *) dst0;
+  char *src = (char *) src0;
+
+  void *save = dst0;
+
+  while (len0--)
+    {
+      *dst++ = *src++;
+    }
+
+  return save;
+#else
+  __sbf_copy_forward ((unsigned char *) dst0, (const unsigned char *) src0,
+		      len0);
+  return dst0;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
@@ -0,0 +1,44 @@
+/*
+ * memmove.c -- memmove function for SBF.
+ */
+
+#include <string.h>
+#include "../../string/local.h"
+#include "sbf_string.h"
+
+void *
+__inhibit_loop_to_libcall
+memmove (void *dst_void,
+	const void *src_void,
+	size_t length)
+{
+  unsigned char *dst = dst_void;
+  const unsigned char *src = src_void;
+
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+  if (src < dst && dst < src + length)
+    {
+      /* Have to copy backwards */
+      src += length;
+      dst += length;
+      while (length--)
+	{
+	  *--dst = *--src;
+	}
+    }
+  else
+    {
+      while (length--)
+	{
+	  *dst++ = *src++;
+	}
+    }
+#else
+  if (src < dst && dst < src + length)
+    __sbf_copy_backward (dst, src, length);
+  else
+    __sbf_copy_forward (dst, src, length);
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  return dst_void;
+}
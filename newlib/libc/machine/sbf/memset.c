@@ -0,0 +1,53 @@
+/*
+ * memset.c -- memset function for SBF.
+ */
+
+#include <string.h>
+#include "../../string/local.h"
+#include "sbf_string.h"
+
+void *
+__inhibit_loop_to_libcall
+memset (void *m,
+	int c,
+	size_t n)
+{
+  unsigned char *s = (unsigned char *) m;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  uint64_t *aligned;
+  uint64_t rep;
+
+  if (!SBF_TOO_SMALL (n))
+    {
+      while (SBF_UNALIGNED (s))
+	{
+	  *s++ = (unsigned char) c;
+	  n--;
+	}
+
+      rep = __sbf_repeat ((unsigned char) c);
+      aligned = (uint64_t *) s;
+      while (n >= 4 * SBF_WORD_SIZE)
+	{
+	  aligned[0] = rep;
+	  aligned[1] = rep;
+	  aligned[2] = rep;
+	  aligned[3] = rep;
+	  aligned += 4;
+	  n -= 4 * SBF_WORD_SIZE;
+	}
+      while (n >= SBF_WORD_SIZE)
+	{
+	  *aligned++ = rep;
+	  n -= SBF_WORD_SIZE;
+	}
+      s = (unsigned char *) aligned;
+    }
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while (n--)
+    *s++ = (unsigned char) c;
+
+  return m;
+}
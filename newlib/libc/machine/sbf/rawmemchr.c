@@ -0,0 +1,38 @@
+/*
+ * rawmemchr.c -- rawmemchr function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+void *
+rawmemchr (const void *src_void,
+	int c)
+{
+  const unsigned char *src = (const unsigned char *) src_void;
+  unsigned char d = c;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *aligned;
+  uint64_t rep, mask;
+
+  while (SBF_UNALIGNED (src))
+    {
+      if (*src == d)
+	return (void *) src;
+      src++;
+    }
+
+  rep = __sbf_repeat (d);
+  aligned = (const uint64_t *) src;
+  while (!(mask = __sbf_zero_bytes (*aligned ^ rep)))
+    aligned++;
+
+  return (void *) ((const unsigned char *) aligned + __sbf_first_byte (mask));
+#else
+  while (*src != d)
+    src++;
+
+  return (void *) src;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
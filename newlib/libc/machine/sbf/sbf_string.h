@@ -0,0 +1,196 @@
+/*
+ * sbf_string.h -- word-at-a-time helpers shared by the SBF string routines.
+ *
+ * SBF registers are 64 bits wide and the target is little-endian, so the
+ * routines in this directory scan strings eight bytes per load.  Every
+ * ALU operation and every load costs one compute unit, which makes the
+ * classic "has zero byte" bit tricks a direct saving over byte loops.
+ *
+ * As with the generic libc/string code, an aligned word is only loaded
+ * when at least one of its bytes belongs to the object being scanned.
+ */
+
+#ifndef _SBF_STRING_H_
+#define _SBF_STRING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SBF_WORD_SIZE	8
+#define SBF_WORD_MASK	(SBF_WORD_SIZE - 1)
+
+/* Below this many bytes the copy and compare routines stay bytewise.  */
+#define SBF_TOO_SMALL(LEN)	((LEN) < 2 * SBF_WORD_SIZE)
+
+#define SBF_ONES	0x0101010101010101ULL
+#define SBF_HIGHS	0x8080808080808080ULL
+
+/* Nonzero if pointer X is not aligned on a 64-bit boundary.  */
+#define SBF_UNALIGNED(X) ((uintptr_t)(X) & SBF_WORD_MASK)
+
+/* Return a word with the high bit set in the bytes of X that are zero.
+   Bytes above the first zero byte may be flagged spuriously, but the
+   lowest flagged byte is always exact, which is all the locate helper
+   below relies on.  */
+static inline uint64_t
+__sbf_zero_bytes (uint64_t x)
+{
+  return (x - SBF_ONES) & ~x & SBF_HIGHS;
+}
+
+/* Return a word with the high bit set in exactly the nonzero bytes of X.
+   Used to locate the first differing byte of two words from their XOR.  */
+static inline uint64_t
+__sbf_nonzero_bytes (uint64_t x)
+{
+  return (((x & ~SBF_HIGHS) + ~SBF_HIGHS) | x) & SBF_HIGHS;
+}
+
+/* Broadcast byte C to all eight byte lanes.  */
+static inline uint64_t
+__sbf_repeat (unsigned char c)
+{
+  return (uint64_t) c * SBF_ONES;
+}
+
+/* Return the index of the lowest flagged byte in MASK, which must be
+   nonzero and only have bits set in byte high positions.  SBF has no
+   count-trailing-zeros instruction, so count the bytes below the first
+   flag with a multiply instead of a bit loop.  */
+static inline unsigned int
+__sbf_first_byte (uint64_t mask)
+{
+  uint64_t below = ((mask - 1) & ~mask) >> 7;
+  return (unsigned int) (((below & SBF_ONES) * SBF_ONES) >> 56);
+}
+
+/* Combine two consecutive aligned words into the unaligned word starting
+   SHIFT bits into LO.  SHIFT must be a nonzero multiple of 8.  */
+static inline uint64_t
+__sbf_merge (uint64_t lo, uint64_t hi, unsigned int shift)
+{
+  return (lo >> shift) | (hi << (64 - shift));
+}
+
+/* Copy N bytes from SRC to DST in ascending address order.  The
+   destination is aligned first; a source that is still misaligned is
+   read with aligned loads and shifted into place, so no byte is ever
+   loaded twice.  Every word is read before the store that could clobber
+   it, which keeps this safe for memmove when DST is below SRC.  */
+static inline void
+__sbf_copy_forward (unsigned char *dst, const unsigned char *src, size_t n)
+{
+  uint64_t *aligned_dst;
+  const uint64_t *aligned_src;
+  uint64_t lo, hi;
+  unsigned int shift;
+
+  if (!SBF_TOO_SMALL (n))
+    {
+      while (SBF_UNALIGNED (dst))
+	{
+	  *dst++ = *src++;
+	  n--;
+	}
+
+      aligned_dst = (uint64_t *) dst;
+      if (!SBF_UNALIGNED (src))
+	{
+	  aligned_src = (const uint64_t *) src;
+	  while (n >= 4 * SBF_WORD_SIZE)
+	    {
+	      uint64_t w0 = aligned_src[0];
+	      uint64_t w1 = aligned_src[1];
+	      uint64_t w2 = aligned_src[2];
+	      uint64_t w3 = aligned_src[3];
+	      aligned_dst[0] = w0;
+	      aligned_dst[1] = w1;
+	      aligned_dst[2] = w2;
+	      aligned_dst[3] = w3;
+	      aligned_src += 4;
+	      aligned_dst += 4;
+	      n -= 4 * SBF_WORD_SIZE;
+	    }
+	  while (n >= SBF_WORD_SIZE)
+	    {
+	      *aligned_dst++ = *aligned_src++;
+	      n -= SBF_WORD_SIZE;
+	    }
+	  src = (const unsigned char *) aligned_src;
+	}
+      else
+	{
+	  shift = SBF_UNALIGNED (src) * 8;
+	  aligned_src = (const uint64_t *) (src - SBF_UNALIGNED (src));
+	  lo = *aligned_src++;
+	  while (n >= SBF_WORD_SIZE)
+	    {
+	      hi = *aligned_src++;
+	      *aligned_dst++ = __sbf_merge (lo, hi, shift);
+	      lo = hi;
+	      src += SBF_WORD_SIZE;
+	      n -= SBF_WORD_SIZE;
+	    }
+	}
+      dst = (unsigned char *) aligned_dst;
+    }
+
+  while (n--)
+    *dst++ = *src++;
+}
+
+/* Copy N bytes ending at DST + N from the bytes ending at SRC + N, in
+   descending address order.  Mirror image of __sbf_copy_forward, used
+   by memmove when DST overlaps the tail of SRC.  */
+static inline void
+__sbf_copy_backward (unsigned char *dst, const unsigned char *src, size_t n)
+{
+  uint64_t *aligned_dst;
+  const uint64_t *aligned_src;
+  uint64_t lo, hi;
+  unsigned int shift;
+
+  dst += n;
+  src += n;
+
+  if (!SBF_TOO_SMALL (n))
+    {
+      while (SBF_UNALIGNED (dst))
+	{
+	  *--dst = *--src;
+	  n--;
+	}
+
+      aligned_dst = (uint64_t *) dst;
+      if (!SBF_UNALIGNED (src))
+	{
+	  aligned_src = (const uint64_t *) src;
+	  while (n >= SBF_WORD_SIZE)
+	    {
+	      *--aligned_dst = *--aligned_src;
+	      n -= SBF_WORD_SIZE;
+	    }
+	  src = (const unsigned char *) aligned_src;
+	}
+      else
+	{
+	  shift = SBF_UNALIGNED (src) * 8;
+	  aligned_src = (const uint64_t *) (src - SBF_UNALIGNED (src));
+	  hi = *aligned_src;
+	  while (n >= SBF_WORD_SIZE)
+	    {
+	      lo = *--aligned_src;
+	      *--aligned_dst = __sbf_merge (lo, hi, shift);
+	      hi = lo;
+	      src -= SBF_WORD_SIZE;
+	      n -= SBF_WORD_SIZE;
+	    }
+	}
+      dst = (unsigned char *) aligned_dst;
+    }
+
+  while (n--)
+    *--dst = *--src;
+}
+
+#endif /* _SBF_STRING_H_ */
@@ -0,0 +1,37 @@
+/*
+ * snprintf.c -- snprintf for SBF; the formatter is in vsnprintf.c.
+ */
+
+#include <_ansi.h>
+#include <reent.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+int
+_snprintf_r (struct _reent *ptr,
+       char *__restrict str,
+       size_t size,
+       const char *__restrict fmt, ...)
+{
+  int ret;
+  va_list ap;
+
+  va_start (ap, fmt);
+  ret = _vsnprintf_r (ptr, str, size, fmt, ap);
+  va_end (ap);
+  return ret;
+}
+
+int
+snprintf (char *__restrict str,
+       size_t size,
+       const char *__restrict fmt, ...)
+{
+  int ret;
+  va_list ap;
+
+  va_start (ap, fmt);
+  ret = _vsnprintf_r (_REENT, str, size, fmt, ap);
+  va_end (ap);
+  return ret;
+}
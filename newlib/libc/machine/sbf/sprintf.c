@@ -0,0 +1,36 @@
+/*
+ * sprintf.c -- sprintf for SBF; the formatter is in vsnprintf.c.
+ */
+
+#include <_ansi.h>
+#include <reent.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <limits.h>
+
+int
+_sprintf_r (struct _reent *ptr,
+       char *__restrict str,
+       const char *__restrict fmt, ...)
+{
+  int ret;
+  va_list ap;
+
+  va_start (ap, fmt);
+  ret = _vsnprintf_r (ptr, str, INT_MAX, fmt, ap);
+  va_end (ap);
+  return ret;
+}
+
+int
+sprintf (char *__restrict str,
+       const char *__restrict fmt, ...)
+{
+  int ret;
+  va_list ap;
+
+  va_start (ap, fmt);
+  ret = _vsnprintf_r (_REENT, str, INT_MAX, fmt, ap);
+  va_end (ap);
+  return ret;
+}
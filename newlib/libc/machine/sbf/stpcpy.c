@@ -0,0 +1,44 @@
+/*
+ * stpcpy.c -- stpcpy function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+char*
+stpcpy (char *__restrict dst,
+	const char *__restrict src)
+{
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  uint64_t *aligned_dst;
+  const uint64_t *aligned_src;
+  uint64_t word;
+
+  while (SBF_UNALIGNED (src))
+    {
+      if ((*dst = *src) == '\0')
+	return dst;
+      dst++;
+      src++;
+    }
+
+  /* Copy whole words while neither contains the terminator; the tail
+     word is finished bytewise below.  */
+  if (!SBF_UNALIGNED (dst))
+    {
+      aligned_dst = (uint64_t *) dst;
+      aligned_src = (const uint64_t *) src;
+      while (!__sbf_zero_bytes (word = *aligned_src))
+	{
+	  *aligned_dst++ = word;
+	  aligned_src++;
+	}
+      dst = (char *) aligned_dst;
+      src = (const char *) aligned_src;
+    }
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while ((*dst++ = *src++))
+    ;
+  return --dst;
+}
@@ -0,0 +1,59 @@
+/*
+ * strchr.c -- strchr function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+char *
+strchr (const char *s1,
+	int i)
+{
+  const unsigned char *s = (const unsigned char *) s1;
+  unsigned char c = i;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *aligned;
+  uint64_t rep, word, mask;
+
+  while (SBF_UNALIGNED (s))
+    {
+      if (*s == c)
+	return (char *) s;
+      if (!*s)
+	return NULL;
+      s++;
+    }
+
+  aligned = (const uint64_t *) s;
+
+  /* Special case for finding 0, that is just strlen.  */
+  if (!c)
+    {
+      while (!(mask = __sbf_zero_bytes (*aligned)))
+	aligned++;
+      return (char *) aligned + __sbf_first_byte (mask);
+    }
+
+  /* The lowest flag of either test is exact, so whichever of the NUL
+     and the target byte comes first decides the result.  */
+  rep = __sbf_repeat (c);
+  for (;;)
+    {
+      word = *aligned;
+      mask = __sbf_zero_bytes (word) | __sbf_zero_bytes (word ^ rep);
+      if (mask)
+	break;
+      aligned++;
+    }
+
+  s = (const unsigned char *) aligned + __sbf_first_byte (mask);
+  return *s == c ? (char *) s : NULL;
+#else
+  while (*s && *s != c)
+    s++;
+  if (*s == c)
+    return (char *) s;
+  return NULL;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
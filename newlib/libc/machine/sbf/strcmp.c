@@ -0,0 +1,58 @@
+/*
+ * strcmp.c -- strcmp function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+int
+strcmp (const char *s1,
+	const char *s2)
+{
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *a1;
+  const uint64_t *a2;
+  uint64_t w1, w2, mask;
+  unsigned int idx;
+
+  /* Walk bytewise up to the word boundary; the word loop is only usable
+     if both strings reach it together.  */
+  while (SBF_UNALIGNED (s1))
+    {
+      if (*s1 == '\0' || *s1 != *s2)
+	return (*(unsigned char *) s1) - (*(unsigned char *) s2);
+      s1++;
+      s2++;
+    }
+
+  if (!SBF_UNALIGNED (s2))
+    {
+      a1 = (const uint64_t *) s1;
+      a2 = (const uint64_t *) s2;
+      for (;;)
+	{
+	  w1 = *a1;
+	  w2 = *a2;
+	  mask = __sbf_zero_bytes (w1) | __sbf_nonzero_bytes (w1 ^ w2);
+	  if (mask)
+	    break;
+	  a1++;
+	  a2++;
+	}
+
+      /* The lowest flag is the first NUL or mismatch, whichever comes
+	 first, and the bytes there decide the result either way.  */
+      idx = __sbf_first_byte (mask);
+      return ((const unsigned char *) a1)[idx]
+	     - ((const unsigned char *) a2)[idx];
+    }
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while (*s1 != '\0' && *s1 == *s2)
+    {
+      s1++;
+      s2++;
+    }
+
+  return (*(unsigned char *) s1) - (*(unsigned char *) s2);
+}
@@ -16,14 +16,33 @@
 
 #include <stddef.h>
 #include <string.h>
+#include "sbf_string.h"
 
 size_t
 strlen (const char *str)
 {
   const char *start = str;
 
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   while (*str++ != '\0')
     ;
 
   return str - start - 1;
+#else
+  const uint64_t *aligned;
+  uint64_t mask;
+
+  while (SBF_UNALIGNED (str))
+    {
+      if (!*str)
+	return str - start;
+      str++;
+    }
+
+  aligned = (const uint64_t *) str;
+  while (!(mask = __sbf_zero_bytes (*aligned)))
+    aligned++;
+
+  return (const char *) aligned - start + __sbf_first_byte (mask);
+#endif /* not PREFER_SIZE_OVER_SPEED */
 }
@@ -0,0 +1,66 @@
+/*
+ * strncmp.c -- strncmp function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+int
+strncmp (const char *s1,
+	const char *s2,
+	size_t n)
+{
+  if (n == 0)
+    return 0;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *a1;
+  const uint64_t *a2;
+  uint64_t w1, w2, mask;
+  unsigned int idx;
+
+  while (SBF_UNALIGNED (s1))
+    {
+      if (*s1 == '\0' || *s1 != *s2 || --n == 0)
+	return (*(unsigned char *) s1) - (*(unsigned char *) s2);
+      s1++;
+      s2++;
+    }
+
+  if (!SBF_UNALIGNED (s2))
+    {
+      a1 = (const uint64_t *) s1;
+      a2 = (const uint64_t *) s2;
+      while (n >= SBF_WORD_SIZE)
+	{
+	  w1 = *a1;
+	  w2 = *a2;
+	  mask = __sbf_zero_bytes (w1) | __sbf_nonzero_bytes (w1 ^ w2);
+	  if (mask)
+	    {
+	      idx = __sbf_first_byte (mask);
+	      return ((const unsigned char *) a1)[idx]
+		     - ((const unsigned char *) a2)[idx];
+	    }
+	  n -= SBF_WORD_SIZE;
+	  if (n == 0)
+	    return 0;
+	  a1++;
+	  a2++;
+	}
+
+      s1 = (const char *) a1;
+      s2 = (const char *) a2;
+    }
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while (n-- != 0 && *s1 == *s2)
+    {
+      if (n == 0 || *s1 == '\0')
+	return 0;
+      s1++;
+      s2++;
+    }
+
+  return (*(unsigned char *) s1) - (*(unsigned char *) s2);
+}
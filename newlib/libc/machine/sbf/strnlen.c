@@ -0,0 +1,44 @@
+/*
+ * strnlen.c -- strnlen function for SBF.
+ */
+
+#undef __STRICT_ANSI__
+#include <_ansi.h>
+#include <string.h>
+#include "sbf_string.h"
+
+size_t
+strnlen (const char *str,
+	size_t n)
+{
+  const char *start = str;
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *aligned;
+  uint64_t mask;
+
+  while (n && SBF_UNALIGNED (str))
+    {
+      if (!*str)
+	return str - start;
+      str++;
+      n--;
+    }
+
+  aligned = (const uint64_t *) str;
+  while (n >= SBF_WORD_SIZE)
+    {
+      if ((mask = __sbf_zero_bytes (*aligned)) != 0)
+	return (const char *) aligned - start + __sbf_first_byte (mask);
+      aligned++;
+      n -= SBF_WORD_SIZE;
+    }
+
+  str = (const char *) aligned;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+
+  while (n-- > 0 && *str)
+    str++;
+
+  return str - start;
+}
@@ -0,0 +1,72 @@
+/*
+ * strrchr.c -- strrchr function for SBF.
+ */
+
+#include <string.h>
+#include "sbf_string.h"
+
+char *
+strrchr (const char *s1,
+	int i)
+{
+  const unsigned char *s = (const unsigned char *) s1;
+  const unsigned char *last = NULL;
+  unsigned char c = i;
+
+  if (!c)
+    return strchr (s1, 0);
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  const uint64_t *aligned;
+  const uint64_t *hit = NULL;
+  uint64_t rep, word, zeros;
+  const unsigned char *p;
+
+  while (SBF_UNALIGNED (s))
+    {
+      if (!*s)
+	return (char *) last;
+      if (*s == c)
+	last = s;
+      s++;
+    }
+
+  /* Only remember the last whole word holding C; it is rescanned
+     bytewise once the terminating word has been reached.  */
+  rep = __sbf_repeat (c);
+  aligned = (const uint64_t *) s;
+  for (;;)
+    {
+      word = *aligned;
+      if ((zeros = __sbf_zero_bytes (word)) != 0)
+	break;
+      if (__sbf_zero_bytes (word ^ rep))
+	hit = aligned;
+      aligned++;
+    }
+
+  /* Look below the NUL in the terminating word first.  */
+  s = (const unsigned char *) aligned;
+  for (p = s + __sbf_first_byte (zeros); p > s; )
+    if (*--p == c)
+      return (char *) p;
+
+  if (hit)
+    {
+      s = (const unsigned char *) hit;
+      for (p = s + SBF_WORD_SIZE - 1; *p != c; p--)
+	;
+      return (char *) p;
+    }
+
+  return (char *) last;
+#else
+  while (*s)
+    {
+      if (*s == c)
+	last = s;
+      s++;
+    }
+  return (char *) last;
+#endif /* not PREFER_SIZE_OVER_SPEED */
+}
@@ -0,0 +1,591 @@
+/*
+ * vsnprintf.c -- string-only formatted output for SBF.
+ *
+ * The generic vfprintf.c is built around FILE buffering, locales and
+ * dtoa, and is compiled out for this target.  This is a small formatter
+ * that writes straight into the caller's buffer and never allocates;
+ * snprintf.c, sprintf.c and vsprintf.c in this directory are wrappers
+ * around it.  SBF defines _REENT_ONLY, but the plain snprintf, sprintf,
+ * vsnprintf and vsprintf are built all the same, and stdio.h declares
+ * them under _SOLANA_SOURCE: with no streams, these are all the
+ * formatted output the target has.
+ *
+ * It handles the flags '-', '+', ' ', '#' and '0', field width and
+ * precision (including '*'), the length modifiers hh, h, l, ll, j, z,
+ * t and L, and the conversions d, i, u, o, x, X, c, s, p and %.  Unless
+ * NO_FLOATING_POINT is defined, f and F are handled as well, with integer
+ * arithmetic only: the result is correctly rounded as long as the binary
+ * fraction of the value fits in 120 bits, which covers every double of
+ * magnitude 2^-68 or more, and at most MAX_FRAC_DIGITS fractional digits
+ * are computed, the rest being printed as zeros.  Positional arguments,
+ * wide characters, %n and the other floating-point conversions are not
+ * supported; such a conversion specification is copied to the output
+ * as it stands, and its argument, if it is one of these, skipped.
+ */
+
+#include <_ansi.h>
+#include <reent.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include "../../stdlib/local.h"
+
+#ifndef NO_FLOATING_POINT
+# define FLOATING_POINT
+#endif
+
+#ifdef FLOATING_POINT
+#include <float.h>
+#endif
+
+#define FL_LEFT		0x01	/* '-' */
+#define FL_PLUS		0x02	/* '+' */
+#define FL_SPACE	0x04	/* ' ' */
+#define FL_ALT		0x08	/* '#' */
+#define FL_ZERO		0x10	/* '0' */
+#define FL_UPPER	0x20	/* X, F */
+
+enum { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_J, LEN_Z, LEN_T };
+
+struct out {
+  char *buf;		/* next byte to store */
+  size_t avail;		/* bytes that may still be stored, not counting NUL */
+  size_t len;		/* bytes the full output takes so far */
+};
+
+static void
+out_bytes (struct out *o,
+	const char *s,
+	size_t n)
+{
+  size_t k = n < o->avail ? n : o->avail;
+
+  memcpy (o->buf, s, k);
+  o->buf += k;
+  o->avail -= k;
+  o->len += n;
+}
+
+static void
+out_fill (struct out *o,
+	int c,
+	size_t n)
+{
+  size_t k = n < o->avail ? n : o->avail;
+
+  memset (o->buf, c, k);
+  o->buf += k;
+  o->avail -= k;
+  o->len += n;
+}
+
+/* Lay out one conversion: PREFIX (sign or radix marker), ZEROS leading
+   zeros, BODY, then TRAIL zeros, padded to WIDTH according to FLAGS.  */
+static void
+out_field (struct out *o,
+	int flags,
+	int width,
+	const char *prefix,
+	size_t zeros,
+	const char *body,
+	size_t blen,
+	size_t trail)
+{
+  size_t plen = strlen (prefix);
+  size_t total = plen + zeros + blen + trail;
+  size_t pad = width > 0 && (size_t) width > total ? width - total : 0;
+
+  if (!(flags & (FL_LEFT | FL_ZERO)))
+    out_fill (o, ' ', pad);
+  out_bytes (o, prefix, plen);
+  if ((flags & (FL_LEFT | FL_ZERO)) == FL_ZERO)
+    out_fill (o, '0', pad);
+  out_fill (o, '0', zeros);
+  out_bytes (o, body, blen);
+  out_fill (o, '0', trail);
+  if (flags & FL_LEFT)
+    out_fill (o, ' ', pad);
+}
+
+/* Store the digits of V in BASE so that they end just before END, and
+   return a pointer to the first one.  */
+static char *
+u64_digits (char *end,
+	uint64_t v,
+	unsigned int base,
+	const char *xdigits)
+{
+  if (base == 10)
+    return __dec_put64 (v, end);
+  if (base == 16)
+    return __hex_put64 (v, end, xdigits);
+  do
+    {
+      *--end = xdigits[v & 7];
+      v >>= 3;
+    }
+  while (v != 0);
+  return end;
+}
+
+#ifdef FLOATING_POINT
+
+/* The fraction is kept as two 60-bit halves so that multiplying either
+   by ten cannot overflow.  */
+#define FRAC_BITS	60
+#define FRAC_MASK	((UINT64_C (1) << FRAC_BITS) - 1)
+#define FRAC_HALF	(UINT64_C (1) << (FRAC_BITS - 1))
+
+#define MAX_FRAC_DIGITS	30
+
+/* Store the decimal digits of MANT * 2^E, which is 2^64 or more, so
+   that they end just before END, and return a pointer to the first.  */
+static char *
+big_digits (char *end,
+	uint64_t mant,
+	int e)
+{
+  /* DBL_MAX < 2^1024, plus room for the shifted-out top of MANT.  */
+  uint32_t limb[1024 / 32 + 1];
+  uint64_t t, cur;
+  uint32_t rem;
+  int w = e / 32;
+  int sh = e % 32;
+  int n, i;
+
+  memset (limb, 0, sizeof (limb));
+  t = (uint64_t) (uint32_t) mant << sh;
+  limb[w] = (uint32_t) t;
+  limb[w + 1] = (uint32_t) (t >> 32);
+  t = (mant >> 32) << sh;
+  limb[w + 1] |= (uint32_t) t;
+  limb[w + 2] = (uint32_t) (t >> 32);
+  n = w + 3;
+
+  for (;;)
+    {
+      /* Peel off nine digits at a time.  */
+      rem = 0;
+      for (i = n - 1; i >= 0; i--)
+	{
+	  cur = ((uint64_t) rem << 32) | limb[i];
+	  limb[i] = (uint32_t) (cur / 1000000000);
+	  rem = (uint32_t) (cur % 1000000000);
+	}
+      while (n > 0 && limb[n - 1] == 0)
+	n--;
+      if (n == 0)
+	break;
+      for (i = 0; i < 9; i++)
+	{
+	  *--end = '0' + (char) (rem % 10);
+	  rem /= 10;
+	}
+    }
+  return u64_digits (end, rem, 10, NULL);
+}
+
+static void
+out_fixed (struct out *o,
+	int flags,
+	int width,
+	int prec,
+	double d)
+{
+  /* Integer digits of DBL_MAX, the point and the fraction.  */
+  char buf[DBL_MAX_10_EXP + 1 + 1 + MAX_FRAC_DIGITS];
+  char *point = buf + DBL_MAX_10_EXP + 1;
+  char *ip = NULL;
+  char *fp = point + 1;
+  union { double d; uint64_t u; } bits;
+  const char *sign;
+  uint64_t mant, ipart, frac, hi, lo;
+  int e, s, nfrac, i, up, sticky;
+
+  bits.d = d;
+  sign = (bits.u >> 63) ? "-"
+	 : (flags & FL_PLUS) ? "+"
+	 : (flags & FL_SPACE) ? " " : "";
+  e = (int) (bits.u >> 52) & 0x7ff;
+  mant = bits.u & ((UINT64_C (1) << 52) - 1);
+
+  if (e == 0x7ff)
+    {
+      out_field (o, flags & ~FL_ZERO, width, sign, 0,
+		 mant != 0 ? (flags & FL_UPPER ? "NAN" : "nan")
+			   : (flags & FL_UPPER ? "INF" : "inf"), 3, 0);
+      return;
+    }
+
+  /* The value is MANT * 2^E.  */
+  if (e == 0)
+    e = 1;
+  else
+    mant |= UINT64_C (1) << 52;
+  e -= 1075;
+
+  if (prec < 0)
+    prec = 6;
+  nfrac = prec < MAX_FRAC_DIGITS ? prec : MAX_FRAC_DIGITS;
+
+  ipart = frac = hi = lo = 0;
+  sticky = 0;
+  if (e >= 0)
+    {
+      if (e < 64 - 53)
+	ipart = mant << e;
+      else
+	ip = big_digits (point, mant, e);
+    }
+  else
+    {
+      if (e > -64)
+	{
+	  ipart = mant >> -e;
+	  frac = mant & ((UINT64_C (1) << -e) - 1);
+	}
+      else
+	frac = mant;
+
+      /* Scale the -E bit fraction to 2 * FRAC_BITS bits.  */
+      s = 2 * FRAC_BITS + e;
+      if (s >= FRAC_BITS)
+	hi = frac << (s - FRAC_BITS);
+      else if (s >= 0)
+	{
+	  hi = frac >> (FRAC_BITS - s);
+	  lo = (frac << s) & FRAC_MASK;
+	}
+      else if (s > -64)
+	{
+	  lo = frac >> -s;
+	  sticky = (frac & ((UINT64_C (1) << -s) - 1)) != 0;
+	}
+      else
+	sticky = frac != 0;
+    }
+
+  for (i = 0; i < nfrac; i++)
+    {
+      lo *= 10;
+      hi = hi * 10 + (lo >> FRAC_BITS);
+      lo &= FRAC_MASK;
+      fp[i] = '0' + (char) (hi >> FRAC_BITS);
+      hi &= FRAC_MASK;
+    }
+
+  /* Round half to even on what is left.  */
+  if (hi != FRAC_HALF)
+    up = hi > FRAC_HALF;
+  else if (lo != 0 || sticky)
+    up = 1;
+  else
+    up = ((nfrac > 0 ? fp[nfrac - 1] : (char) ipart) & 1) != 0;
+  for (i = nfrac - 1; up && i >= 0; i--)
+    {
+      if (fp[i] == '9')
+	fp[i] = '0';
+      else
+	{
+	  fp[i]++;
+	  up = 0;
+	}
+    }
+  ipart += up;
+
+  if (ip == NULL)
+    ip = u64_digits (point, ipart, 10, NULL);
+  *point = '.';
+
+  out_field (o, flags, width, sign, 0, ip,
+	     (point - ip) + (prec > 0 || (flags & FL_ALT) ? 1 + nfrac : 0),
+	     prec - nfrac);
+}
+
+#endif /* FLOATING_POINT */
+
+int
+_vsnprintf_r (struct _reent *ptr,
+       char *__restrict str,
+       size_t size,
+       const char *__restrict fmt,
+       va_list ap)
+{
+  static const char lower[] = "0123456789abcdef";
+  static const char upper[] = "0123456789ABCDEF";
+  struct out o;
+  const char *spec, *next, *s;
+  char nbuf[3 * sizeof (uint64_t)];
+  char *cp;
+  const char *prefix;
+  uint64_t uv;
+  int64_t sv;
+  int flags, width, prec, len, neg;
+  unsigned int base;
+  size_t n, zeros;
+  char c;
+
+  if (size > INT_MAX)
+    {
+      ptr->_errno = EOVERFLOW;
+      return EOF;
+    }
+  o.buf = str;
+  o.avail = size > 0 ? size - 1 : 0;
+  o.len = 0;
+
+  for (;;)
+    {
+      next = strchr (fmt, '%');
+      if (next == NULL)
+	{
+	  out_bytes (&o, fmt, strlen (fmt));
+	  break;
+	}
+      out_bytes (&o, fmt, next - fmt);
+      spec = next;
+      fmt = next + 1;
+
+      flags = 0;
+      for (;; fmt++)
+	{
+	  if (*fmt == '-')
+	    flags |= FL_LEFT;
+	  else if (*fmt == '+')
+	    flags |= FL_PLUS;
+	  else if (*fmt == ' ')
+	    flags |= FL_SPACE;
+	  else if (*fmt == '#')
+	    flags |= FL_ALT;
+	  else if (*fmt == '0')
+	    flags |= FL_ZERO;
+	  else
+	    break;
+	}
+
+      width = 0;
+      if (*fmt == '*')
+	{
+	  width = va_arg (ap, int);
+	  if (width < 0)
+	    {
+	      flags |= FL_LEFT;
+	      width = -width;
+	    }
+	  fmt++;
+	}
+      else
+	while (*fmt >= '0' && *fmt <= '9')
+	  width = width * 10 + (*fmt++ - '0');
+
+      prec = -1;
+      if (*fmt == '.')
+	{
+	  fmt++;
+	  prec = 0;
+	  if (*fmt == '*')
+	    {
+	      prec = va_arg (ap, int);
+	      if (prec < 0)
+		prec = -1;
+	      fmt++;
+	    }
+	  else
+	    while (*fmt >= '0' && *fmt <= '9')
+	      prec = prec * 10 + (*fmt++ - '0');
+	}
+
+      len = LEN_NONE;
+      switch (*fmt)
+	{
+	case 'h':
+	  len = *++fmt == 'h' ? (fmt++, LEN_HH) : LEN_H;
+	  break;
+	case 'l':
+	  len = *++fmt == 'l' ? (fmt++, LEN_LL) : LEN_L;
+	  break;
+	case 'L':
+	case 'q':
+	  fmt++;
+	  len = LEN_LL;
+	  break;
+	case 'j':
+	  fmt++;
+	  len = LEN_J;
+	  break;
+	case 'z':
+	  fmt++;
+	  len = LEN_Z;
+	  break;
+	case 't':
+	  fmt++;
+	  len = LEN_T;
+	  break;
+	}
+
+      prefix = "";
+      base = 10;
+      switch (c = *fmt++)
+	{
+	case 'd':
+	case 'i':
+	  switch (len)
+	    {
+	    case LEN_HH: sv = (signed char) va_arg (ap, int); break;
+	    case LEN_H: sv = (short) va_arg (ap, int); break;
+	    case LEN_L: sv = va_arg (ap, long); break;
+	    case LEN_LL: sv = va_arg (ap, long long); break;
+	    case LEN_J: sv = va_arg (ap, intmax_t); break;
+	    case LEN_Z: sv = va_arg (ap, ssize_t); break;
+	    case LEN_T: sv = va_arg (ap, ptrdiff_t); break;
+	    default: sv = va_arg (ap, int); break;
+	    }
+	  neg = sv < 0;
+	  uv = neg ? -(uint64_t) sv : (uint64_t) sv;
+	  prefix = neg ? "-" : (flags & FL_PLUS) ? "+"
+		   : (flags & FL_SPACE) ? " " : "";
+	  goto number;
+
+	case 'o':
+	  base = 8;
+	  goto get_unsigned;
+	case 'X':
+	  flags |= FL_UPPER;
+	  /* FALLTHROUGH */
+	case 'x':
+	  base = 16;
+	  /* FALLTHROUGH */
+	case 'u':
+	get_unsigned:
+	  switch (len)
+	    {
+	    case LEN_HH: uv = (unsigned char) va_arg (ap, int); break;
+	    case LEN_H: uv = (unsigned short) va_arg (ap, int); break;
+	    case LEN_L: uv = va_arg (ap, unsigned long); break;
+	    case LEN_LL: uv = va_arg (ap, unsigned long long); break;
+	    case LEN_J: uv = va_arg (ap, uintmax_t); break;
+	    case LEN_Z: uv = va_arg (ap, size_t); break;
+	    case LEN_T: uv = va_arg (ap, ptrdiff_t); break;
+	    default: uv = va_arg (ap, unsigned int); break;
+	    }
+	  if (base == 16 && (flags & FL_ALT) && uv != 0)
+	    prefix = flags & FL_UPPER ? "0X" : "0x";
+	  goto number;
+
+	case 'p':
+	  uv = (uintptr_t) va_arg (ap, void *);
+	  base = 16;
+	  prefix = "0x";
+
+	number:
+	  cp = nbuf + sizeof (nbuf);
+	  if (uv != 0 || prec != 0)
+	    cp = u64_digits (cp, uv, base, flags & FL_UPPER ? upper : lower);
+	  n = nbuf + sizeof (nbuf) - cp;
+	  zeros = prec > 0 && (size_t) prec > n ? prec - n : 0;
+	  if (base == 8 && (flags & FL_ALT) && zeros == 0
+	      && (n == 0 || *cp != '0'))
+	    zeros = 1;
+	  if (prec >= 0)
+	    flags &= ~FL_ZERO;
+	  out_field (&o, flags, width, prefix, zeros, cp, n, 0);
+	  break;
+
+	case 'c':
+	  if (len == LEN_L)
+	    {
+	      (void) va_arg (ap, int);
+	      goto unsupported;
+	    }
+	  nbuf[0] = (char) va_arg (ap, int);
+	  out_field (&o, flags & ~FL_ZERO, width, "", 0, nbuf, 1, 0);
+	  break;
+
+	case 's':
+	  if (len == LEN_L)
+	    {
+	      (void) va_arg (ap, void *);
+	      goto unsupported;
+	    }
+	  s = va_arg (ap, const char *);
+	  if (s == NULL)
+	    s = "(null)";
+	  n = prec >= 0 ? strnlen (s, prec) : strlen (s);
+	  out_field (&o, flags & ~FL_ZERO, width, "", 0, s, n, 0);
+	  break;
+
+#ifdef FLOATING_POINT
+	case 'F':
+	  flags |= FL_UPPER;
+	  /* FALLTHROUGH */
+	case 'f':
+	  if (len == LEN_LL)
+	    {
+# ifdef _LDBL_EQ_DBL
+	      out_fixed (&o, flags, width, prec, va_arg (ap, long double));
+	      break;
+# else
+	      (void) va_arg (ap, long double);
+	      goto unsupported;
+# endif
+	    }
+	  out_fixed (&o, flags, width, prec, va_arg (ap, double));
+	  break;
+#else
+	case 'F':
+	case 'f':
+#endif /* FLOATING_POINT */
+	case 'E':
+	case 'e':
+	case 'G':
+	case 'g':
+	case 'A':
+	case 'a':
+	  /* Unsupported, but skip the argument so the others line up.  */
+	  if (len == LEN_LL)
+	    (void) va_arg (ap, long double);
+	  else
+	    (void) va_arg (ap, double);
+	  goto unsupported;
+
+	case 'n':
+	  (void) va_arg (ap, void *);
+	  goto unsupported;
+
+	case '%':
+	  out_bytes (&o, "%", 1);
+	  break;
+
+	case '\0':
+	  fmt--;
+	  /* FALLTHROUGH */
+	default:
+	unsupported:
+	  out_bytes (&o, spec, fmt - spec);
+	  break;
+	}
+    }
+
+  if (size > 0)
+    *o.buf = '\0';
+  if (o.len > INT_MAX)
+    {
+      ptr->_errno = EOVERFLOW;
+      return EOF;
+    }
+  return (int) o.len;
+}
+
+int
+vsnprintf (char *__restrict str,
+       size_t size,
+       const char *__restrict fmt,
+       va_list ap)
+{
+  return _vsnprintf_r (_REENT, str, size, fmt, ap);
+}
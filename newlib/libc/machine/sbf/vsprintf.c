@@ -0,0 +1,26 @@
+/*
+ * vsprintf.c -- vsprintf for SBF; the formatter is in vsnprintf.c.
+ */
+
+#include <_ansi.h>
+#include <reent.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <limits.h>
+
+int
+_vsprintf_r (struct _reent *ptr,
+       char *__restrict str,
+       const char *__restrict fmt,
+       va_list ap)
+{
+  return _vsnprintf_r (ptr, str, INT_MAX, fmt, ap);
+}
+
+int
+vsprintf (char *__restrict str,
+       const char *__restrict fmt,
+       va_list ap)
+{
+  return _vsnprintf_r (_REENT, str, INT_MAX, fmt, ap);
+}
@@ -0,0 +1,126 @@
+/*
+FUNCTION
+<<bsearch_batch>>---look up many keys in one sorted array
+
+INDEX
+	bsearch_batch
+
+SYNOPSIS
+	#include <stdlib.h>
+	size_t bsearch_batch(void *<[keys]>, size_t <[nkeys]>,
+		const void *<[base]>, size_t <[nmemb]>, size_t <[size]>,
+		int (*<[compar]>)(const void *, const void *),
+		void **<[found]>);
+
+DESCRIPTION
+<<bsearch_batch>> searches the array beginning at <[base]>, which holds
+<[nmemb]> elements of <[size]> bytes sorted in ascending order with
+respect to <[compar]>, for each of the <[nkeys]> keys at <[keys]>.  The
+keys are elements of the same type as the array, and <[compar]> is
+called both to compare a key with an element and to compare two keys.
+
+The keys are first sorted in place with <<qsort>>, unless they already
+are in order.  The array is then walked once from start to finish: the
+search for each key starts where the previous one ended and strides
+forward by the average gap between the remaining keys, so that the
+walk costs about log2 (<[nmemb]> / <[nkeys]>) comparisons per key
+rather than log2 <[nmemb]>.  Keys that arrive already sorted skip the
+<<qsort>>, which is where the batch gains most.
+
+If <[found]> is not NULL it must have room for <[nkeys]> pointers.
+<[found]>[<[i]>] is set to an element of the array that matches the
+<[i]>th key after sorting, or to NULL if there is none.
+
+RETURNS
+The number of keys that have a match in the array.
+
+PORTABILITY
+<<bsearch_batch>> is a newlib extension.
+
+No supporting OS subroutines are required.
+*/
+
+#include <stdlib.h>
+
+/* Index of the first of the NMEMB elements at BASE that is not less
+   than KEY, or NMEMB if there is none.  Like bsearch, the loop only
+   chooses between two lower bounds and never exits early.  */
+static size_t
+lower_bound (const void *key,
+	const char *base,
+	size_t nmemb,
+	size_t size,
+	__compar_fn_t compar)
+{
+  size_t lower = 0;
+  size_t half;
+
+  if (nmemb == 0)
+    return 0;
+
+  while (nmemb > 1)
+    {
+      half = nmemb / 2;
+      lower = compar (key, base + (lower + half - 1) * size) > 0
+	      ? lower + half : lower;
+      nmemb -= half;
+    }
+
+  return lower + (compar (key, base + lower * size) > 0);
+}
+
+size_t
+bsearch_batch (void *keys,
+	size_t nkeys,
+	const void *base,
+	size_t nmemb,
+	size_t size,
+	__compar_fn_t compar,
+	void **found)
+{
+  const char *array = (const char *) base;
+  char *key = (char *) keys;
+  size_t count = 0;
+  size_t pos = 0;
+  size_t lower, upper, step, i;
+  int match;
+
+  if (size == 0)
+    nkeys = 0;
+
+  for (i = 1; i < nkeys; i++)
+    if (compar (key + (i - 1) * size, key + i * size) > 0)
+      {
+	qsort (keys, nkeys, size, compar);
+	break;
+      }
+
+  for (i = 0; i < nkeys; i++, key += size)
+    {
+      /* Step over elements less than KEY from where the previous key
+	 was found, starting with the average distance between the
+	 remaining keys and doubling it each time, then finish with a
+	 binary search of the last step.  */
+      lower = pos;
+      step = (nmemb - pos) / (nkeys - i) + 1;
+      upper = pos + step - 1;
+      while (upper < nmemb && compar (key, array + upper * size) > 0)
+	{
+	  lower = upper + 1;
+	  upper += step;
+	  step <<= 1;
+	}
+      if (upper > nmemb)
+	upper = nmemb;
+
+      pos = lower + lower_bound (key, array + lower * size, upper - lower,
+				 size, compar);
+
+      match = pos < nmemb && compar (key, array + pos * size) == 0;
+      if (found != NULL)
+	found[i] = match ? (void *) (array + pos * size) : NULL;
+      count += match;
+    }
+
+  return count;
+}
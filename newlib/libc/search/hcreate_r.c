@@ -37,10 +37,20 @@
  * Implementation done based on NetBSD manual page and Solaris manual page,
  * plus my own personal experience about how they're supposed to work.
  *
- * I tried to look at Knuth (as cited by the Solaris manual page), but
- * nobody had a copy in the office, so...
+ * The table is open-addressed.  Its index is a single allocation: one
+ * control byte per slot, followed by the slots, which hold the key and a
+ * pointer to the entry.  A control byte is CTRL_EMPTY for a free slot and otherwise holds
+ * the top seven bits of the key's hash.  Slots are probed eight at a
+ * time by loading a group of control bytes as one 64-bit word, so only
+ * keys whose tag matches are compared, and a lookup stops at the first
+ * group that has a free slot.
+ *
+ * The entries themselves live in blocks that are only freed by
+ * hdestroy_r(), because callers keep the ENTRY pointers hsearch()
+ * returns.  When more than the nel given to hcreate_r() have been
+ * entered, the index is rebuilt twice the size and a block is added for
+ * the extra entries; no entry moves.
  */
-#ifndef _SOLANA_SOURCE
 
 #include <sys/cdefs.h>
 #if 0
@@ -50,78 +60,240 @@ __RCSID("$NetBSD: hcreate.c,v 1.2 2001/02/19 21:26:04 ross Exp $");
 #endif
 
 #include <sys/types.h>
-#include <sys/queue.h>
+#include <machine/endian.h>
 #include <errno.h>
+#include <reent.h>
 #include <search.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-/*
- * DO NOT MAKE THIS STRUCTURE LARGER THAN 32 BYTES (4 ptrs on 64-bit
- * ptr machine) without adjusting MAX_BUCKETS_LG2 below.
- */
-struct internal_entry {
-	SLIST_ENTRY(internal_entry) link;
-	ENTRY ent;
+#define	GROUP_SIZE	8
+#define	CTRL_EMPTY	0x80
+#define	CTRL_TAG(hash)	((hash) >> 25)
+
+#define	ONES	0x0101010101010101ULL
+#define	LOWS	0x7f7f7f7f7f7f7f7fULL
+#define	HIGHS	0x8080808080808080ULL
+
+#define	MIN_SLOTS	16
+
+/* Keep at least one slot in eight free so that probes stay short. */
+#define	MAX_FILLED(slots)	((slots) - (slots) / 8)
+
+/* Storage for entries, which never moves. */
+struct entry_block {
+	struct entry_block *next;
+	ENTRY entries[];
+};
+
+/* A slot of the index: the entry, and its key for probing. */
+struct slot {
+	const char *key;
+	ENTRY *entry;
+};
+
+/* What follows the slots in the index. */
+struct table_tail {
+	struct entry_block *blocks;	/* newest first */
+	ENTRY *unused;			/* next entry not yet handed out */
 };
-SLIST_HEAD(internal_head, internal_entry);
 
-#define	MIN_BUCKETS_LG2	4
-#define	MIN_BUCKETS	(1 << MIN_BUCKETS_LG2)
+#define	TABLE_CTRL(htab)	((unsigned char *)(htab)->htable)
+#define	TABLE_SLOTS(htab) \
+	((struct slot *)(TABLE_CTRL(htab) + (htab)->htablesize))
+#define	TABLE_TAIL(htab) \
+	((struct table_tail *)(TABLE_SLOTS(htab) + (htab)->htablesize))
+
+/* FNV-1a; the low bits pick the first group and the top bits the tag. */
+static __uint32_t
+hash_key(const char *key)
+{
+	__uint32_t hash = 2166136261U;
+
+	while (*key != '\0') {
+		hash ^= (unsigned char)*key++;
+		hash *= 16777619U;
+	}
+	return hash;
+}
 
 /*
- * max * sizeof internal_entry must fit into size_t.
- * assumes internal_entry is <= 32 (2^5) bytes.
+ * Return the position within its group of the lowest lane flagged in
+ * MATCH, which has bits set only in the high bit of each byte.  Counts
+ * the bytes below it with a multiply, as not every target has a
+ * count-trailing-zeros instruction.
  */
-#ifdef __MSP430X_LARGE__
-/* 20-bit size_t.  */
-#define	MAX_BUCKETS_LG2	(20 - 1 - 5)
-#else
-#define	MAX_BUCKETS_LG2	(sizeof (size_t) * 8 - 1 - 5)
+static unsigned int
+first_lane(uint64_t match)
+{
+	uint64_t below = ((match - 1) & ~match) >> 7;
+	unsigned int lane = (unsigned int)(((below & ONES) * ONES) >> 56);
+
+#if BYTE_ORDER == BIG_ENDIAN
+	lane = GROUP_SIZE - 1 - lane;
 #endif
-#define	MAX_BUCKETS	((size_t)1 << MAX_BUCKETS_LG2)
+	return lane;
+}
+
+/*
+ * Look KEY up in the table of SLOTS slots at CTRL.  Return its entry if
+ * it is there; otherwise return NULL and store in *FREEP the index of
+ * the slot it should be entered in.
+ */
+static ENTRY *
+probe(unsigned char *ctrl, size_t slots, const char *key, __uint32_t hash,
+    size_t *freep)
+{
+	struct slot *slot = (struct slot *)(ctrl + slots);
+	size_t mask = slots / GROUP_SIZE - 1;
+	size_t group = hash & mask;
+	uint64_t word, match;
+	size_t idx;
+
+	for (;;) {
+		word = *(uint64_t *)(ctrl + group * GROUP_SIZE);
+
+		/* Flag exactly the bytes equal to the tag. */
+		match = word ^ (CTRL_TAG(hash) * ONES);
+		match = ~(((match & LOWS) + LOWS) | match | LOWS);
+		while (match != 0) {
+			idx = group * GROUP_SIZE + first_lane(match);
+			if (strcmp(slot[idx].key, key) == 0)
+				return slot[idx].entry;
+			match &= match - 1;
+		}
+
+		/* Tags never have the high bit set, so this finds free slots. */
+		match = word & HIGHS;
+		if (match != 0) {
+			*freep = group * GROUP_SIZE + first_lane(match);
+			return NULL;
+		}
+
+		group = (group + 1) & mask;
+	}
+}
+
+/* Allocate an empty index of SLOTS slots, a power of two. */
+static unsigned char *
+table_alloc(struct _reent *ptr, size_t slots)
+{
+	unsigned char *ctrl;
+
+	if (slots > (SIZE_MAX - sizeof(struct table_tail)) /
+	    (1 + sizeof(struct slot))) {
+		ptr->_errno = ENOMEM;
+		return NULL;
+	}
+	ctrl = malloc(slots * (1 + sizeof(struct slot)) +
+	    sizeof(struct table_tail));
+	if (ctrl == NULL) {
+		ptr->_errno = ENOMEM;
+		return NULL;
+	}
+	memset(ctrl, CTRL_EMPTY, slots);
+	return ctrl;
+}
+
+/* Allocate a block of N entries. */
+static struct entry_block *
+block_alloc(struct _reent *ptr, size_t n)
+{
+	struct entry_block *block;
+
+	if (n > (SIZE_MAX - sizeof(struct entry_block)) / sizeof(ENTRY)) {
+		ptr->_errno = ENOMEM;
+		return NULL;
+	}
+	block = malloc(sizeof(struct entry_block) + n * sizeof(ENTRY));
+	if (block == NULL)
+		ptr->_errno = ENOMEM;
+	return block;
+}
+
+/*
+ * Rebuild the index twice the size, and add a block of entries for the
+ * slots it gains.
+ */
+static int
+table_grow(struct _reent *ptr, struct hsearch_data *htab)
+{
+	unsigned char *ctrl = TABLE_CTRL(htab);
+	struct slot *slot = TABLE_SLOTS(htab);
+	struct table_tail tail = *TABLE_TAIL(htab);
+	size_t slots = htab->htablesize;
+	struct entry_block *block;
+	unsigned char *nctrl;
+	struct slot *nslot;
+	__uint32_t hash;
+	size_t idx, nidx;
+
+	if (slots > SIZE_MAX / 2) {
+		ptr->_errno = ENOMEM;
+		return 0;
+	}
+	block = block_alloc(ptr, MAX_FILLED(slots * 2) - MAX_FILLED(slots));
+	if (block == NULL)
+		return 0;
+	nctrl = table_alloc(ptr, slots * 2);
+	if (nctrl == NULL) {
+		free(block);
+		return 0;
+	}
+	nslot = (struct slot *)(nctrl + slots * 2);
+
+	for (idx = 0; idx < slots; idx++) {
+		if (ctrl[idx] == CTRL_EMPTY)
+			continue;
+		hash = hash_key(slot[idx].key);
+		(void)probe(nctrl, slots * 2, slot[idx].key, hash, &nidx);
+		nctrl[nidx] = CTRL_TAG(hash);
+		nslot[nidx] = slot[idx];
+	}
 
-/* Default hash function, from db/hash/hash_func.c */
-extern __uint32_t (*__default_hash)(const void *, size_t);
+	free(ctrl);
+	htab->htable = nctrl;
+	htab->htablesize = slots * 2;
+	block->next = tail.blocks;
+	TABLE_TAIL(htab)->blocks = block;
+	TABLE_TAIL(htab)->unused = block->entries;
+	return 1;
+}
 
 int
 hcreate_r(size_t nel, struct hsearch_data *htab)
 {
-	size_t idx;
-	unsigned int p2;
+	struct _reent *ptr = _REENT;
+	struct entry_block *block;
+	size_t slots;
 
 	/* Make sure this this isn't called when a table already exists. */
 	if (htab->htable != NULL) {
-		errno = EINVAL;
+		ptr->_errno = EINVAL;
 		return 0;
 	}
 
-	/* If nel is too small, make it min sized. */
-	if (nel < MIN_BUCKETS)
-		nel = MIN_BUCKETS;
-
-	/* If it's too large, cap it. */
-	if (nel > MAX_BUCKETS)
-		nel = MAX_BUCKETS;
-
-	/* If it's is not a power of two in size, round up. */
-	if ((nel & (nel - 1)) != 0) {
-		for (p2 = 0; nel != 0; p2++)
-			nel >>= 1;
-		nel = 1 << p2;
-	}
+	/* Round up to a power of two with room for nel entries. */
+	for (slots = MIN_SLOTS; MAX_FILLED(slots) < nel; slots <<= 1)
+		if (slots > SIZE_MAX / 2) {
+			ptr->_errno = ENOMEM;
+			return 0;
+		}
 
-	/* Allocate the table. */
-	htab->htablesize = nel;
-	htab->htable = malloc(htab->htablesize * sizeof htab->htable[0]);
+	block = block_alloc(ptr, MAX_FILLED(slots));
+	if (block == NULL)
+		return 0;
+	htab->htable = table_alloc(ptr, slots);
 	if (htab->htable == NULL) {
-		errno = ENOMEM;
+		free(block);
 		return 0;
 	}
-
-	/* Initialize it. */
-	for (idx = 0; idx < htab->htablesize; idx++)
-		SLIST_INIT(&(htab->htable[idx]));
+	htab->htablesize = slots;
+	htab->hfilled = 0;
+	block->next = NULL;
+	TABLE_TAIL(htab)->blocks = block;
+	TABLE_TAIL(htab)->unused = block->entries;
 
 	return 1;
 }
@@ -129,23 +301,15 @@ hcreate_r(size_t nel, struct hsearch_data *htab)
 void
 hdestroy_r(struct hsearch_data *htab)
 {
-#if 0
-	struct internal_entry *ie;
-	size_t idx;
-#endif
+	struct entry_block *block, *next;
+
 	if (htab->htable == NULL)
 		return;
 
-#if 0
-	for (idx = 0; idx < htab->htablesize; idx++) {
-		while (!SLIST_EMPTY(&(htab->htable[idx]))) {
-			ie = SLIST_FIRST(&(htab->htable[idx]));
-			SLIST_REMOVE_HEAD(&(htab->htable[idx]), link);
-                        free(ie->ent.key);
-			free(ie);
-		}
+	for (block = TABLE_TAIL(htab)->blocks; block != NULL; block = next) {
+		next = block->next;
+		free(block);
 	}
-#endif
 	free(htab->htable);
 	htab->htable = NULL;
 }
@@ -153,25 +317,16 @@ hdestroy_r(struct hsearch_data *htab)
 int
 hsearch_r(ENTRY item, ACTION action, ENTRY **retval, struct hsearch_data *htab)
 {
-	struct internal_head *head;
-	struct internal_entry *ie;
-	__uint32_t hashval;
-	size_t len;
-
-	len = strlen(item.key);
-	hashval = (*__default_hash)(item.key, len);
-
-        head = &(htab->htable[hashval & (htab->htablesize - 1)]);
-	ie = SLIST_FIRST(head);
-	while (ie != NULL) {
-		if (strcmp(ie->ent.key, item.key) == 0)
-			break;
-		ie = SLIST_NEXT(ie, link);
-	}
+	__uint32_t hash;
+	ENTRY *ep;
+	size_t idx;
+
+	hash = hash_key(item.key);
+	ep = probe(TABLE_CTRL(htab), htab->htablesize, item.key, hash, &idx);
 
-	if (ie != NULL)
+	if (ep != NULL)
           {
-            *retval = &ie->ent;
+            *retval = ep;
             return 1;
           }
 	else if (action == FIND)
@@ -180,18 +335,26 @@ hsearch_r(ENTRY item, ACTION action, ENTRY **retval, struct hsearch_data *htab)
             return 0;
           }
 
-	ie = malloc(sizeof *ie);
-	if (ie == NULL)
+	if (htab->hfilled >= MAX_FILLED(htab->htablesize))
           {
-            *retval = NULL;
-            return 0;
+            if (!table_grow(_REENT, htab))
+              {
+                *retval = NULL;
+                return 0;
+              }
+            (void)probe(TABLE_CTRL(htab), htab->htablesize, item.key, hash,
+                &idx);
           }
-	ie->ent.key = item.key;
-	ie->ent.data = item.data;
 
-	SLIST_INSERT_HEAD(head, ie, link);
-        *retval = &ie->ent;
+	/* Blocks hold exactly MAX_FILLED entries in all, handed out in order. */
+	ep = TABLE_TAIL(htab)->unused++;
+	ep->key = item.key;
+	ep->data = item.data;
+	TABLE_CTRL(htab)[idx] = CTRL_TAG(hash);
+	TABLE_SLOTS(htab)[idx].key = item.key;
+	TABLE_SLOTS(htab)[idx].entry = ep;
+	htab->hfilled++;
+
+        *retval = ep;
 	return 1;
 }
-
-#endif /* _SOLANA_SOURCE */
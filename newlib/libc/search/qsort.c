@@ -64,6 +64,7 @@ PORTABILITY
 
 #include <_ansi.h>
 #include <sys/cdefs.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifndef __GNUC__
@@ -78,12 +79,14 @@ typedef int		 cmp_t(const void *, const void *, void *);
 typedef int		 cmp_t(const void *, const void *);
 #endif
 static inline char	*med3 (char *, char *, char *, cmp_t *, void *);
-static inline void	 swapfunc (char *, char *, int, int);
+static inline void	 swapfunc (char *, char *, size_t, int);
 
 #define min(a, b)	(a) < (b) ? a : b
 
 /*
- * Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ * Qsort routine from Bentley & McIlroy's "Engineering a Sort Function",
+ * with Musser's introsort depth limit so that adversarial inputs fall
+ * back to heapsort instead of going quadratic.
  */
 #define swapcode(TYPE, parmi, parmj, n) { 		\
 	long i = (n) / sizeof (TYPE); 			\
@@ -96,28 +99,109 @@ static inline void	 swapfunc (char *, char *, int, int);
         } while (--i > 0);				\
 }
 
-#define SWAPINIT(a, es) swaptype = ((char *)a - (char *)0) % sizeof(long) || \
-	es % sizeof(long) ? 2 : es == sizeof(long)? 0 : 1;
+/*
+ * How elements are swapped, decided once per call from the element size
+ * and the alignment of the array.  Sorting keys of 4, 8, 16 or 32 bytes
+ * is common enough to be worth an unrolled swap each; other sizes are
+ * swapped a word or a byte at a time.
+ */
+#define SWAP_4		0	/* one 32-bit word */
+#define SWAP_8		1	/* one 64-bit word */
+#define SWAP_16		2	/* two 64-bit words */
+#define SWAP_32		3	/* four 64-bit words */
+#define SWAP_WORDS64	4	/* loop over 64-bit words */
+#define SWAP_WORDS32	5	/* loop over 32-bit words */
+#define SWAP_BYTES	6	/* loop over bytes */
+
+static inline int
+swapinit (char *a,
+	size_t es)
+{
+	uintptr_t align = (uintptr_t) a | es;
+
+	if (align % sizeof (uint64_t) == 0) {
+		switch (es) {
+		case 8:
+			return SWAP_8;
+		case 16:
+			return SWAP_16;
+		case 32:
+			return SWAP_32;
+		default:
+			return SWAP_WORDS64;
+		}
+	}
+	if (align % sizeof (uint32_t) == 0)
+		return es == 4 ? SWAP_4 : SWAP_WORDS32;
+	return SWAP_BYTES;
+}
+
+#define SWAPINIT(a, es) swaptype = swapinit((char *)(a), (es))
 
 static inline void
 swapfunc (char *a,
 	char *b,
-	int n,
+	size_t n,
 	int swaptype)
 {
-	if(swaptype <= 1)
-		swapcode(long, a, b, n)
+	if (swaptype <= SWAP_WORDS64 && swaptype != SWAP_4)
+		swapcode(uint64_t, a, b, n)
+	else if (swaptype != SWAP_BYTES)
+		swapcode(uint32_t, a, b, n)
 	else
 		swapcode(char, a, b, n)
 }
 
-#define swap(a, b)					\
-	if (swaptype == 0) {				\
-		long t = *(long *)(a);			\
-		*(long *)(a) = *(long *)(b);		\
-		*(long *)(b) = t;			\
-	} else						\
-		swapfunc(a, b, es, swaptype)
+static inline void
+swapone (char *a,
+	char *b,
+	size_t es,
+	int swaptype)
+{
+	uint64_t *pi = (uint64_t *) a;
+	uint64_t *pj = (uint64_t *) b;
+	uint64_t t0, t1, t2, t3;
+
+	switch (swaptype) {
+	case SWAP_4:
+		t0 = *(uint32_t *) a;
+		*(uint32_t *) a = *(uint32_t *) b;
+		*(uint32_t *) b = t0;
+		break;
+	case SWAP_8:
+		t0 = pi[0];
+		pi[0] = pj[0];
+		pj[0] = t0;
+		break;
+	case SWAP_16:
+		t0 = pi[0];
+		t1 = pi[1];
+		pi[0] = pj[0];
+		pi[1] = pj[1];
+		pj[0] = t0;
+		pj[1] = t1;
+		break;
+	case SWAP_32:
+		t0 = pi[0];
+		t1 = pi[1];
+		t2 = pi[2];
+		t3 = pi[3];
+		pi[0] = pj[0];
+		pi[1] = pj[1];
+		pi[2] = pj[2];
+		pi[3] = pj[3];
+		pj[0] = t0;
+		pj[1] = t1;
+		pj[2] = t2;
+		pj[3] = t3;
+		break;
+	default:
+		swapfunc(a, b, es, swaptype);
+		break;
+	}
+}
+
+#define swap(a, b)	swapone(a, b, es, swaptype)
 
 #define vecswap(a, b, n) 	if ((n) > 0) swapfunc(a, b, n, swaptype)
 
@@ -129,22 +213,68 @@ swapfunc (char *a,
 #define	CMP(t, x, y) (cmp((x), (y)))
 #endif
 
+#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
+#define __thunk_unused __unused
+#else
+#define __thunk_unused
+#endif
+
 static inline char *
 med3 (char *a,
 	char *b,
 	char *c,
 	cmp_t *cmp,
-	void *thunk
-#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
-__unused
-#endif
-)
+	void *thunk __thunk_unused)
 {
 	return CMP(thunk, a, b) < 0 ?
 	       (CMP(thunk, b, c) < 0 ? b : (CMP(thunk, a, c) < 0 ? c : a ))
               :(CMP(thunk, b, c) > 0 ? b : (CMP(thunk, a, c) < 0 ? a : c ));
 }
 
+/*
+ * Heapsort, for the partitions that exhaust their depth budget.  It
+ * needs no extra space and is O(n log n) whatever the input.
+ */
+static void
+siftdown (char *a,
+	size_t root,
+	size_t n,
+	size_t es,
+	int swaptype,
+	cmp_t *cmp,
+	void *thunk __thunk_unused)
+{
+	size_t child;
+
+	while ((child = 2 * root + 1) < n) {
+		if (child + 1 < n &&
+		    CMP(thunk, a + child * es, a + (child + 1) * es) < 0)
+			child++;
+		if (CMP(thunk, a + root * es, a + child * es) >= 0)
+			return;
+		swap(a + root * es, a + child * es);
+		root = child;
+	}
+}
+
+static void
+heapsort_range (char *a,
+	size_t n,
+	size_t es,
+	int swaptype,
+	cmp_t *cmp,
+	void *thunk)
+{
+	size_t i;
+
+	for (i = n / 2; i > 0; i--)
+		siftdown(a, i - 1, n, es, swaptype, cmp, thunk);
+	for (i = n - 1; i > 0; i--) {
+		swap(a, a + i * es);
+		siftdown(a, 0, i, es, swaptype, cmp, thunk);
+	}
+}
+
 /*
  * Classical function call recursion wastes a lot of stack space. Each
  * recursion level requires a full stack frame comprising all local variables
@@ -161,37 +291,27 @@ __unused
  */
 #define PARAMETER_STACK_LEVELS 8u
 
-#if defined(I_AM_QSORT_R)
-void
-__bsd_qsort_r (void *a,
-	size_t n,
-	size_t es,
-	void *thunk,
-	cmp_t *cmp)
-#elif defined(I_AM_GNU_QSORT_R)
-void
-qsort_r (void *a,
+/*
+ * Sort the n elements at a, partitioning at most depth more times before
+ * switching to heapsort.
+ */
+static void
+introsort (void *a,
 	size_t n,
 	size_t es,
+	int swaptype,
 	cmp_t *cmp,
-	void *thunk)
-#else
-#define thunk NULL
-void
-qsort (void *a,
-	size_t n,
-	size_t es,
-	cmp_t *cmp)
-#endif
+	void *thunk,
+	size_t depth)
 {
 	char *pa, *pb, *pc, *pd, *pl, *pm, *pn;
 	size_t d, r;
 	int cmp_result;
-	int swaptype, swap_cnt;
+	int swap_cnt;
 	size_t recursion_level = 0;
-	struct { void *a; size_t n; } parameter_stack[PARAMETER_STACK_LEVELS];
+	struct { void *a; size_t n; size_t depth; }
+		parameter_stack[PARAMETER_STACK_LEVELS];
 
-	SWAPINIT(a, es);
 loop:	swap_cnt = 0;
 	if (n < 7) {
 		/* Short arrays are insertion sorted. */
@@ -202,6 +322,13 @@ loop:	swap_cnt = 0;
 		goto pop;
 	}
 
+	/* Too many bad pivots: this part is better off heapsorted. */
+	if (depth == 0) {
+		heapsort_range(a, n, es, swaptype, cmp, thunk);
+		goto pop;
+	}
+	depth--;
+
 	/* Select a pivot element, move it to the left. */
 	pm = (char *) a + (n / 2) * es;
 	if (n > 7) {
@@ -252,11 +379,21 @@ loop:	swap_cnt = 0;
 		pb += es;
 		pc -= es;
 	}
-	if (swap_cnt == 0) {  /* Switch to insertion sort */
+	if (swap_cnt == 0) {
+		/*
+		 * Nothing moved, so the array may already be sorted.  Try
+		 * insertion sort, but give up once it has done more than
+		 * n swaps and partition again instead; each retry uses up
+		 * depth, so this cannot go quadratic either.
+		 */
+		r = n;
 		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
 			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
+			     pl -= es) {
 				swap(pl, pl - es);
+				if (++swap_cnt > r)
+					goto loop;
+			}
 		goto pop;
 	}
 
@@ -310,6 +447,7 @@ loop:	swap_cnt = 0;
 			 */
 			parameter_stack[recursion_level].a = a;
 			parameter_stack[recursion_level].n = n / es;
+			parameter_stack[recursion_level].depth = depth;
 			recursion_level++;
 			a = pa;
 			n = r / es;
@@ -321,13 +459,7 @@ loop:	swap_cnt = 0;
 			 * is sorted using function call recursion. The larger
 			 * part will be sorted after the function call returns.
 			 */
-#if defined(I_AM_QSORT_R)
-			__bsd_qsort_r(pa, r / es, es, thunk, cmp);
-#elif defined(I_AM_GNU_QSORT_R)
-			qsort_r(pa, r / es, es, cmp, thunk);
-#else
-			qsort(pa, r / es, es, cmp);
-#endif
+			introsort(pa, r / es, es, swaptype, cmp, thunk, depth);
 		}
 	}
 	if (n > es) {  /* The larger part needs sorting. Iterate to sort.  */
@@ -340,6 +472,45 @@ pop:
 		recursion_level--;
 		a = parameter_stack[recursion_level].a;
 		n = parameter_stack[recursion_level].n;
+		depth = parameter_stack[recursion_level].depth;
 		goto loop;
 	}
 }
+
+#if defined(I_AM_QSORT_R)
+void
+__bsd_qsort_r (void *a,
+	size_t n,
+	size_t es,
+	void *thunk,
+	cmp_t *cmp)
+#elif defined(I_AM_GNU_QSORT_R)
+void
+qsort_r (void *a,
+	size_t n,
+	size_t es,
+	cmp_t *cmp,
+	void *thunk)
+#else
+void
+qsort (void *a,
+	size_t n,
+	size_t es,
+	cmp_t *cmp)
+#endif
+{
+	int swaptype;
+	size_t depth, m;
+
+	/* Allow 2 * log2(n) levels of partitioning, as introsort does. */
+	depth = 0;
+	for (m = n; m > 1; m >>= 1)
+		depth += 2;
+
+	SWAPINIT(a, es);
+#if defined(I_AM_QSORT_R) || defined(I_AM_GNU_QSORT_R)
+	introsort(a, n, es, swaptype, cmp, thunk, depth);
+#else
+	introsort(a, n, es, swaptype, cmp, NULL, depth);
+#endif
+}
@@ -2,7 +2,7 @@
 
 /*
  * Tree search generalized from Knuth (6.2.2) Algorithm T just like
- * the AT&T man page says.
+ * the AT&T man page says, with the tree kept AVL balanced.
  *
  * The node_t structure is for internal use only, lint doesn't grok it.
  *
@@ -24,19 +24,26 @@ __RCSID("$NetBSD: tdelete.c,v 1.2 1999/09/16 11:45:37 lukem Exp $");
 #include <stdlib.h>
 
 
-/* delete node with given key */
+/* see tsearch.c */
+#define	TMAXH		(sizeof(void *) * 8 * 3 / 2)
+
+/* delete node with given key, giving it back to pool */
 void *
-tdelete (const void *__restrict vkey,	/* key to be deleted */
+tdelete_pool (const void *__restrict vkey,	/* key to be deleted */
 	void      **__restrict vrootp,	/* address of the root of tree */
-	int       (*compar)(const void *, const void *))
+	int       (*compar)(const void *, const void *),
+	struct tpool *pool)		/* node allocator, or NULL for free */
 {
+	node_t **path[TMAXH + 1];	/* links followed from the root */
 	node_t **rootp = (node_t **)vrootp;
 	node_t *p, *q, *r;
-	int  cmp;
+	int  cmp, i = 0, j;
 
-	if (rootp == NULL || (p = *rootp) == NULL)
+	if (rootp == NULL || *rootp == NULL)
 		return NULL;
 
+	path[0] = rootp;
+	p = (node_t *)vrootp;	/* POSIX leaves this open for the root */
 	while ((cmp = (*compar)(vkey, (*rootp)->key)) != 0) {
 		p = *rootp;
 		rootp = (cmp < 0) ?
@@ -44,23 +51,41 @@ tdelete (const void *__restrict vkey,	/* key to be deleted */
 		    &(*rootp)->rlink;		/* follow rlink branch */
 		if (*rootp == NULL)
 			return NULL;		/* key not found */
+		path[++i] = rootp;
 	}
-	r = (*rootp)->rlink;			/* D1: */
-	if ((q = (*rootp)->llink) == NULL)	/* Left NULL? */
-		q = r;
-	else if (r != NULL) {			/* Right link is NULL? */
-		if (r->llink == NULL) {		/* D2: Find successor */
-			r->llink = q;
-			q = r;
-		} else {			/* D3: Find NULL link */
-			for (q = r->llink; q->llink != NULL; q = r->llink)
-				r = q;
-			r->llink = q->rlink;
-			q->llink = (*rootp)->llink;
-			q->rlink = (*rootp)->rlink;
+	q = *rootp;
+	if (q->llink == NULL)			/* splice out q */
+		*rootp = q->rlink;
+	else {
+		/* Replace q by its predecessor r, which has no right
+		 * child, so that the surviving nodes keep their
+		 * addresses. */
+		j = i;
+		path[++i] = &q->llink;
+		while ((*path[i])->rlink != NULL) {
+			path[i + 1] = &(*path[i])->rlink;
+			i++;
 		}
+		r = *path[i];
+		*path[i] = r->llink;
+		r->llink = q->llink;
+		r->rlink = q->rlink;
+		r->height = q->height;
+		*rootp = r;
+		path[j + 1] = &r->llink;
 	}
-	free(*rootp);				/* D4: Free node */
-	*rootp = q;				/* link parent to new node */
+	__tnode_free(pool, q);			/* Free node */
+	/* rebalance upwards until a subtree keeps its height */
+	while (--i >= 0 && __tbalance(path[i]))
+		;
 	return p;
 }
+
+/* delete node with given key */
+void *
+tdelete (const void *__restrict vkey,	/* key to be deleted */
+	void      **__restrict vrootp,	/* address of the root of tree */
+	int       (*compar)(const void *, const void *))
+{
+	return tdelete_pool(vkey, vrootp, compar, NULL);
+}
@@ -26,25 +26,34 @@ __RCSID("$NetBSD: tdelete.c,v 1.2 1999/09/16 11:45:37 lukem Exp $");
 
 /* Walk the nodes of a tree */
 static void
-trecurse(root, free_action)
+trecurse(root, free_action, pool)
 	node_t *root;	/* Root of the tree to be walked */
 	void (*free_action)(void *);
+	struct tpool *pool;
 {
   if (root->llink != NULL)
-    trecurse(root->llink, free_action);
+    trecurse(root->llink, free_action, pool);
   if (root->rlink != NULL)
-    trecurse(root->rlink, free_action);
+    trecurse(root->rlink, free_action, pool);
 
   (*free_action) ((void *) root->key);
-  free(root);
+  __tnode_free(pool, root);
 }
 
 void
-tdestroy (void *vrootp,
-       void (*freefct)(void *))
+tdestroy_pool (void *vrootp,
+       void (*freefct)(void *),
+       struct tpool *pool)
 {
   node_t *root = (node_t *) vrootp;
 
   if (root != NULL)
-    trecurse(root, freefct);
+    trecurse(root, freefct, pool);
+}
+
+void
+tdestroy (void *vrootp,
+       void (*freefct)(void *))
+{
+  tdestroy_pool(vrootp, freefct, NULL);
 }
@@ -0,0 +1,74 @@
+/*
+ * Node allocator for the tsearch family.
+ *
+ * Trees built with tsearch_pool take their nodes from blocks of
+ * TPOOL_BLOCK nodes rather than one malloc each, and tdelete_pool and
+ * tdestroy_pool put them on a free list for reuse, so a tree that
+ * churns does not scatter small allocations across the heap.  A NULL
+ * pool means plain malloc and free, which is what tsearch, tdelete and
+ * tdestroy use.
+ *
+ * Totally public domain.
+ */
+
+#define _SEARCH_PRIVATE
+#include <search.h>
+#include <stdlib.h>
+
+#define	TPOOL_BLOCK	64
+
+/* A block of nodes, chained through its first slot. */
+typedef union block {
+	union block *next;
+	node_t	node;
+} block_t;
+
+node_t *
+__tnode_alloc(struct tpool *pool)
+{
+	block_t *b;
+	node_t *n;
+
+	if (pool == NULL)
+		return malloc(sizeof(node_t));
+
+	if ((n = pool->__free) != NULL) {
+		pool->__free = n->llink;
+		return n;
+	}
+	if (pool->__left == 0) {
+		b = malloc(sizeof(block_t) * (TPOOL_BLOCK + 1));
+		if (b == NULL)
+			return NULL;
+		b->next = pool->__chunks;
+		pool->__chunks = b;
+		pool->__left = TPOOL_BLOCK;
+	}
+	b = pool->__chunks;
+	return &b[pool->__left--].node;
+}
+
+void
+__tnode_free(struct tpool *pool, node_t *n)
+{
+	if (pool == NULL) {
+		free(n);
+		return;
+	}
+	n->llink = pool->__free;
+	pool->__free = n;
+}
+
+/* Release every node of the pool, whichever trees they are in. */
+void
+tpool_destroy(struct tpool *pool)
+{
+	block_t *b, *next;
+
+	for (b = pool->__chunks; b != NULL; b = next) {
+		next = b->next;
+		free(b);
+	}
+	pool->__free = pool->__chunks = NULL;
+	pool->__left = 0;
+}
@@ -2,7 +2,7 @@
 
 /*
  * Tree search generalized from Knuth (6.2.2) Algorithm T just like
- * the AT&T man page says.
+ * the AT&T man page says, with the tree kept AVL balanced.
  *
  * The node_t structure is for internal use only, lint doesn't grok it.
  *
@@ -23,18 +23,85 @@ __RCSID("$NetBSD: tsearch.c,v 1.3 1999/09/16 11:45:37 lukem Exp $");
 #include <search.h>
 #include <stdlib.h>
 
-/* find or insert datum into search tree */
+#define	HEIGHT(n)	((n) != NULL ? (n)->height : 0)
+
+/*
+ * The tree is kept AVL balanced, so that keys inserted in order do not
+ * degrade it into a list.  Its height is at most 1.44 log2(n + 2), so
+ * the path from the root fits in TMAXH slots for any n.
+ */
+#define	TMAXH		(sizeof(void *) * 8 * 3 / 2)
+
+static void
+fix_height(node_t *n)
+{
+	int hl = HEIGHT(n->llink), hr = HEIGHT(n->rlink);
+
+	n->height = 1 + (hl > hr ? hl : hr);
+}
+
+static node_t *
+rotate_left(node_t *n)
+{
+	node_t *r = n->rlink;
+
+	n->rlink = r->llink;
+	r->llink = n;
+	fix_height(n);
+	fix_height(r);
+	return r;
+}
+
+static node_t *
+rotate_right(node_t *n)
+{
+	node_t *l = n->llink;
+
+	n->llink = l->rlink;
+	l->rlink = n;
+	fix_height(n);
+	fix_height(l);
+	return l;
+}
+
+/* Restore the balance of the subtree at *np after one of its children
+ * grew or shrank by one level; say whether its own height changed. */
+int
+__tbalance(node_t **np)
+{
+	node_t *n = *np;
+	int old = n->height;
+	int hl = HEIGHT(n->llink), hr = HEIGHT(n->rlink);
+
+	if (hl > hr + 1) {
+		if (HEIGHT(n->llink->rlink) > HEIGHT(n->llink->llink))
+			n->llink = rotate_left(n->llink);
+		*np = rotate_right(n);
+	} else if (hr > hl + 1) {
+		if (HEIGHT(n->rlink->llink) > HEIGHT(n->rlink->rlink))
+			n->rlink = rotate_right(n->rlink);
+		*np = rotate_left(n);
+	} else
+		fix_height(n);
+	return (*np)->height != old;
+}
+
+/* find or insert datum into search tree, taking new nodes from pool */
 void *
-tsearch (const void *vkey,		/* key to be located */
+tsearch_pool (const void *vkey,		/* key to be located */
 	void **vrootp,		/* address of tree root */
-	int (*compar)(const void *, const void *))
+	int (*compar)(const void *, const void *),
+	struct tpool *pool)	/* node allocator, or NULL for malloc */
 {
 	node_t *q;
+	node_t **path[TMAXH + 1];	/* links followed from the root */
 	node_t **rootp = (node_t **)vrootp;
+	int i = 0;
 
 	if (rootp == NULL)
 		return NULL;
 
+	path[0] = rootp;
 	while (*rootp != NULL) {	/* Knuth's T1: */
 		int r;
 
@@ -44,14 +111,28 @@ tsearch (const void *vkey,		/* key to be located */
 		rootp = (r < 0) ?
 		    &(*rootp)->llink :		/* T3: follow left branch */
 		    &(*rootp)->rlink;		/* T4: follow right branch */
+		path[++i] = rootp;
 	}
 
-	q = malloc(sizeof(node_t));		/* T5: key not found */
+	q = __tnode_alloc(pool);		/* T5: key not found */
 	if (q != 0) {				/* make new node */
 		*rootp = q;			/* link new node to old */
 		/* LINTED const castaway ok */
 		q->key = (void *)vkey;		/* initialize new node */
 		q->llink = q->rlink = NULL;
+		q->height = 1;
+		/* rebalance upwards until a subtree keeps its height */
+		while (--i >= 0 && __tbalance(path[i]))
+			;
 	}
 	return q;
 }
+
+/* find or insert datum into search tree */
+void *
+tsearch (const void *vkey,		/* key to be located */
+	void **vrootp,		/* address of tree root */
+	int (*compar)(const void *, const void *))
+{
+	return tsearch_pool(vkey, vrootp, compar, NULL);
+}
@@ -184,7 +184,9 @@ number:
        * explicit precision of zero is no characters.''
        *	-- ANSI X3J11
        */
-      if (_uquad != 0 || pdata->prec != 0)
+      if (base == 10 && _uquad != 0)
+	cp = __dec_put64 (_uquad, cp);
+      else if (_uquad != 0 || pdata->prec != 0)
 	{
 	  do
 	    {
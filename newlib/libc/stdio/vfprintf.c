@@ -1590,32 +1590,33 @@ number:			if ((dprec = prec) >= 0)
 						break;
 					}
 #ifdef _WANT_IO_C99_FORMATS
-					ndig = 0;
-#endif
-					do {
-					  *--cp = to_char (_uquad % 10);
-#ifdef _WANT_IO_C99_FORMATS
-					  ndig++;
-					  /* If (*grouping == CHAR_MAX) then no
-					     more grouping */
-					  if ((flags & GROUPING)
-					      && ndig == *grouping
-					      && *grouping != CHAR_MAX
-					      && _uquad > 9) {
-					    cp -= thsnd_len;
-					    strncpy (cp, thousands_sep,
-						     thsnd_len);
-					    ndig = 0;
-					    /* If (grouping[1] == '\0') then we
-					       have to use *grouping character
-					       (last grouping rule) for all
-					       next cases. */
-					    if (grouping[1] != '\0')
-					      grouping++;
-					  }
+					if (flags & GROUPING) {
+					  ndig = 0;
+					  do {
+					    *--cp = to_char (_uquad % 10);
+					    ndig++;
+					    /* If (*grouping == CHAR_MAX) then no
+					       more grouping */
+					    if (ndig == *grouping
+						&& *grouping != CHAR_MAX
+						&& _uquad > 9) {
+					      cp -= thsnd_len;
+					      strncpy (cp, thousands_sep,
+						       thsnd_len);
+					      ndig = 0;
+					      /* If (grouping[1] == '\0') then
+						 we have to use *grouping
+						 character (last grouping rule)
+						 for all next cases. */
+					      if (grouping[1] != '\0')
+						grouping++;
+					    }
+					    _uquad /= 10;
+					  } while (_uquad != 0);
+					  break;
+					}
 #endif
-					  _uquad /= 10;
-					} while (_uquad != 0);
+					cp = __dec_put64 (_uquad, cp);
 					break;
 
 				case HEX:
@@ -0,0 +1,546 @@
+/* Implementation of <<malloc>> <<free>> <<calloc>> <<realloc>> as a bump
+ * pointer over a region obtained from sbrk, optional as to be
+ * reenterable.
+ *
+ * Selected with --enable-newlib-arena-malloc.  This suits targets such as
+ * SBF where a program runs once over a small fixed heap that is thrown
+ * away afterwards: malloc is a pointer increment, free only gives memory
+ * back when it releases the most recent allocation, and realloc of the
+ * most recent allocation resizes it in place.  Memory released any other
+ * way is not reused.
+ *
+ * Interface documentation refer to malloc.c.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+#include "malltrace.h"
+
+#if DEBUG
+#include <assert.h>
+#else
+#undef assert
+#define assert(x) ((void)0)
+#endif
+
+#ifndef MAX
+#define MAX(a,b) ((a) >= (b) ? (a) : (b))
+#endif
+
+#define _SBRK_R(X) _sbrk_r(X)
+
+#ifdef INTERNAL_NEWLIB
+
+#include <sys/config.h>
+#include <reent.h>
+
+#define RARG struct _reent *reent_ptr,
+#define RONEARG struct _reent *reent_ptr
+#define RCALL reent_ptr,
+#define RONECALL reent_ptr
+
+#define MALLOC_LOCK __malloc_lock(reent_ptr)
+#define MALLOC_UNLOCK __malloc_unlock(reent_ptr)
+
+#define RERRNO reent_ptr->_errno
+
+#define arena_malloc		_malloc_r
+#define arena_free		_free_r
+#define arena_realloc		_realloc_r
+#define arena_memalign		_memalign_r
+#define arena_valloc		_valloc_r
+#define arena_pvalloc		_pvalloc_r
+#define arena_calloc		_calloc_r
+#define arena_cfree		_cfree_r
+#define arena_malloc_usable_size _malloc_usable_size_r
+#define arena_malloc_stats	_malloc_stats_r
+#define arena_mallinfo		_mallinfo_r
+#define arena_mallopt		_mallopt_r
+
+#else /* ! INTERNAL_NEWLIB */
+
+#define RARG
+#define RONEARG
+#define RCALL
+#define RONECALL
+#define MALLOC_LOCK
+#define MALLOC_UNLOCK
+#define RERRNO errno
+
+#define arena_malloc		malloc
+#define arena_free		free
+#define arena_realloc		realloc
+#define arena_memalign		memalign
+#define arena_valloc		valloc
+#define arena_pvalloc		pvalloc
+#define arena_calloc		calloc
+#define arena_cfree		cfree
+#define arena_malloc_usable_size malloc_usable_size
+#define arena_malloc_stats	malloc_stats
+#define arena_mallinfo		mallinfo
+#define arena_mallopt		mallopt
+#endif /* ! INTERNAL_NEWLIB */
+
+/* Redefine names to avoid conflict with user names */
+#define arena_start __malloc_arena_start
+#define arena_top __malloc_arena_top
+#define arena_end __malloc_arena_end
+#define arena_used __malloc_arena_used
+#define arena_peak __malloc_arena_peak
+#define current_mallinfo __malloc_current_mallinfo
+
+#define ALIGN_PTR(ptr, align) \
+    (((ptr) + (align) - (intptr_t)1) & ~((align) - (intptr_t)1))
+#define ALIGN_SIZE(size, align) \
+    (((size) + (align) - (size_t)1) & ~((align) - (size_t)1))
+
+/* Alignment of allocated block */
+#define MALLOC_ALIGN (8U)
+#define MALLOC_PAGE_ALIGN (0x1000)
+#define MAX_ALLOC_SIZE (0x80000000U)
+
+/* Minimum amount requested from sbrk at a time, so that most calls to
+ * malloc never leave the bump path. */
+#define ARENA_GROW_SIZE (0x400)
+
+typedef size_t malloc_size_t;
+
+/*          --------------------------------------
+ *  block ->| size of the payload                |
+ *          | (padded to MALLOC_ALIGN)           |
+ *          --------------------------------------
+ *    ptr ->| data                               |
+ *          --------------------------------------
+ */
+#define HEADER_SIZE ALIGN_SIZE(sizeof(malloc_size_t), MALLOC_ALIGN)
+
+#define BLOCK_SIZE(ptr) (*(malloc_size_t *)((char *)(ptr) - HEADER_SIZE))
+#define BLOCK_END(ptr) ((char *)(ptr) + BLOCK_SIZE(ptr))
+
+/* Forward data declarations */
+extern char * arena_start;
+extern char * arena_top;
+extern char * arena_end;
+extern malloc_size_t arena_used;
+extern malloc_size_t arena_peak;
+extern struct mallinfo current_mallinfo;
+
+/* Forward function declarations */
+extern void * arena_malloc(RARG malloc_size_t);
+extern void arena_free (RARG void * free_p);
+extern void arena_cfree(RARG void * ptr);
+extern void * arena_calloc(RARG malloc_size_t n, malloc_size_t elem);
+extern void arena_malloc_stats(RONEARG);
+extern malloc_size_t arena_malloc_usable_size(RARG void * ptr);
+extern void * arena_realloc(RARG void * ptr, malloc_size_t size);
+extern void * arena_memalign(RARG size_t align, size_t s);
+extern int arena_mallopt(RARG int parameter_number, int parameter_value);
+extern void * arena_valloc(RARG size_t s);
+extern void * arena_pvalloc(RARG size_t s);
+extern int __arena_extend(RARG malloc_size_t s);
+
+/* Account for N bytes being taken from (N > 0) or returned to (N < 0)
+ * the arena, and keep the high-water mark for mallinfo. */
+static inline void arena_account(long n)
+{
+    arena_used += n;
+    if (arena_used > arena_peak) arena_peak = arena_used;
+}
+
+#ifdef DEFINE_MALLOC
+/* Start of the first region obtained from sbrk */
+char * arena_start = NULL;
+
+/* Next free byte and end of the current region */
+char * arena_top = NULL;
+char * arena_end = NULL;
+
+/* Bytes currently handed out and their high-water mark, headers and
+ * alignment padding included */
+malloc_size_t arena_used = 0;
+malloc_size_t arena_peak = 0;
+
+/** Function arena_sbrk
+  * Ask sbrk for S bytes, or for at least ARENA_GROW_SIZE bytes when that
+  * succeeds, and return how much was obtained in *GOT.
+  */
+static char* arena_sbrk(RARG malloc_size_t s, malloc_size_t *got)
+{
+    char *p;
+    malloc_size_t want = ALIGN_SIZE(MAX(s, ARENA_GROW_SIZE), MALLOC_ALIGN);
+
+    p = _SBRK_R(RCALL want);
+    if (p == (void *)-1 && want != s)
+    {
+        /* The heap may be too small for the usual increment */
+        want = ALIGN_SIZE(s, MALLOC_ALIGN);
+        p = _SBRK_R(RCALL want);
+    }
+    *got = want;
+    return p;
+}
+
+/** Function __arena_extend
+  * Make sure there are at least S bytes between arena_top and arena_end.
+  * Algorithm:
+  *   If nothing else moved the break since the last call, grow the
+  *   current region in place.  Otherwise start bumping from a new region
+  *   and abandon what was left of the old one.
+  *   Return 0 on success, -1 if sbrk fails.
+  */
+int __arena_extend(RARG malloc_size_t s)
+{
+    char *p, *align_p;
+    malloc_size_t got;
+
+    if (arena_end != NULL && _SBRK_R(RCALL 0) == arena_end)
+    {
+        p = arena_sbrk(RCALL s - (arena_end - arena_top), &got);
+        if (p == (void *)-1)
+            return -1;
+        arena_end += got;
+        return 0;
+    }
+
+    p = arena_sbrk(RCALL s, &got);
+
+    /* sbrk returns -1 if fail to allocate */
+    if (p == (void *)-1)
+        return -1;
+
+    align_p = (char*)ALIGN_PTR((uintptr_t)p, MALLOC_ALIGN);
+    if (align_p != p)
+    {
+        /* p is not aligned, ask for a few more bytes so that we have
+         * got bytes reserved from align_p. */
+        if (_SBRK_R(RCALL align_p - p) == (void *)-1)
+            return -1;
+    }
+
+    if (arena_start == NULL) arena_start = align_p;
+    arena_top = align_p;
+    arena_end = align_p + got;
+    return 0;
+}
+
+/** Function arena_malloc
+  * Algorithm:
+  *   Reserve the header and aligned payload at arena_top and bump it,
+  *   growing the region with sbrk if it is exhausted.
+  */
+void * arena_malloc(RARG malloc_size_t s)
+{
+    char * ptr;
+    malloc_size_t alloc_size;
+
+    alloc_size = ALIGN_SIZE(s, MALLOC_ALIGN) + HEADER_SIZE;
+
+    if (alloc_size >= MAX_ALLOC_SIZE || alloc_size < s)
+    {
+        RERRNO = ENOMEM;
+        MALLOC_STATS_FAIL(s);
+        return NULL;
+    }
+
+    MALLOC_LOCK;
+
+    if ((malloc_size_t)(arena_end - arena_top) < alloc_size
+        && __arena_extend(RCALL alloc_size) != 0)
+    {
+        RERRNO = ENOMEM;
+        MALLOC_UNLOCK;
+        MALLOC_STATS_FAIL(s);
+        return NULL;
+    }
+
+    ptr = arena_top + HEADER_SIZE;
+    BLOCK_SIZE(ptr) = alloc_size - HEADER_SIZE;
+    arena_top += alloc_size;
+    arena_account(alloc_size);
+
+    MALLOC_UNLOCK;
+
+    MALLOC_STATS_ALLOC(ptr, s, alloc_size);
+    return ptr;
+}
+#endif /* DEFINE_MALLOC */
+
+#ifdef DEFINE_FREE
+/** Function arena_free
+  * Implementation of libc free.
+  * Algorithm:
+  *  If the block is the most recent allocation, roll arena_top back to
+  *  its header so the space is handed out again.  Any other block stays
+  *  where it is until the arena goes away.
+  */
+void arena_free (RARG void * free_p)
+{
+    char * block;
+
+    if (free_p == NULL) return;
+
+    block = (char *)free_p - HEADER_SIZE;
+
+    MALLOC_STATS_FREE(free_p, BLOCK_SIZE(free_p) + HEADER_SIZE);
+
+    MALLOC_LOCK;
+    if (BLOCK_END(free_p) == arena_top)
+    {
+        arena_account(-(long)(arena_top - block));
+        arena_top = block;
+    }
+    MALLOC_UNLOCK;
+}
+#endif /* DEFINE_FREE */
+
+#ifdef DEFINE_CFREE
+void arena_cfree(RARG void * ptr)
+{
+    arena_free(RCALL ptr);
+}
+#endif /* DEFINE_CFREE */
+
+#ifdef DEFINE_CALLOC
+/* Function arena_calloc
+ * Implement calloc simply by calling malloc and set zero */
+void * arena_calloc(RARG malloc_size_t n, malloc_size_t elem)
+{
+    malloc_size_t bytes;
+    void * mem;
+
+    if (__builtin_mul_overflow (n, elem, &bytes))
+    {
+        RERRNO = ENOMEM;
+        return NULL;
+    }
+    mem = arena_malloc(RCALL bytes);
+    if (mem != NULL) memset(mem, 0, bytes);
+    return mem;
+}
+#endif /* DEFINE_CALLOC */
+
+#ifdef DEFINE_REALLOC
+/* Function arena_realloc
+ * The most recent allocation is resized in place by moving arena_top,
+ * extending the region if needed.  Other blocks are kept when shrinking
+ * and otherwise moved with malloc + memcpy. */
+void * arena_realloc(RARG void * ptr, malloc_size_t size)
+{
+    void * mem;
+    malloc_size_t old_size, new_size;
+
+    if (ptr == NULL) return arena_malloc(RCALL size);
+
+    if (size == 0)
+    {
+        arena_free(RCALL ptr);
+        return NULL;
+    }
+
+    new_size = ALIGN_SIZE(size, MALLOC_ALIGN);
+    if (new_size >= MAX_ALLOC_SIZE || new_size < size)
+    {
+        RERRNO = ENOMEM;
+        return NULL;
+    }
+
+    MALLOC_STATS_REALLOC(ptr, size);
+
+    old_size = BLOCK_SIZE(ptr);
+
+    MALLOC_LOCK;
+    if (BLOCK_END(ptr) == arena_top)
+    {
+        if (new_size <= old_size
+            || (malloc_size_t)(arena_end - (char *)ptr) >= new_size)
+        {
+            arena_top = (char *)ptr + new_size;
+            arena_account((long)new_size - (long)old_size);
+            BLOCK_SIZE(ptr) = new_size;
+            MALLOC_STATS_RESIZE(ptr, old_size + HEADER_SIZE,
+                                new_size + HEADER_SIZE);
+            MALLOC_UNLOCK;
+            return ptr;
+        }
+
+        /* If the region can be extended in place the block stays the
+         * most recent allocation. */
+        if (__arena_extend(RCALL new_size - old_size) == 0
+            && BLOCK_END(ptr) == arena_top)
+        {
+            arena_top = (char *)ptr + new_size;
+            arena_account(new_size - old_size);
+            BLOCK_SIZE(ptr) = new_size;
+            MALLOC_STATS_RESIZE(ptr, old_size + HEADER_SIZE,
+                                new_size + HEADER_SIZE);
+            MALLOC_UNLOCK;
+            return ptr;
+        }
+    }
+    MALLOC_UNLOCK;
+
+    if (new_size <= old_size)
+        return ptr;
+
+    mem = arena_malloc(RCALL size);
+    if (mem != NULL)
+    {
+        memcpy(mem, ptr, old_size);
+        arena_free(RCALL ptr);
+    }
+    return mem;
+}
+#endif /* DEFINE_REALLOC */
+
+#ifdef DEFINE_MALLINFO
+struct mallinfo current_mallinfo={0,0,0,0,0,0,0,0,0,0};
+
+struct mallinfo arena_mallinfo(RONEARG)
+{
+    char * sbrk_now;
+    size_t total_size;
+
+    MALLOC_LOCK;
+
+    if (arena_start == NULL) total_size = 0;
+    else {
+        sbrk_now = _SBRK_R(RCALL 0);
+
+        if (sbrk_now == (void *)-1)
+            total_size = (size_t)-1;
+        else
+            total_size = (size_t) (sbrk_now - arena_start);
+    }
+
+    current_mallinfo.arena = total_size;
+    current_mallinfo.usmblks = arena_peak;
+    current_mallinfo.uordblks = arena_used;
+    current_mallinfo.fordblks = arena_end - arena_top;
+    current_mallinfo.keepcost = arena_end - arena_top;
+
+    MALLOC_UNLOCK;
+    return current_mallinfo;
+}
+
+#ifdef _MALLOC_STATS
+/* Report the heap for mallstats.  The only reusable free space is what
+ * is left between arena_top and arena_end. */
+void __malloc_stats_walk(struct _reent * reent_ptr,
+                         struct __malloc_heap_info * info)
+{
+    MALLOC_LOCK;
+
+    info->heap = arena_start ? (char *)_SBRK_R(RCALL 0) - arena_start : 0;
+    info->peak_heap = info->heap;
+    info->free_bytes = arena_end - arena_top;
+    info->free_chunks = info->free_bytes != 0;
+    info->largest_free = info->free_bytes;
+
+    MALLOC_UNLOCK;
+}
+#endif /* _MALLOC_STATS */
+#endif /* DEFINE_MALLINFO */
+
+#ifdef DEFINE_MALLOC_STATS
+void arena_malloc_stats(RONEARG)
+{
+    arena_mallinfo(RONECALL);
+    fiprintf(stderr, "max in use bytes = %10u\n",
+             current_mallinfo.usmblks);
+    fiprintf(stderr, "system bytes     = %10u\n",
+             current_mallinfo.arena);
+    fiprintf(stderr, "in use bytes     = %10u\n",
+             current_mallinfo.uordblks);
+}
+#endif /* DEFINE_MALLOC_STATS */
+
+#ifdef DEFINE_MALLOC_USABLE_SIZE
+malloc_size_t arena_malloc_usable_size(RARG void * ptr)
+{
+    return BLOCK_SIZE(ptr);
+}
+#endif /* DEFINE_MALLOC_USABLE_SIZE */
+
+#ifdef DEFINE_MEMALIGN
+/* Function arena_memalign
+ * Allocate memory block aligned at specific boundary.
+ *   align: required alignment. Must be power of 2. Return NULL
+ *          if not power of 2.
+ *   s: required size.
+ * Return: allocated memory pointer aligned to align
+ * Algorithm: Bump arena_top far enough that the payload lands on the
+ *            boundary.  The skipped bytes are not reused.
+ */
+void * arena_memalign(RARG size_t align, size_t s)
+{
+    char * ptr;
+    malloc_size_t alloc_size, pad;
+
+    /* Return NULL if align isn't power of 2 */
+    if ((align & (align-1)) != 0) return NULL;
+
+    align = MAX(align, MALLOC_ALIGN);
+
+    /* Make sure alloc_size does not overflow */
+    if (s > MAX_ALLOC_SIZE || align > MAX_ALLOC_SIZE)
+    {
+        RERRNO = ENOMEM;
+        MALLOC_STATS_FAIL(s);
+        return NULL;
+    }
+    alloc_size = ALIGN_SIZE(s, MALLOC_ALIGN) + HEADER_SIZE;
+
+    MALLOC_LOCK;
+
+    /* Reserve for the worst case padding, the region may move */
+    if ((malloc_size_t)(arena_end - arena_top) < alloc_size + align
+        && __arena_extend(RCALL alloc_size + align) != 0)
+    {
+        RERRNO = ENOMEM;
+        MALLOC_UNLOCK;
+        MALLOC_STATS_FAIL(s);
+        return NULL;
+    }
+
+    ptr = (char *)ALIGN_PTR((uintptr_t)arena_top + HEADER_SIZE,
+                            (uintptr_t)align);
+    pad = ptr - HEADER_SIZE - arena_top;
+    BLOCK_SIZE(ptr) = alloc_size - HEADER_SIZE;
+    arena_top += pad + alloc_size;
+    arena_account(pad + alloc_size);
+
+    MALLOC_UNLOCK;
+
+    MALLOC_STATS_ALLOC(ptr, s, alloc_size);
+    return ptr;
+}
+#endif /* DEFINE_MEMALIGN */
+
+#ifdef DEFINE_MALLOPT
+int arena_mallopt(RARG int parameter_number, int parameter_value)
+{
+    return 0;
+}
+#endif /* DEFINE_MALLOPT */
+
+#ifdef DEFINE_VALLOC
+void * arena_valloc(RARG size_t s)
+{
+    return arena_memalign(RCALL MALLOC_PAGE_ALIGN, s);
+}
+#endif /* DEFINE_VALLOC */
+
+#ifdef DEFINE_PVALLOC
+void * arena_pvalloc(RARG size_t s)
+{
+    /* Make sure size given to arena_valloc does not overflow */
+    if (s > __SIZE_MAX__ - MALLOC_PAGE_ALIGN)
+    {
+        RERRNO = ENOMEM;
+        return NULL;
+    }
+    return arena_valloc(RCALL ALIGN_SIZE(s, MALLOC_PAGE_ALIGN));
+}
+#endif /* DEFINE_PVALLOC */
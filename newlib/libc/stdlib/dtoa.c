@@ -30,7 +30,9 @@
 #include <stdlib.h>
 #include <reent.h>
 #include <string.h>
+#include <stdint.h>
 #include "mprec.h"
+#include "local.h"
 
 static int
 quorem (_Bigint * b, _Bigint * S)
@@ -139,6 +141,443 @@ quorem (_Bigint * b, _Bigint * S)
   return q;
 }
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__) \
+    && defined(IEEE_Arith) && !defined(_DOUBLE_IS_32BITS) \
+    && !defined(Sudden_Underflow) && !defined(ROUND_BIASED)
+#define Dtoa_Ryu
+#endif
+
+#ifdef Dtoa_Ryu /*{*/
+/* Ulf Adams' Ryu, for mode 0.  The value and the two ends of the
+ * interval that reads back as it are scaled by a single 128-bit power
+ * of five, and digits are then dropped from all three until the
+ * interval holds no shorter number.  No Bigint is touched.  The tables
+ * cover doubles from about 1e-100 to 1e100; anything further out goes
+ * through the general code in _dtoa_r.
+ */
+
+#define RYU_INV_SIZE	84
+#define RYU_POS_SIZE	119
+#define RYU_BITS	125
+
+/* floor(2^(pow5bits(i) - 1 + RYU_BITS) / 5^i) + 1, low half first. */
+static const uint64_t pow5_inv_split[RYU_INV_SIZE][2] = {
+  { 0x0000000000000001ULL, 0x2000000000000000ULL },
+  { 0x999999999999999aULL, 0x1999999999999999ULL },
+  { 0x47ae147ae147ae15ULL, 0x147ae147ae147ae1ULL },
+  { 0x6c8b4395810624deULL, 0x10624dd2f1a9fbe7ULL },
+  { 0x7a786c226809d496ULL, 0x1a36e2eb1c432ca5ULL },
+  { 0x61f9f01b866e43abULL, 0x14f8b588e368f084ULL },
+  { 0xb4c7f34938583622ULL, 0x10c6f7a0b5ed8d36ULL },
+  { 0x87a6520ec08d236aULL, 0x1ad7f29abcaf4857ULL },
+  { 0x9fb841a566d74f88ULL, 0x15798ee2308c39dfULL },
+  { 0xe62d01511f12a607ULL, 0x112e0be826d694b2ULL },
+  { 0xd6ae6881cb5109a4ULL, 0x1b7cdfd9d7bdbab7ULL },
+  { 0xdef1ed34a2a73aeaULL, 0x15fd7fe17964955fULL },
+  { 0x7f27f0f6e885c8bbULL, 0x119799812dea1119ULL },
+  { 0x650cb4be40d60df8ULL, 0x1c25c268497681c2ULL },
+  { 0xea70909833de7193ULL, 0x16849b86a12b9b01ULL },
+  { 0x21f3a6e0297ec143ULL, 0x1203af9ee756159bULL },
+  { 0x6985d7cd0f313537ULL, 0x1cd2b297d889bc2bULL },
+  { 0x2137dfd73f5a90f9ULL, 0x170ef54646d49689ULL },
+  { 0xe75fe645cc4873faULL, 0x12725dd1d243aba0ULL },
+  { 0xa5663d3c7a0d865dULL, 0x1d83c94fb6d2ac34ULL },
+  { 0x511e976394d79eb1ULL, 0x179ca10c9242235dULL },
+  { 0xda7edf82dd794bc1ULL, 0x12e3b40a0e9b4f7dULL },
+  { 0x2a6498d1625bac68ULL, 0x1e392010175ee596ULL },
+  { 0xeeb6e0a781e2f053ULL, 0x182db34012b25144ULL },
+  { 0x58924d52ce4f26a9ULL, 0x1357c299a88ea76aULL },
+  { 0x27507bb7b07ea441ULL, 0x1ef2d0f5da7dd8aaULL },
+  { 0x52a6c95fc0655034ULL, 0x18c240c4aecb13bbULL },
+  { 0x0eebd44c99eaa690ULL, 0x13ce9a36f23c0fc9ULL },
+  { 0xb17953adc3110a80ULL, 0x1fb0f6be50601941ULL },
+  { 0xc12ddc8b02740867ULL, 0x195a5efea6b34767ULL },
+  { 0x3424b06f3529a052ULL, 0x14484bfeebc29f86ULL },
+  { 0x901d59f290ee19dbULL, 0x1039d66589687f9eULL },
+  { 0x4cfbc31db4b0295fULL, 0x19f623d5a8a73297ULL },
+  { 0x3d9635b15d59bab2ULL, 0x14c4e977ba1f5bacULL },
+  { 0x97ab5e277de16228ULL, 0x109d8792fb4c4956ULL },
+  { 0xf2abc9d8c9689d0dULL, 0x1a95a5b7f87a0ef0ULL },
+  { 0x5bbca17a3aba173eULL, 0x154484932d2e725aULL },
+  { 0xafca1ac82efb45cbULL, 0x11039d428a8b8eaeULL },
+  { 0xb2dcf7a6b1920945ULL, 0x1b38fb9daa78e44aULL },
+  { 0xf57d92ebc141a104ULL, 0x15c72fb1552d836eULL },
+  { 0xc46475896767b403ULL, 0x116c262777579c58ULL },
+  { 0x6d6d88dbd8a5ecd2ULL, 0x1be03d0bf225c6f4ULL },
+  { 0x8abe071646eb23dbULL, 0x164cfda3281e38c3ULL },
+  { 0x6efe6c11d255b649ULL, 0x11d7314f534b609cULL },
+  { 0xb197134fb6ef8a0eULL, 0x1c8b821885456760ULL },
+  { 0x27ac0f72f8bfa1a5ULL, 0x16d601ad376ab91aULL },
+  { 0xb95672c260994e1eULL, 0x1244ce242c5560e1ULL },
+  { 0xf5571e03cdc21695ULL, 0x1d3ae36d13bbce35ULL },
+  { 0x2aac18030b01ababULL, 0x17624f8a762fd82bULL },
+  { 0xbbbce0026f348956ULL, 0x12b50c6ec4f31355ULL },
+  { 0x92c7ccd0b1eda889ULL, 0x1dee7a4ad4b81eefULL },
+  { 0xdbd30a408e57ba07ULL, 0x17f1fb6f10934bf2ULL },
+  { 0x7ca8d50071dfc806ULL, 0x1327fc58da0f6ff5ULL },
+  { 0xfaa7bb33e9660cd6ULL, 0x1ea6608e29b24cbbULL },
+  { 0x9552fc298784d711ULL, 0x18851a0b548ea3c9ULL },
+  { 0xaaa8c9bad2d0ac0eULL, 0x139dae6f76d88307ULL },
+  { 0xdddadc5e1e1aace3ULL, 0x1f62b0b257c0d1a5ULL },
+  { 0x7e48b04b4b488a4fULL, 0x191bc08eac9a4151ULL },
+  { 0xcb6d59d5d5d3a1d9ULL, 0x141633a556e1cddaULL },
+  { 0x3c577b1177dc817bULL, 0x1011c2eaabe7d7e2ULL },
+  { 0xc6f25e825960cf2aULL, 0x19b604aaaca62636ULL },
+  { 0x6bf518684780a5bbULL, 0x14919d5556eb51c5ULL },
+  { 0x232a79ed06008496ULL, 0x10747ddddf22a7d1ULL },
+  { 0xd1dd8fe1a3340756ULL, 0x1a53fc9631d10c81ULL },
+  { 0xa7e4731ae8f66c45ULL, 0x150ffd44f4a73d34ULL },
+  { 0x531d28e253f8569eULL, 0x10d9976a5d52975dULL },
+  { 0xeb61db03b98d5762ULL, 0x1af5bf109550f22eULL },
+  { 0xbc4e48cfc7a445e8ULL, 0x159165a6ddda5b58ULL },
+  { 0x6371d3d96c836b20ULL, 0x11411e1f17e1e2adULL },
+  { 0x9f1c8628ad9f11cdULL, 0x1b9b6364f3030448ULL },
+  { 0xe5b06b53be18db0bULL, 0x1615e91d8f359d06ULL },
+  { 0xeaf3890fcb4715a2ULL, 0x11ab20e472914a6bULL },
+  { 0x44b8db4c7871bc37ULL, 0x1c45016d841baa46ULL },
+  { 0x03c715d6c6c1635fULL, 0x169d9abe03495505ULL },
+  { 0x3638de456bcde919ULL, 0x1217aefe69077737ULL },
+  { 0x56c163a2461641c1ULL, 0x1cf2b1970e725858ULL },
+  { 0xdf011c81d1ab67ceULL, 0x17288e1271f51379ULL },
+  { 0x7f3416ce4155eca5ULL, 0x1286d80ec190dc61ULL },
+  { 0x6520247d3556476eULL, 0x1da48ce468e7c702ULL },
+  { 0xea801d30f7783925ULL, 0x17b6d71d20b96c01ULL },
+  { 0xbb99b0f3f92cfa84ULL, 0x12f8ac174d612334ULL },
+  { 0x5f5c4e532847f739ULL, 0x1e5aacf215683854ULL },
+  { 0x7f7d0b75b9d32c2eULL, 0x18488a5b44536043ULL },
+  { 0x9930d5f7c7dc2358ULL, 0x136d3b7c36a919cfULL }
+};
+
+/* The leading RYU_BITS bits of 5^i, low half first. */
+static const uint64_t pow5_split[RYU_POS_SIZE][2] = {
+  { 0x0000000000000000ULL, 0x1000000000000000ULL },
+  { 0x0000000000000000ULL, 0x1400000000000000ULL },
+  { 0x0000000000000000ULL, 0x1900000000000000ULL },
+  { 0x0000000000000000ULL, 0x1f40000000000000ULL },
+  { 0x0000000000000000ULL, 0x1388000000000000ULL },
+  { 0x0000000000000000ULL, 0x186a000000000000ULL },
+  { 0x0000000000000000ULL, 0x1e84800000000000ULL },
+  { 0x0000000000000000ULL, 0x1312d00000000000ULL },
+  { 0x0000000000000000ULL, 0x17d7840000000000ULL },
+  { 0x0000000000000000ULL, 0x1dcd650000000000ULL },
+  { 0x0000000000000000ULL, 0x12a05f2000000000ULL },
+  { 0x0000000000000000ULL, 0x174876e800000000ULL },
+  { 0x0000000000000000ULL, 0x1d1a94a200000000ULL },
+  { 0x0000000000000000ULL, 0x12309ce540000000ULL },
+  { 0x0000000000000000ULL, 0x16bcc41e90000000ULL },
+  { 0x0000000000000000ULL, 0x1c6bf52634000000ULL },
+  { 0x0000000000000000ULL, 0x11c37937e0800000ULL },
+  { 0x0000000000000000ULL, 0x16345785d8a00000ULL },
+  { 0x0000000000000000ULL, 0x1bc16d674ec80000ULL },
+  { 0x0000000000000000ULL, 0x1158e460913d0000ULL },
+  { 0x0000000000000000ULL, 0x15af1d78b58c4000ULL },
+  { 0x0000000000000000ULL, 0x1b1ae4d6e2ef5000ULL },
+  { 0x0000000000000000ULL, 0x10f0cf064dd59200ULL },
+  { 0x0000000000000000ULL, 0x152d02c7e14af680ULL },
+  { 0x0000000000000000ULL, 0x1a784379d99db420ULL },
+  { 0x0000000000000000ULL, 0x108b2a2c28029094ULL },
+  { 0x0000000000000000ULL, 0x14adf4b7320334b9ULL },
+  { 0x4000000000000000ULL, 0x19d971e4fe8401e7ULL },
+  { 0x8800000000000000ULL, 0x1027e72f1f128130ULL },
+  { 0xaa00000000000000ULL, 0x1431e0fae6d7217cULL },
+  { 0xd480000000000000ULL, 0x193e5939a08ce9dbULL },
+  { 0xc9a0000000000000ULL, 0x1f8def8808b02452ULL },
+  { 0xbe04000000000000ULL, 0x13b8b5b5056e16b3ULL },
+  { 0xad85000000000000ULL, 0x18a6e32246c99c60ULL },
+  { 0xd8e6400000000000ULL, 0x1ed09bead87c0378ULL },
+  { 0x878fe80000000000ULL, 0x13426172c74d822bULL },
+  { 0x6973e20000000000ULL, 0x1812f9cf7920e2b6ULL },
+  { 0x03d0da8000000000ULL, 0x1e17b84357691b64ULL },
+  { 0x8262889000000000ULL, 0x12ced32a16a1b11eULL },
+  { 0x22fb2ab400000000ULL, 0x178287f49c4a1d66ULL },
+  { 0xabb9f56100000000ULL, 0x1d6329f1c35ca4bfULL },
+  { 0xcb54395ca0000000ULL, 0x125dfa371a19e6f7ULL },
+  { 0xbe2947b3c8000000ULL, 0x16f578c4e0a060b5ULL },
+  { 0x2db399a0ba000000ULL, 0x1cb2d6f618c878e3ULL },
+  { 0xfc90400474400000ULL, 0x11efc659cf7d4b8dULL },
+  { 0x7bb4500591500000ULL, 0x166bb7f0435c9e71ULL },
+  { 0xdaa16406f5a40000ULL, 0x1c06a5ec5433c60dULL },
+  { 0xa8a4de8459868000ULL, 0x118427b3b4a05bc8ULL },
+  { 0xd2ce16256fe82000ULL, 0x15e531a0a1c872baULL },
+  { 0x87819baecbe22800ULL, 0x1b5e7e08ca3a8f69ULL },
+  { 0xf4b1014d3f6d5900ULL, 0x111b0ec57e6499a1ULL },
+  { 0x71dd41a08f48af40ULL, 0x1561d276ddfdc00aULL },
+  { 0x0e549208b31adb10ULL, 0x1aba4714957d300dULL },
+  { 0x28f4db456ff0c8eaULL, 0x10b46c6cdd6e3e08ULL },
+  { 0x33321216cbecfb24ULL, 0x14e1878814c9cd8aULL },
+  { 0xbffe969c7ee839edULL, 0x1a19e96a19fc40ecULL },
+  { 0xf7ff1e21cf512434ULL, 0x105031e2503da893ULL },
+  { 0xf5fee5aa43256d41ULL, 0x14643e5ae44d12b8ULL },
+  { 0x337e9f14d3eec892ULL, 0x197d4df19d605767ULL },
+  { 0x005e46da08ea7ab6ULL, 0x1fdca16e04b86d41ULL },
+  { 0xa03aec4845928cb2ULL, 0x13e9e4e4c2f34448ULL },
+  { 0xc849a75a56f72fdeULL, 0x18e45e1df3b0155aULL },
+  { 0x7a5c1130ecb4fbd6ULL, 0x1f1d75a5709c1ab1ULL },
+  { 0xec798abe93f11d65ULL, 0x13726987666190aeULL },
+  { 0xa797ed6e38ed64bfULL, 0x184f03e93ff9f4daULL },
+  { 0x517de8c9c728bdefULL, 0x1e62c4e38ff87211ULL },
+  { 0xd2eeb17e1c7976b5ULL, 0x12fdbb0e39fb474aULL },
+  { 0x87aa5ddda397d462ULL, 0x17bd29d1c87a191dULL },
+  { 0xe994f5550c7dc97bULL, 0x1dac74463a989f64ULL },
+  { 0x11fd195527ce9dedULL, 0x128bc8abe49f639fULL },
+  { 0xd67c5faa71c24568ULL, 0x172ebad6ddc73c86ULL },
+  { 0x8c1b77950e32d6c2ULL, 0x1cfa698c95390ba8ULL },
+  { 0x57912abd28dfc639ULL, 0x121c81f7dd43a749ULL },
+  { 0xad75756c7317b7c8ULL, 0x16a3a275d494911bULL },
+  { 0x98d2d2c78fdda5baULL, 0x1c4c8b1349b9b562ULL },
+  { 0x9f83c3bcb9ea8794ULL, 0x11afd6ec0e14115dULL },
+  { 0x0764b4abe8652979ULL, 0x161bcca7119915b5ULL },
+  { 0x493de1d6e27e73d7ULL, 0x1ba2bfd0d5ff5b22ULL },
+  { 0x6dc6ad264d8f0866ULL, 0x1145b7e285bf98f5ULL },
+  { 0xc938586fe0f2ca80ULL, 0x159725db272f7f32ULL },
+  { 0x7b866e8bd92f7d20ULL, 0x1afcef51f0fb5effULL },
+  { 0xad34051767bdae34ULL, 0x10de1593369d1b5fULL },
+  { 0x9881065d41ad19c1ULL, 0x15159af804446237ULL },
+  { 0x7ea147f492186032ULL, 0x1a5b01b605557ac5ULL },
+  { 0x6f24ccf8db4f3c1fULL, 0x1078e111c3556cbbULL },
+  { 0x4aee003712230b27ULL, 0x14971956342ac7eaULL },
+  { 0xdda98044d6abcdf0ULL, 0x19bcdfabc13579e4ULL },
+  { 0x0a89f02b062b60b6ULL, 0x10160bcb58c16c2fULL },
+  { 0xcd2c6c35c7b638e4ULL, 0x141b8ebe2ef1c73aULL },
+  { 0x8077874339a3c71dULL, 0x1922726dbaae3909ULL },
+  { 0xe0956914080cb8e4ULL, 0x1f6b0f092959c74bULL },
+  { 0x6c5d61ac8507f38eULL, 0x13a2e965b9d81c8fULL },
+  { 0x4774ba17a649f072ULL, 0x188ba3bf284e23b3ULL },
+  { 0x1951e89d8fdc6c8fULL, 0x1eae8caef261aca0ULL },
+  { 0x0fd3316279e9c3d9ULL, 0x132d17ed577d0be4ULL },
+  { 0x13c7fdbb186434cfULL, 0x17f85de8ad5c4eddULL },
+  { 0x58b9fd29de7d4203ULL, 0x1df67562d8b36294ULL },
+  { 0xb7743e3a2b0e4942ULL, 0x12ba095dc7701d9cULL },
+  { 0xe5514dc8b5d1db92ULL, 0x17688bb5394c2503ULL },
+  { 0xdea5a13ae3465277ULL, 0x1d42aea2879f2e44ULL },
+  { 0x0b2784c4ce0bf38aULL, 0x1249ad2594c37cebULL },
+  { 0xcdf165f6018ef06dULL, 0x16dc186ef9f45c25ULL },
+  { 0x416dbf7381f2ac88ULL, 0x1c931e8ab871732fULL },
+  { 0x88e497a83137abd5ULL, 0x11dbf316b346e7fdULL },
+  { 0xeb1dbd923d8596caULL, 0x1652efdc6018a1fcULL },
+  { 0x25e52cf6cce6fc7dULL, 0x1be7abd3781eca7cULL },
+  { 0x97af3c1a40105dceULL, 0x1170cb642b133e8dULL },
+  { 0xfd9b0b20d0147542ULL, 0x15ccfe3d35d80e30ULL },
+  { 0x3d01cde904199292ULL, 0x1b403dcc834e11bdULL },
+  { 0x462120b1a28ffb9bULL, 0x1108269fd210cb16ULL },
+  { 0xd7a968de0b33fa82ULL, 0x154a3047c694fddbULL },
+  { 0xcd93c3158e00f923ULL, 0x1a9cbc59b83a3d52ULL },
+  { 0xc07c59ed78c09bb6ULL, 0x10a1f5b813246653ULL },
+  { 0xb09b7068d6f0c2a3ULL, 0x14ca732617ed7fe8ULL },
+  { 0xdcc24c830cacf34cULL, 0x19fd0fef9de8dfe2ULL },
+  { 0xc9f96fd1e7ec180fULL, 0x103e29f5c2b18bedULL },
+  { 0x3c77cbc661e71e13ULL, 0x144db473335deee9ULL },
+  { 0x8b95beb7fa60e598ULL, 0x1961219000356aa3ULL },
+  { 0x6e7b2e65f8f91efeULL, 0x1fb969f40042c54cULL }
+};
+
+/* The bit length of 5^e, and floor(log10(2^e)) and floor(log10(5^e)),
+ * for the exponents that occur here.
+ */
+#define pow5bits(e)	((int) (((__ULong) (e) * 1217359) >> 19) + 1)
+#define log10pow2(e)	((int) (((__ULong) (e) * 78913) >> 18))
+#define log10pow5(e)	((int) (((__ULong) (e) * 732923) >> 20))
+
+/* The 128-bit product of A and B, returning the high half.  */
+static uint64_t
+mul64x64 (uint64_t a,
+	uint64_t b,
+	uint64_t *lo)
+{
+  uint64_t a0 = (uint32_t) a, a1 = a >> 32;
+  uint64_t b0 = (uint32_t) b, b1 = b >> 32;
+  uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  uint64_t mid = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+
+  *lo = (mid << 32) | (uint32_t) p00;
+  return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+/* (M * MUL) >> J, where MUL is a table entry and 64 < J < 128.  */
+static uint64_t
+mul_shift64 (uint64_t m,
+	const uint64_t *mul,
+	int j)
+{
+  uint64_t hi0, hi1, lo0, lo1, mid;
+
+  hi0 = mul64x64 (m, mul[0], &lo0);
+  hi1 = mul64x64 (m, mul[1], &lo1);
+  mid = hi0 + lo1;
+  if (mid < hi0)
+    hi1++;
+  j -= 64;
+  return (hi1 << (64 - j)) | (mid >> j);
+}
+
+static int
+pow5_factor (uint64_t v)
+{
+  int n = 0;
+
+  while (v % 5 == 0)
+    {
+      v /= 5;
+      n++;
+    }
+  return n;
+}
+
+/* Store the shortest digits of D, which is finite and positive, in
+ * BUF without trailing zeros, set *DECPT and return the number of
+ * digits; or return 0 if D is out of the range of the tables.
+ */
+static int
+dtoa_ryu (union double_union d,
+	char *buf,
+	int *decpt)
+{
+  uint64_t m2, mv, vr, vp, vm, q10;
+  int e2, e10, q, i, j, n, even, mm_shift, removed, last, round_up;
+  int vm_zeros = 0, vr_zeros = 0;
+
+  m2 = ((uint64_t) (word0 (d) & Frac_mask) << 32) | word1 (d);
+  i = (int) (word0 (d) >> Exp_shift1);
+  mm_shift = m2 != 0 || i <= 1;
+  /* Two extra bits for the interval ends.  */
+  if (i == 0)
+    e2 = 1 - Bias - (P - 1) - 2;
+  else
+    {
+      e2 = i - Bias - (P - 1) - 2;
+      m2 |= (uint64_t) 1 << (P - 1);
+    }
+  even = (m2 & 1) == 0;
+  mv = 4 * m2;
+
+  if (e2 >= 0)
+    {
+      q = log10pow2 (e2) - (e2 > 3);
+      if (q >= RYU_INV_SIZE)
+	return 0;
+      e10 = q;
+      j = -e2 + q + RYU_BITS + pow5bits (q) - 1;
+      vr = mul_shift64 (mv, pow5_inv_split[q], j);
+      vp = mul_shift64 (mv + 2, pow5_inv_split[q], j);
+      vm = mul_shift64 (mv - 1 - mm_shift, pow5_inv_split[q], j);
+      /* At most one of the three can be a multiple of 5^q.  */
+      if (q <= 21)
+	{
+	  if (mv % 5 == 0)
+	    vr_zeros = pow5_factor (mv) >= q;
+	  else if (even)
+	    vm_zeros = pow5_factor (mv - 1 - mm_shift) >= q;
+	  else
+	    vp -= pow5_factor (mv + 2) >= q;
+	}
+    }
+  else
+    {
+      q = log10pow5 (-e2) - (-e2 > 1);
+      e10 = q + e2;
+      i = -e2 - q;
+      if (i >= RYU_POS_SIZE)
+	return 0;
+      j = q - (pow5bits (i) - RYU_BITS);
+      vr = mul_shift64 (mv, pow5_split[i], j);
+      vp = mul_shift64 (mv + 2, pow5_split[i], j);
+      vm = mul_shift64 (mv - 1 - mm_shift, pow5_split[i], j);
+      if (q <= 1)
+	{
+	  vr_zeros = 1;
+	  if (even)
+	    vm_zeros = mm_shift;
+	  else
+	    vp--;
+	}
+      else if (q < 63)
+	vr_zeros = (mv & (((uint64_t) 1 << q) - 1)) == 0;
+    }
+
+  removed = last = 0;
+  if (vm_zeros || vr_zeros)
+    {
+      /* The rare case where a dropped digit may sit exactly on a
+	 boundary.  */
+      while (vp / 10 > vm / 10)
+	{
+	  vm_zeros &= vm % 10 == 0;
+	  vr_zeros &= last == 0;
+	  last = (int) (vr % 10);
+	  vr /= 10;
+	  vp /= 10;
+	  vm /= 10;
+	  removed++;
+	}
+      if (vm_zeros)
+	while (vm % 10 == 0)
+	  {
+	    vr_zeros &= last == 0;
+	    last = (int) (vr % 10);
+	    vr /= 10;
+	    vp /= 10;
+	    vm /= 10;
+	    removed++;
+	  }
+      /* Exactly halfway: round to even.  */
+      if (vr_zeros && last == 5 && vr % 2 == 0)
+	last = 4;
+      vr += (vr == vm && (!even || !vm_zeros)) || last >= 5;
+    }
+  else
+    {
+      round_up = 0;
+      if (vp / 100 > vm / 100)
+	{
+	  round_up = vr % 100 >= 50;
+	  vr /= 100;
+	  vp /= 100;
+	  vm /= 100;
+	  removed += 2;
+	}
+      while (vp / 10 > vm / 10)
+	{
+	  round_up = vr % 10 >= 5;
+	  vr /= 10;
+	  vp /= 10;
+	  vm /= 10;
+	  removed++;
+	}
+      vr += vr == vm || round_up;
+    }
+
+  /* Rounding up may have left trailing zeros.  */
+  while ((q10 = vr / 10) * 10 == vr)
+    {
+      vr = q10;
+      removed++;
+    }
+  n = __dec_len64 (vr);
+  __dec_put64 (vr, buf + n);
+  *decpt = e10 + removed + n;
+  return n;
+}
+
+#undef pow5bits
+#undef log10pow2
+#undef log10pow5
+#endif /*}Dtoa_Ryu*/
+
+/* Allocate the result buffer for at least I characters.  */
+static char *
+rv_alloc (struct _reent *ptr,
+	int i)
+{
+  int j;
+
+  j = sizeof (__ULong);
+  for (_REENT_MP_RESULT_K(ptr) = 0; sizeof (_Bigint) - sizeof (__ULong) + j <= i;
+       j <<= 1)
+    _REENT_MP_RESULT_K(ptr)++;
+  _REENT_MP_RESULT(ptr) = eBalloc (ptr, _REENT_MP_RESULT_K(ptr));
+  return (char *) _REENT_MP_RESULT(ptr);
+}
+
 /* dtoa for IEEE arithmetic (dmg): convert double to ASCII string.
  *
  * Inspired by "How to Print Floating-Point Numbers Accurately" by
@@ -171,6 +610,8 @@ quorem (_Bigint * b, _Bigint * S)
  *	   "uniformly" distributed input, the probability is
  *	   something like 10^(k-15) that we must resort to the long
  *	   calculation.
+ *	7. Mode 0 is first tried with dtoa_ryu (), which needs no
+ *	   multiple-precision integers at all.
  */
 
 
@@ -284,6 +725,24 @@ _dtoa_r (struct _reent *ptr,
       return s;
     }
 
+#ifdef Dtoa_Ryu
+  if (mode <= 0 || mode > 9)
+    {
+      char digits[17];
+
+      if ((i = dtoa_ryu (d, digits, decpt)) != 0)
+	{
+	  s = s0 = rv_alloc (ptr, 18);
+	  memcpy (s, digits, i);
+	  s += i;
+	  *s = 0;
+	  if (rve)
+	    *rve = s;
+	  return s0;
+	}
+    }
+#endif
+
   b = d2b (ptr, d.d, &be, &bbits);
 #ifdef Sudden_Underflow
   i = (int) (word0 (d) >> Exp_shift1 & (Exp_mask >> Exp_shift1));
@@ -419,12 +878,7 @@ _dtoa_r (struct _reent *ptr,
       if (i <= 0)
 	i = 1;
     }
-  j = sizeof (__ULong);
-  for (_REENT_MP_RESULT_K(ptr) = 0; sizeof (_Bigint) - sizeof (__ULong) + j <= i;
-       j <<= 1)
-    _REENT_MP_RESULT_K(ptr)++;
-  _REENT_MP_RESULT(ptr) = eBalloc (ptr, _REENT_MP_RESULT_K(ptr));
-  s = s0 = (char *) _REENT_MP_RESULT(ptr);
+  s = s0 = rv_alloc (ptr, i);
 
   if (ilim >= 0 && ilim <= Quick_max && try_quick)
     {
@@ -5,6 +5,25 @@
 
 char *	_gcvt (struct _reent *, double , int , char *, char, int);
 
+#include <stdint.h>
+
+/* Integer to digits, in utoa_core.c.  The put functions store the digits
+   of a value so that they end just before END and return a pointer to
+   the first one; the len functions say how many there will be.  */
+int	__dec_len64 (uint64_t);
+char *	__dec_put64 (uint64_t, char *);
+#ifdef __SIZEOF_INT128__
+int	__dec_len128 (unsigned __int128);
+char *	__dec_put128 (unsigned __int128, char *);
+#endif
+char *	__hex_put64 (uint64_t, char *, const char *);
+char *	__ulltoa_base (uint64_t, char *, int);
+
+/* Plain decimal or hexadecimal digits for the strtol family, in
+   strtol_fast.c.  Returns the end of the number, or NULL if the caller
+   has to parse it the general way.  */
+const char *	__strtou64_fast (const char *, int, uint64_t *, int *);
+
 #include "../locale/setlocale.h"
 
 #ifndef __machine_mbstate_t_defined
@@ -52,6 +71,15 @@ mbtowc_f __big5_mbtowc;
 
 #define __MBTOWC (__get_current_locale ()->mbtowc)
 
+#if defined(_MB_CAPABLE) \
+    && !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+/* The string conversion functions convert runs of UTF-8 which need no
+   conversion state in bulk, with these from mbtowc_r.c and wctomb_r.c.  */
+#define __UTF8_RUNS
+size_t __utf8_mbsrun (wchar_t *, const char **, size_t, size_t);
+size_t __utf8_wcsrun (char *, const wchar_t **, size_t, size_t);
+#endif
+
 extern wchar_t __iso_8859_conv[14][0x60];
 int __iso_8859_val_index (int);
 int __iso_8859_index (const char *);
@@ -0,0 +1,67 @@
+/*
+FUNCTION
+<<ltoa>>---long to string
+
+INDEX
+	ltoa
+
+SYNOPSIS
+	#include <stdlib.h>
+	char *ltoa(long <[value]>, char *<[str]>, int <[base]>);
+	char *__ltoa(long <[value]>, char *<[str]>, int <[base]>);
+
+DESCRIPTION
+<<ltoa>> converts the long <[value]> to a null-terminated string
+using the specified base, which must be between 2 and 36, inclusive.
+If <[base]> is 10, <[value]> is treated as signed and the string will be
+prefixed with '-' if negative. For all other bases, <[value]> is treated as
+unsigned. <[str]> should be an array long enough to contain the converted
+value, which in the worst case is sizeof(long)*8+1 bytes.
+
+RETURNS
+A pointer to the string, <[str]>, or NULL if <[base]> is invalid.
+
+PORTABILITY
+<<ltoa>> is non-ANSI.
+
+No supporting OS subroutine calls are required.
+*/
+
+#include <stdlib.h>
+
+char *
+__ltoa (long value,
+        char *str,
+        int base)
+{
+  unsigned long uvalue;
+  int i = 0;
+
+  /* Check base is supported. */
+  if ((base < 2) || (base > 36))
+    {
+      str[0] = '\0';
+      return NULL;
+    }
+
+  /* Negative numbers are only supported for decimal.
+   * Cast to unsigned to avoid overflow for maximum negative value.  */
+  if ((base == 10) && (value < 0))
+    {
+      str[i++] = '-';
+      uvalue = -(unsigned long)value;
+    }
+  else
+    uvalue = (unsigned long)value;
+
+  __ultoa (uvalue, &str[i], base);
+  return str;
+}
+
+char *
+ltoa (long value,
+        char *str,
+        int base)
+{
+  return __ltoa (value, str, base);
+}
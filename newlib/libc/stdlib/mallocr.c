@@ -347,6 +347,8 @@ int	fiprintf (FILE *, const char *, ...);
 #define RCALL reent_ptr,
 #define RONECALL reent_ptr
 
+#include "malltrace.h"
+
 #else /* ! INTERNAL_NEWLIB */
 
 #define POINTER_UINT unsigned long
@@ -357,6 +359,12 @@ int	fiprintf (FILE *, const char *, ...);
 #define RCALL
 #define RONECALL
 
+#define MALLOC_STATS_ALLOC(ptr, request, size)
+#define MALLOC_STATS_FREE(ptr, size)
+#define MALLOC_STATS_REALLOC(ptr, request)
+#define MALLOC_STATS_RESIZE(ptr, old_size, new_size)
+#define MALLOC_STATS_FAIL(request)
+
 #endif /* ! INTERNAL_NEWLIB */
 
 /*
@@ -1076,6 +1084,29 @@ int     mALLOPt();
 struct mallinfo mALLINFo();
 #endif
 
+/*
+  With statistics enabled, malloc and free are wrappers that record each
+  call, around the allocator proper compiled as malloc_unhooked and
+  free_unhooked.  The allocator's own calls, to allocate a chunk it then
+  trims or to give back part of a chunk, go to these directly, so that
+  only whole blocks handed to or returned by the caller are counted.
+*/
+
+#ifdef _MALLOC_STATS
+#define malloc_unhooked		__malloc_unhooked
+#define free_unhooked		__malloc_free_unhooked
+#if __STD_C
+Void_t* malloc_unhooked(RARG size_t);
+void    free_unhooked(RARG Void_t*);
+#else
+Void_t* malloc_unhooked();
+void    free_unhooked();
+#endif
+#else
+#define malloc_unhooked		mALLOc
+#define free_unhooked		fREe
+#endif
+
 
 #ifdef __cplusplus
 };  /* end of extern "C" */
@@ -2242,7 +2273,7 @@ static void malloc_extend_top(RARG nb) RDECL INTERNAL_SIZE_T nb;
         SIZE_SZ|PREV_INUSE;
       /* If possible, release the rest. */
       if (old_top_size >= MINSIZE)
-        fREe(RCALL chunk2mem(old_top));
+        free_unhooked(RCALL chunk2mem(old_top));
     }
   }
 
@@ -2327,6 +2358,33 @@ static void malloc_extend_top(RARG nb) RDECL INTERNAL_SIZE_T nb;
 
 */
 
+#ifdef _MALLOC_STATS
+
+/*
+  Having one place to hook saves instrumenting each of the many return
+  paths of the allocator below.
+*/
+
+#if __STD_C
+Void_t* mALLOc(RARG size_t bytes)
+#else
+Void_t* mALLOc(RARG bytes) RDECL size_t bytes;
+#endif
+{
+  Void_t* mem = malloc_unhooked(RCALL bytes);
+
+  if (mem != 0)
+    MALLOC_STATS_ALLOC(mem, bytes, chunksize(mem2chunk(mem)));
+  else
+    MALLOC_STATS_FAIL(bytes);
+  return mem;
+}
+
+#undef mALLOc
+#define mALLOc malloc_unhooked
+
+#endif /* _MALLOC_STATS */
+
 #if __STD_C
 Void_t* mALLOc(RARG size_t bytes)
 #else
@@ -2625,6 +2683,24 @@ Void_t* mALLOc(RARG bytes) RDECL size_t bytes;
 */
 
 
+#ifdef _MALLOC_STATS
+
+#if __STD_C
+void fREe(RARG Void_t* mem)
+#else
+void fREe(RARG mem) RDECL Void_t* mem;
+#endif
+{
+  if (mem != 0)
+    MALLOC_STATS_FREE(mem, chunksize(mem2chunk(mem)));
+  free_unhooked(RCALL mem);
+}
+
+#undef fREe
+#define fREe free_unhooked
+
+#endif /* _MALLOC_STATS */
+
 #if __STD_C
 void fREe(RARG Void_t* mem)
 #else
@@ -2812,6 +2888,8 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
   /* realloc of null is supposed to be same as malloc */
   if (oldmem == 0) return mALLOc(RCALL bytes);
 
+  MALLOC_STATS_REALLOC(oldmem, bytes);
+
   MALLOC_LOCK;
 
   newp    = oldp    = mem2chunk(oldmem);
@@ -2879,6 +2957,7 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
           top = chunk_at_offset(oldp, nb);
           set_head(top, (newsize - nb) | PREV_INUSE);
           set_head_size(oldp, nb);
+          MALLOC_STATS_RESIZE(oldmem, oldsize, nb);
 	  MALLOC_UNLOCK;
           return chunk2mem(oldp);
         }
@@ -2922,6 +3001,7 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
             top = chunk_at_offset(newp, nb);
             set_head(top, (newsize - nb) | PREV_INUSE);
             set_head_size(newp, nb);
+            MALLOC_STATS_RESIZE(newmem, oldsize, nb);
 	    MALLOC_UNLOCK;
             return newmem;
           }
@@ -2954,10 +3034,11 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
 
     /* Must allocate */
 
-    newmem = mALLOc (RCALL bytes);
+    newmem = malloc_unhooked (RCALL bytes);
 
     if (newmem == 0)  /* propagate failure */
     {
+      MALLOC_STATS_FAIL(bytes);
       MALLOC_UNLOCK;
       return 0;
     }
@@ -2973,6 +3054,7 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
     }
 
     /* Otherwise copy, free, and exit */
+    MALLOC_STATS_ALLOC(newmem, bytes, chunksize(newp));
     MALLOC_COPY(newmem, oldmem, oldsize - SIZE_SZ);
     fREe(RCALL oldmem);
     MALLOC_UNLOCK;
@@ -2990,7 +3072,7 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
     set_head_size(newp, nb);
     set_head(remainder, remainder_size | PREV_INUSE);
     set_inuse_bit_at_offset(remainder, remainder_size);
-    fREe(RCALL chunk2mem(remainder)); /* let free() deal with it */
+    free_unhooked(RCALL chunk2mem(remainder)); /* let free() deal with it */
   }
   else
   {
@@ -2998,6 +3080,8 @@ Void_t* rEALLOc(RARG oldmem, bytes) RDECL Void_t* oldmem; size_t bytes;
     set_inuse_bit_at_offset(newp, newsize);
   }
 
+  MALLOC_STATS_RESIZE(chunk2mem(newp), oldsize, chunksize(newp));
+
   check_inuse_chunk(newp);
   MALLOC_UNLOCK;
   return chunk2mem(newp);
@@ -3063,9 +3147,13 @@ Void_t* mEMALIGn(RARG alignment, bytes) RDECL size_t alignment; size_t bytes;
     return 0;
   }
 
-  m  = (char*)(mALLOc(RCALL nb + alignment + MINSIZE));
+  m  = (char*)(malloc_unhooked(RCALL nb + alignment + MINSIZE));
 
-  if (m == 0) return 0; /* propagate failure */
+  if (m == 0) /* propagate failure */
+  {
+    MALLOC_STATS_FAIL(bytes);
+    return 0;
+  }
 
   MALLOC_LOCK;
 
@@ -3076,6 +3164,7 @@ Void_t* mEMALIGn(RARG alignment, bytes) RDECL size_t alignment; size_t bytes;
 #if HAVE_MMAP
     if(chunk_is_mmapped(p))
     {
+      MALLOC_STATS_ALLOC(chunk2mem(p), bytes, chunksize(p));
       MALLOC_UNLOCK;
       return chunk2mem(p); /* nothing more to do */
     }
@@ -3104,6 +3193,7 @@ Void_t* mEMALIGn(RARG alignment, bytes) RDECL size_t alignment; size_t bytes;
     {
       newp->prev_size = p->prev_size + leadsize;
       set_head(newp, newsize|IS_MMAPPED);
+      MALLOC_STATS_ALLOC(chunk2mem(newp), bytes, chunksize(newp));
       MALLOC_UNLOCK;
       return chunk2mem(newp);
     }
@@ -3114,7 +3204,7 @@ Void_t* mEMALIGn(RARG alignment, bytes) RDECL size_t alignment; size_t bytes;
     set_head(newp, newsize | PREV_INUSE);
     set_inuse_bit_at_offset(newp, newsize);
     set_head_size(p, leadsize);
-    fREe(RCALL chunk2mem(p));
+    free_unhooked(RCALL chunk2mem(p));
     p = newp;
 
     assert (newsize >= nb && (((unsigned long)(chunk2mem(p))) % alignment) == 0);
@@ -3129,10 +3219,11 @@ Void_t* mEMALIGn(RARG alignment, bytes) RDECL size_t alignment; size_t bytes;
     remainder = chunk_at_offset(p, nb);
     set_head(remainder, remainder_size | PREV_INUSE);
     set_head_size(p, nb);
-    fREe(RCALL chunk2mem(remainder));
+    free_unhooked(RCALL chunk2mem(remainder));
   }
 
   check_inuse_chunk(p);
+  MALLOC_STATS_ALLOC(chunk2mem(p), bytes, chunksize(p));
   MALLOC_UNLOCK;
   return chunk2mem(p);
 
@@ -3474,6 +3565,51 @@ STATIC void malloc_update_mallinfo()
 
 }
 
+#ifdef _MALLOC_STATS
+
+/* Report the heap and the free chunks, top included, for mallstats */
+
+void __malloc_stats_walk(RARG struct __malloc_heap_info *info)
+{
+  int i;
+  mbinptr b;
+  mchunkptr p;
+  INTERNAL_SIZE_T sz;
+
+  MALLOC_LOCK;
+
+  info->heap = sbrked_mem;
+  info->peak_heap = max_sbrked_mem;
+  info->free_chunks = 0;
+  info->free_bytes = 0;
+  info->largest_free = 0;
+
+  sz = chunksize(top);
+  if ((long)(sz) >= (long)MINSIZE)
+  {
+    info->free_chunks = 1;
+    info->free_bytes = sz;
+    info->largest_free = sz;
+  }
+
+  for (i = 1; i < NAV; ++i)
+  {
+    b = bin_at(i);
+    for (p = last(b); p != b; p = p->bk)
+    {
+      sz = chunksize(p);
+      info->free_chunks++;
+      info->free_bytes += sz;
+      if (sz > info->largest_free)
+        info->largest_free = sz;
+    }
+  }
+
+  MALLOC_UNLOCK;
+}
+
+#endif /* _MALLOC_STATS */
+
 #else /* ! DEFINE_MALLINFO */
 
 #if __STD_C
@@ -0,0 +1,261 @@
+/* VxWorks provides its own version of malloc, and we can't use this
+   one because VxWorks does not provide sbrk.  So we have a hook to
+   not compile this code.  */
+
+#ifdef MALLOC_PROVIDED
+
+int _dummy_malltrace = 1;
+
+#else
+
+/*
+FUNCTION
+<<mallstats>>, <<malloc_trace>>, <<malloc_trace_read>>---malloc instrumentation
+
+INDEX
+	mallstats
+INDEX
+	malloc_trace
+INDEX
+	malloc_trace_read
+INDEX
+	_mallstats_r
+
+SYNOPSIS
+	#include <malloc.h>
+	int mallstats(struct mallstats *<[stats]>);
+	int malloc_trace(int <[enable]>);
+	size_t malloc_trace_read(struct malloc_event *<[events]>, size_t <[n]>);
+
+	int _mallstats_r(void *<[reent]>, struct mallstats *<[stats]>);
+
+DESCRIPTION
+These functions exist only when newlib is configured with
+<<--enable-newlib-malloc-stats>>, which makes <<malloc>> and friends
+count what they do.  The counters are meant for sizing the heap of a
+program: run it once instrumented, then look at the peak figures.
+
+<<mallstats>> fills in <[stats]> with the counters collected since
+start-up.  <<nmalloc>>, <<nfree>> and <<nfail>> count blocks handed out,
+blocks given back and allocation requests that could not be met.  A
+<<realloc>> that moves a block counts as a new block and the old one
+given back; one that resizes the block in place only changes
+<<inuse>>, so <<nmalloc>> never falls behind <<nfree>>.  <<nrealloc>>
+counts calls to <<realloc>> on an existing block.  <<requested>> and
+<<granted>> total the bytes asked for and the chunk bytes handed out,
+so their ratio is the allocator overhead.
+<<inuse>> is the size of the chunks currently allocated and
+<<peak_inuse>> its high-water mark; <<heap>> and <<peak_heap>> are the
+same for the memory obtained with <<sbrk>>.  <<free_chunks>>,
+<<free_bytes>> and <<largest_free>> describe the free lists at the time
+of the call: a <<largest_free>> well below <<free_bytes>> means the heap
+is fragmented.  <<hist>> counts allocations by requested size, in
+power-of-two classes starting at 8 bytes.
+
+<<malloc_trace>> starts recording allocation events when <[enable]> is
+nonzero and stops when it is zero.  Events go into a ring buffer of
+<<MALLOC_TRACE_EVENTS>> entries (64 unless newlib is built with
+another value); once it is full the oldest events are overwritten and
+counted in <<trace_lost>>.  <<malloc_trace_read>> moves up to <[n]>
+of the recorded events, oldest first, into <[events]>.
+
+The alternate function <<_mallstats_r>> is a reentrant version.  The
+extra argument <[reent]> is a pointer to a reentrancy structure.
+
+RETURNS
+<<mallstats>> returns zero.
+
+<<malloc_trace>> returns nonzero if tracing was enabled before the call.
+
+<<malloc_trace_read>> returns the number of events stored in
+<[events]>.
+
+PORTABILITY
+<<mallstats>>, <<malloc_trace>> and <<malloc_trace_read>> are newlib
+extensions.
+
+*/
+
+#include <_ansi.h>
+#include <reent.h>
+#include <string.h>
+#include <malloc.h>
+#include "malltrace.h"
+
+#ifdef _MALLOC_STATS
+
+#ifndef MALLOC_TRACE_EVENTS
+#define MALLOC_TRACE_EVENTS 64
+#endif
+
+static struct mallstats stats;
+
+static struct malloc_event trace_buf[MALLOC_TRACE_EVENTS];
+static size_t trace_first;
+static size_t trace_count;
+static int trace_enabled;
+
+static void
+trace (int type,
+	void *ptr,
+	size_t size)
+{
+  struct malloc_event *e;
+
+  if (!trace_enabled)
+    return;
+
+  if (trace_count == MALLOC_TRACE_EVENTS)
+    {
+      /* Full: overwrite the oldest event.  */
+      e = &trace_buf[trace_first];
+      trace_first = (trace_first + 1) % MALLOC_TRACE_EVENTS;
+      stats.trace_lost++;
+    }
+  else
+    e = &trace_buf[(trace_first + trace_count++) % MALLOC_TRACE_EVENTS];
+
+  e->type = type;
+  e->ptr = ptr;
+  e->size = size;
+}
+
+/* Power-of-two size class of a request.  Done with a loop rather than a
+   count-leading-zeros builtin, which not every target has.  */
+static int
+size_class (size_t n)
+{
+  size_t limit = 8;
+  int idx = 0;
+
+  while (n > limit && idx < MALLSTATS_NCLASSES - 1)
+    {
+      limit <<= 1;
+      idx++;
+    }
+  return idx;
+}
+
+void
+__malloc_stats_alloc (void *ptr,
+	size_t request,
+	size_t size)
+{
+  __malloc_lock (_REENT);
+  stats.nmalloc++;
+  stats.requested += request;
+  stats.granted += size;
+  stats.inuse += size;
+  if (stats.inuse > stats.peak_inuse)
+    stats.peak_inuse = stats.inuse;
+  stats.hist[size_class (request)]++;
+  trace (MALLOC_EVENT_ALLOC, ptr, size);
+  __malloc_unlock (_REENT);
+}
+
+void
+__malloc_stats_free (void *ptr,
+	size_t size)
+{
+  __malloc_lock (_REENT);
+  stats.nfree++;
+  stats.inuse -= size;
+  trace (MALLOC_EVENT_FREE, ptr, size);
+  __malloc_unlock (_REENT);
+}
+
+void
+__malloc_stats_realloc (void *ptr,
+	size_t request)
+{
+  __malloc_lock (_REENT);
+  stats.nrealloc++;
+  trace (MALLOC_EVENT_REALLOC, ptr, request);
+  __malloc_unlock (_REENT);
+}
+
+void
+__malloc_stats_resize (void *ptr,
+	size_t old_size,
+	size_t new_size)
+{
+  __malloc_lock (_REENT);
+  if (new_size > old_size)
+    stats.granted += new_size - old_size;
+  stats.inuse = stats.inuse - old_size + new_size;
+  if (stats.inuse > stats.peak_inuse)
+    stats.peak_inuse = stats.inuse;
+  trace (MALLOC_EVENT_RESIZE, ptr, new_size);
+  __malloc_unlock (_REENT);
+}
+
+void
+__malloc_stats_fail (size_t request)
+{
+  __malloc_lock (_REENT);
+  stats.nfail++;
+  trace (MALLOC_EVENT_FAIL, NULL, request);
+  __malloc_unlock (_REENT);
+}
+
+int
+_mallstats_r (struct _reent *ptr,
+	struct mallstats *s)
+{
+  struct __malloc_heap_info info;
+
+  __malloc_lock (ptr);
+  __malloc_stats_walk (ptr, &info);
+  stats.heap = info.heap;
+  if (info.peak_heap > stats.peak_heap)
+    stats.peak_heap = info.peak_heap;
+  stats.free_chunks = info.free_chunks;
+  stats.free_bytes = info.free_bytes;
+  stats.largest_free = info.largest_free;
+  memcpy (s, &stats, sizeof (*s));
+  __malloc_unlock (ptr);
+  return 0;
+}
+
+int
+malloc_trace (int enable)
+{
+  int was_enabled;
+
+  __malloc_lock (_REENT);
+  was_enabled = trace_enabled;
+  trace_enabled = enable != 0;
+  __malloc_unlock (_REENT);
+  return was_enabled;
+}
+
+size_t
+malloc_trace_read (struct malloc_event *events,
+	size_t n)
+{
+  size_t i;
+
+  __malloc_lock (_REENT);
+  for (i = 0; i < n && trace_count > 0; i++)
+    {
+      events[i] = trace_buf[trace_first];
+      trace_first = (trace_first + 1) % MALLOC_TRACE_EVENTS;
+      trace_count--;
+    }
+  __malloc_unlock (_REENT);
+  return i;
+}
+
+#ifndef _REENT_ONLY
+
+int
+mallstats (struct mallstats *s)
+{
+  return _mallstats_r (_REENT, s);
+}
+
+#endif /* ! _REENT_ONLY */
+
+#endif /* _MALLOC_STATS */
+
+#endif /* ! defined (MALLOC_PROVIDED) */
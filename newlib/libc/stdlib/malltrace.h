@@ -0,0 +1,57 @@
+/* malltrace.h -- hooks the malloc implementations call to feed the
+   statistics and trace kept by malltrace.c.
+
+   All sizes passed in are chunk sizes as the allocator sees them, so
+   that inuse tracks the heap exactly; only the request size of an
+   allocation is the caller's.  The hooks expand to nothing unless newlib
+   is configured with --enable-newlib-malloc-stats.  */
+
+#ifndef _MALLTRACE_H_
+#define _MALLTRACE_H_
+
+#include <_ansi.h>
+#include <stddef.h>
+
+#ifdef _MALLOC_STATS
+
+/* What an allocator reports about its heap and free lists.  A separate
+   structure from struct mallstats because mallocr.c has its own struct
+   mallinfo and cannot include <malloc.h>.  */
+struct __malloc_heap_info {
+  size_t heap;
+  size_t peak_heap;
+  size_t free_chunks;
+  size_t free_bytes;
+  size_t largest_free;
+};
+
+struct _reent;
+
+extern void __malloc_stats_alloc (void *, size_t, size_t);
+extern void __malloc_stats_free (void *, size_t);
+extern void __malloc_stats_realloc (void *, size_t);
+extern void __malloc_stats_resize (void *, size_t, size_t);
+extern void __malloc_stats_fail (size_t);
+
+/* Provided by each allocator.  */
+extern void __malloc_stats_walk (struct _reent *, struct __malloc_heap_info *);
+
+#define MALLOC_STATS_ALLOC(ptr, request, size) \
+  __malloc_stats_alloc (ptr, request, size)
+#define MALLOC_STATS_FREE(ptr, size) __malloc_stats_free (ptr, size)
+#define MALLOC_STATS_REALLOC(ptr, request) __malloc_stats_realloc (ptr, request)
+#define MALLOC_STATS_RESIZE(ptr, old_size, new_size) \
+  __malloc_stats_resize (ptr, old_size, new_size)
+#define MALLOC_STATS_FAIL(request) __malloc_stats_fail (request)
+
+#else
+
+#define MALLOC_STATS_ALLOC(ptr, request, size)
+#define MALLOC_STATS_FREE(ptr, size)
+#define MALLOC_STATS_REALLOC(ptr, request)
+#define MALLOC_STATS_RESIZE(ptr, old_size, new_size)
+#define MALLOC_STATS_FAIL(request)
+
+#endif /* _MALLOC_STATS */
+
+#endif /* _MALLTRACE_H_ */
@@ -69,6 +69,7 @@ PORTABILITY
 #include <stdlib.h>
 #include <stdio.h>
 #include <errno.h>
+#include "local.h"
 
 size_t
 _mbsnrtowcs_r (struct _reent *r,
@@ -83,6 +84,9 @@ _mbsnrtowcs_r (struct _reent *r,
   size_t max;
   size_t count = 0;
   int bytes;
+#ifdef __UTF8_RUNS
+  int utf8 = __MBTOWC == __utf8_mbtowc;
+#endif
 
 #ifdef _MB_CAPABLE
   if (ps == NULL)
@@ -104,6 +108,21 @@ _mbsnrtowcs_r (struct _reent *r,
   max = len;
   while (len > 0)
     {
+#ifdef __UTF8_RUNS
+      if (utf8 && ps->__count == 0)
+	{
+	  const char *start = *src;
+	  size_t n = __utf8_mbsrun (ptr, src, nms, len);
+
+	  nms -= *src - start;
+	  count += n;
+	  len -= n;
+	  if (dst != NULL)
+	    ptr += n;
+	  if (len == 0)
+	    break;
+	}
+#endif
       bytes = _mbrtowc_r (r, ptr, *src, nms, ps);
       if (bytes > 0)
 	{
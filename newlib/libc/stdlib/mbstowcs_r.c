@@ -10,13 +10,31 @@ _mbstowcs_r (struct _reent *r,
         mbstate_t     *state)
 {
   size_t ret = 0;
-  char *t = (char *)s;
+  const char *t = s;
   int bytes;
+#ifdef __UTF8_RUNS
+  int utf8 = __MBTOWC == __utf8_mbtowc;
+  size_t n1;
+#endif
 
   if (!pwcs)
     n = (size_t) 1; /* Value doesn't matter as long as it's not 0. */
   while (n > 0)
     {
+#ifdef __UTF8_RUNS
+      if (utf8 && state->__count == 0)
+	{
+	  n1 = __utf8_mbsrun (pwcs, &t, (size_t) -1, pwcs ? n : (size_t) -1);
+	  ret += n1;
+	  if (pwcs)
+	    {
+	      pwcs += n1;
+	      n -= n1;
+	      if (n == 0)
+		break;
+	    }
+	}
+#endif
       bytes = __MBTOWC (r, pwcs, t, MB_CUR_MAX, state);
       if (bytes < 0)
 	{
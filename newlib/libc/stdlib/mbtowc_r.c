@@ -723,6 +723,94 @@ __utf8_mbtowc (struct _reent *r,
   return -1;
 }
 
+#ifdef __UTF8_RUNS
+#define LBLOCKSIZE   (sizeof (long))
+#define UNALIGNED(X) ((long)(X) & (LBLOCKSIZE - 1))
+/* Nonzero if X (an unsigned long) has a null or a non-ASCII byte.  */
+#define NOTASCII(X)  ((((X) - ~0UL / 0xff) | (X)) & (~0UL / 0xff * 0x80))
+
+/* Convert the UTF-8 characters at *S, at most N bytes of them, to at
+   most LEN wide characters at PWC, or only count them if PWC is NULL.
+   Only what __utf8_mbtowc converts in one call from the initial state
+   is taken; the run stops before a null character, an invalid or
+   incomplete sequence and, with a 16-bit wchar_t, a character outside
+   the BMP.  *S is advanced past the characters converted, and their
+   number is returned.  Runs of ASCII go a word at a time.  */
+size_t
+__utf8_mbsrun (wchar_t *pwc,
+        const char   **s,
+        size_t         n,
+        size_t         len)
+{
+  const unsigned char *t = (const unsigned char *)*s;
+  size_t count = 0;
+  size_t i, k;
+  wchar_t wc;
+  int ch;
+
+  while (count < len && n > 0)
+    {
+      ch = t[0];
+      if (ch >= 0x01 && ch <= 0x7f)
+	{
+	  k = 0;
+	  if (!UNALIGNED (t))
+	    while (n - k >= LBLOCKSIZE && len - count - k >= LBLOCKSIZE
+		   && !NOTASCII (*(const unsigned long *)(t + k)))
+	      k += LBLOCKSIZE;
+	  if (k == 0)
+	    k = 1;
+	  if (pwc != NULL)
+	    for (i = 0; i < k; ++i)
+	      pwc[count + i] = t[i];
+	  t += k;
+	  n -= k;
+	  count += k;
+	  continue;
+	}
+      if (ch >= 0xc2 && ch <= 0xdf)
+	{
+	  if (n < 2 || (t[1] & 0xc0) != 0x80)
+	    break;
+	  wc = (wchar_t)((ch & 0x1f) << 6)
+	    |  (wchar_t)(t[1] & 0x3f);
+	  k = 2;
+	}
+      else if (ch >= 0xe0 && ch <= 0xef)
+	{
+	  if (n < 3 || (t[1] & 0xc0) != 0x80 || (ch == 0xe0 && t[1] < 0xa0)
+	      || (t[2] & 0xc0) != 0x80)
+	    break;
+	  wc = (wchar_t)((ch & 0x0f) << 12)
+	    |  (wchar_t)((t[1] & 0x3f) << 6)
+	    |  (wchar_t)(t[2] & 0x3f);
+	  k = 3;
+	}
+      else if (sizeof (wchar_t) > 2 && ch >= 0xf0 && ch <= 0xf4)
+	{
+	  if (n < 4 || (t[1] & 0xc0) != 0x80 || (ch == 0xf0 && t[1] < 0x90)
+	      || (ch == 0xf4 && t[1] >= 0x90)
+	      || (t[2] & 0xc0) != 0x80 || (t[3] & 0xc0) != 0x80)
+	    break;
+	  wc = (wchar_t)((ch & 0x07) << 18)
+	    |  (wchar_t)((t[1] & 0x3f) << 12)
+	    |  (wchar_t)((t[2] & 0x3f) << 6)
+	    |  (wchar_t)(t[3] & 0x3f);
+	  k = 4;
+	}
+      else
+	break;
+      if (pwc != NULL)
+	pwc[count] = wc;
+      t += k;
+      n -= k;
+      ++count;
+    }
+  *s = (const char *)t;
+  return count;
+}
+#endif /* __UTF8_RUNS */
+
 /* Cygwin defines its own doublebyte charset conversion functions 
    because the underlying OS requires wchar_t == UTF-16. */
 #ifndef  __CYGWIN__
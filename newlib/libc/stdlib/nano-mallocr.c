@@ -36,6 +36,7 @@
 #include <string.h>
 #include <errno.h>
 #include <malloc.h>
+#include "malltrace.h"
 
 #if DEBUG
 #include <assert.h>
@@ -106,6 +107,9 @@
 #define free_list __malloc_free_list
 #define sbrk_start __malloc_sbrk_start
 #define current_mallinfo __malloc_current_mallinfo
+#define free_bins __malloc_free_bins
+#define insert_chunk __malloc_insert_chunk
+#define malloc_unhooked __malloc_unhooked
 
 #define ALIGN_PTR(ptr, align) \
     (((ptr) + (align) - (intptr_t)1) & ~((align) - (intptr_t)1))
@@ -161,10 +165,32 @@ typedef struct malloc_chunk
  * won't be able to create a chunk */
 #define MALLOC_MINCHUNK (CHUNK_OFFSET + MALLOC_PADDING + MALLOC_MINSIZE)
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+/* Small chunks are kept in segregated free lists, one per chunk size in
+ * steps of MALLOC_BIN_STEP up to MALLOC_BIN_MAX, so that allocating and
+ * freeing them is a push or pop instead of a walk of free_list.  Binned
+ * chunks are not coalesced until a request would otherwise have to grow
+ * the heap, at which point they are all moved back to free_list.  */
+#define MALLOC_BINS
+#define MALLOC_BIN_STEP (8U)
+#define MALLOC_BIN_MAX (512U)
+#define MALLOC_NBINS (MALLOC_BIN_MAX / MALLOC_BIN_STEP + 1)
+#define BIN_INDEX(size) ((size) / MALLOC_BIN_STEP)
+#define IS_BIN_SIZE(size) \
+    ((size) <= MALLOC_BIN_MAX && ((size) & (MALLOC_BIN_STEP - 1)) == 0)
+
+/* Set in the size of a chunk sitting in a bin.  Chunk sizes are
+ * multiples of CHUNK_ALIGN, so the bit is otherwise always clear.  */
+#define CHUNK_BINNED (1L)
+#endif
+
 /* Forward data declarations */
 extern chunk * free_list;
 extern char * sbrk_start;
 extern struct mallinfo current_mallinfo;
+#ifdef MALLOC_BINS
+extern chunk * free_bins[MALLOC_NBINS];
+#endif
 
 /* Forward function declarations */
 extern void * nano_malloc(RARG malloc_size_t);
@@ -178,6 +204,10 @@ extern void * nano_memalign(RARG size_t align, size_t s);
 extern int nano_mallopt(RARG int parameter_number, int parameter_value);
 extern void * nano_valloc(RARG size_t s);
 extern void * nano_pvalloc(RARG size_t s);
+extern void insert_chunk(RARG chunk * p_to_free);
+#ifdef _MALLOC_STATS
+extern void * malloc_unhooked(RARG malloc_size_t);
+#endif
 
 static inline chunk * get_chunk_from_ptr(void * ptr)
 {
@@ -199,6 +229,34 @@ chunk * free_list = NULL;
 /* Starting point of memory allocated from system */
 char * sbrk_start = NULL;
 
+#ifdef MALLOC_BINS
+/* Segregated free lists of small chunks, indexed by BIN_INDEX(size) */
+chunk * free_bins[MALLOC_NBINS];
+
+/** Function flush_bins
+  * Move every binned chunk back to free_list so that it can be coalesced
+  * with its neighbours.  Return nonzero if any chunk was moved.
+  */
+static int flush_bins(RONEARG)
+{
+    chunk *r;
+    int moved = 0;
+    unsigned int i;
+
+    for (i = 0; i < MALLOC_NBINS; i++)
+    {
+        while ((r = free_bins[i]) != NULL)
+        {
+            free_bins[i] = r->next;
+            r->size &= ~CHUNK_BINNED;
+            insert_chunk(RCALL r);
+            moved = 1;
+        }
+    }
+    return moved;
+}
+#endif /* MALLOC_BINS */
+
 /** Function sbrk_aligned
   * Algorithm:
   *   Use sbrk() to obtain more memory and ensure it is CHUNK_ALIGN aligned
@@ -229,10 +287,31 @@ static void* sbrk_aligned(RARG malloc_size_t s)
     return align_p;
 }
 
+#ifdef _MALLOC_STATS
+/* With statistics enabled, nano_malloc is a wrapper that records the
+ * outcome of each request, and the allocator proper below is compiled
+ * as malloc_unhooked.  memalign calls malloc_unhooked too, so that it
+ * can record the chunk it ends up with rather than the one it trims. */
+void * nano_malloc(RARG malloc_size_t s)
+{
+    void * mem = malloc_unhooked(RCALL s);
+
+    if (mem != NULL)
+        MALLOC_STATS_ALLOC(mem, s, get_chunk_from_ptr(mem)->size);
+    else
+        MALLOC_STATS_FAIL(s);
+    return mem;
+}
+
+#undef nano_malloc
+#define nano_malloc malloc_unhooked
+#endif /* _MALLOC_STATS */
+
 /** Function nano_malloc
   * Algorithm:
-  *   Walk through the free list to find the first match. If fails to find
-  *   one, call sbrk to allocate a new chunk.
+  *   Small requests are first served from the bin of their size.
+  *   Otherwise walk through the free list to find the first match. If
+  *   fails to find one, call sbrk to allocate a new chunk.
   */
 void * nano_malloc(RARG malloc_size_t s)
 {
@@ -255,6 +334,21 @@ void * nano_malloc(RARG malloc_size_t s)
 
     MALLOC_LOCK;
 
+#ifdef MALLOC_BINS
+    if (alloc_size <= MALLOC_BIN_MAX)
+    {
+        /* Round up to the bin size so any chunk in the bin fits */
+        alloc_size = ALIGN_SIZE(alloc_size, MALLOC_BIN_STEP);
+        if ((r = free_bins[BIN_INDEX(alloc_size)]) != NULL)
+        {
+            free_bins[BIN_INDEX(alloc_size)] = r->next;
+            r->size = alloc_size;
+            goto found;
+        }
+    }
+
+retry:
+#endif
     p = free_list;
     r = p;
 
@@ -301,6 +395,13 @@ void * nano_malloc(RARG malloc_size_t s)
         r=r->next;
     }
 
+#ifdef MALLOC_BINS
+    /* Coalescing the binned chunks may give a large enough one, try that
+     * before growing the heap */
+    if (r == NULL && flush_bins(RONECALL))
+        goto retry;
+#endif
+
     /* Failed to find a appropriate chunk. Ask for more memory */
     if (r == NULL)
     {
@@ -322,7 +423,8 @@ void * nano_malloc(RARG malloc_size_t s)
                 r=r->next;
             }
 
-            if ((char *)p + p->size == (char *)_SBRK_R(RCALL 0))
+            if (p != NULL
+                && (char *)p + p->size == (char *)_SBRK_R(RCALL 0))
             {
                /* The last free item has the heap end as neighbour.
                 * Let's ask for a smaller amount and merge */
@@ -356,6 +458,9 @@ void * nano_malloc(RARG malloc_size_t s)
             r->size = alloc_size;
         }
     }
+#ifdef MALLOC_BINS
+found:
+#endif
     MALLOC_UNLOCK;
 
     ptr = (char *)r + CHUNK_OFFSET;
@@ -389,31 +494,21 @@ void * nano_malloc(RARG malloc_size_t s)
 #ifdef DEFINE_FREE
 #define MALLOC_CHECK_DOUBLE_FREE
 
-/** Function nano_free
-  * Implementation of libc free.
-  * Algorithm:
-  *  Maintain a global free chunk single link list, headed by global
-  *  variable free_list.
-  *  When free, insert the to-be-freed chunk into free list. The place to
-  *  insert should make sure all chunks are sorted by address from low to
-  *  high.  Then merge with neighbor chunks if adjacent.
+/** Function insert_chunk
+  * Insert a chunk into the global free list, headed by global variable
+  * free_list.  The place to insert should make sure all chunks are
+  * sorted by address from low to high.  Then merge with neighbor chunks
+  * if adjacent.  Must be called with the malloc lock held.
   */
-void nano_free (RARG void * free_p)
+void insert_chunk(RARG chunk * p_to_free)
 {
-    chunk * p_to_free;
     chunk * p, * q;
 
-    if (free_p == NULL) return;
-
-    p_to_free = get_chunk_from_ptr(free_p);
-
-    MALLOC_LOCK;
     if (free_list == NULL)
     {
         /* Set first free list element */
         p_to_free->next = free_list;
         free_list = p_to_free;
-        MALLOC_UNLOCK;
         return;
     }
 
@@ -432,7 +527,6 @@ void nano_free (RARG void * free_p)
             p_to_free->next = free_list;
         }
         free_list = p_to_free;
-        MALLOC_UNLOCK;
         return;
     }
 
@@ -465,7 +559,6 @@ void nano_free (RARG void * free_p)
     {
         /* Report double free fault */
         RERRNO = ENOMEM;
-        MALLOC_UNLOCK;
         return;
     }
 #endif
@@ -484,6 +577,46 @@ void nano_free (RARG void * free_p)
         p_to_free->next = q;
         p->next = p_to_free;
     }
+}
+
+/** Function nano_free
+  * Implementation of libc free.
+  * Algorithm:
+  *  Push small chunks onto the bin of their size, and insert any other
+  *  chunk into the address ordered free list with insert_chunk.
+  */
+void nano_free (RARG void * free_p)
+{
+    chunk * p_to_free;
+
+    if (free_p == NULL) return;
+
+    p_to_free = get_chunk_from_ptr(free_p);
+
+    MALLOC_LOCK;
+#ifdef MALLOC_BINS
+#ifdef MALLOC_CHECK_DOUBLE_FREE
+    if (p_to_free->size & CHUNK_BINNED)
+    {
+        /* Report double free fault */
+        RERRNO = ENOMEM;
+        MALLOC_UNLOCK;
+        return;
+    }
+#endif
+#endif
+    MALLOC_STATS_FREE(free_p, p_to_free->size);
+#ifdef MALLOC_BINS
+    if (IS_BIN_SIZE(p_to_free->size))
+    {
+        p_to_free->next = free_bins[BIN_INDEX(p_to_free->size)];
+        free_bins[BIN_INDEX(p_to_free->size)] = p_to_free;
+        p_to_free->size |= CHUNK_BINNED;
+        MALLOC_UNLOCK;
+        return;
+    }
+#endif
+    insert_chunk(RCALL p_to_free);
     MALLOC_UNLOCK;
 }
 #endif /* DEFINE_FREE */
@@ -516,12 +649,16 @@ void * nano_calloc(RARG malloc_size_t n, malloc_size_t elem)
 
 #ifdef DEFINE_REALLOC
 /* Function nano_realloc
- * Implement realloc by malloc + memcpy */
+ * Resize in place where possible: a shrinking chunk gives its tail back
+ * to the free list, and a growing chunk takes over the free chunk that
+ * follows it or extends the heap if it is the last one.  Otherwise
+ * fall back to malloc + memcpy + free. */
 void * nano_realloc(RARG void * ptr, malloc_size_t size)
 {
     void * mem;
-    chunk * p_to_realloc;
-    malloc_size_t old_size;
+    chunk * c, * p, * q, * tail;
+    char * end;
+    malloc_size_t old_size, need, grow;
 
     if (ptr == NULL) return nano_malloc(RCALL size);
 
@@ -531,10 +668,98 @@ void * nano_realloc(RARG void * ptr, malloc_size_t size)
         return NULL;
     }
 
+    MALLOC_STATS_REALLOC(ptr, size);
+
     old_size = nano_malloc_usable_size(RCALL ptr);
     if (size <= old_size && (old_size >> 1) < size)
       return ptr;
 
+    if (size >= MAX_ALLOC_SIZE)
+    {
+        RERRNO = ENOMEM;
+        return NULL;
+    }
+
+    /* Chunk size needed to hold size bytes from ptr, padding included */
+    c = get_chunk_from_ptr(ptr);
+    need = ALIGN_SIZE(size, CHUNK_ALIGN) + ((char *)ptr - (char *)c);
+    need = MAX(need, MALLOC_MINCHUNK);
+
+    if (need <= (malloc_size_t)c->size)
+    {
+        /* Shrink.  Split off the tail if it can make a chunk */
+        if (c->size - need >= MALLOC_MINCHUNK)
+        {
+            /* The tail was never allocated on its own, so it goes back
+             * to the free list without being counted as a free */
+            MALLOC_LOCK;
+            MALLOC_STATS_RESIZE(ptr, c->size, need);
+            tail = (chunk *)((char *)c + need);
+            tail->size = c->size - need;
+            c->size = need;
+            insert_chunk(RCALL tail);
+            MALLOC_UNLOCK;
+        }
+        return ptr;
+    }
+
+    MALLOC_LOCK;
+
+    /* Find the free chunk right after c, if any */
+    end = (char *)c + c->size;
+    for (p = NULL, q = free_list; q && (char *)q < end; p = q, q = q->next)
+        ;
+    if (q != NULL && (char *)q != end)
+        q = NULL;
+
+    if (q != NULL && c->size + q->size >= need)
+    {
+        /* Take what is needed from the next chunk and leave the rest
+         * in its place in the free list */
+        grow = need - c->size;
+        if (q->size - grow >= MALLOC_MINCHUNK)
+        {
+            /* The new head may overlap q's next field, so read it first */
+            chunk * next = q->next;
+            long rem = q->size - grow;
+            tail = (chunk *)((char *)q + grow);
+            tail->size = rem;
+            tail->next = next;
+        }
+        else
+        {
+            need = c->size + q->size;
+            tail = q->next;
+        }
+        if (p == NULL) free_list = tail;
+        else p->next = tail;
+        MALLOC_STATS_RESIZE(ptr, c->size, need);
+        c->size = need;
+        MALLOC_UNLOCK;
+        return ptr;
+    }
+
+    /* c, or the free chunk after it, is the last one before the heap end.
+     * Ask sbrk for just the difference */
+    if ((q ? (char *)q + q->size : end) == (char *)_SBRK_R(RCALL 0))
+    {
+        grow = need - c->size - (q ? q->size : 0);
+        if (_SBRK_R(RCALL grow) != (void *)-1)
+        {
+            if (q != NULL)
+            {
+                if (p == NULL) free_list = q->next;
+                else p->next = q->next;
+            }
+            MALLOC_STATS_RESIZE(ptr, c->size, need);
+            c->size = need;
+            MALLOC_UNLOCK;
+            return ptr;
+        }
+    }
+
+    MALLOC_UNLOCK;
+
     mem = nano_malloc(RCALL size);
     if (mem != NULL)
     {
@@ -572,6 +797,16 @@ struct mallinfo nano_mallinfo(RONEARG)
     for (pf = free_list; pf; pf = pf->next)
         free_size += pf->size;
 
+#ifdef MALLOC_BINS
+    {
+        unsigned int i;
+
+        for (i = 0; i < MALLOC_NBINS; i++)
+            for (pf = free_bins[i]; pf; pf = pf->next)
+                free_size += pf->size & ~CHUNK_BINNED;
+    }
+#endif
+
     current_mallinfo.arena = total_size;
     current_mallinfo.fordblks = free_size;
     current_mallinfo.uordblks = total_size - free_size;
@@ -579,6 +814,49 @@ struct mallinfo nano_mallinfo(RONEARG)
     MALLOC_UNLOCK;
     return current_mallinfo;
 }
+
+#ifdef _MALLOC_STATS
+/* Report the heap and free lists for mallstats.  The heap never shrinks,
+ * so its current size is also its peak. */
+void __malloc_stats_walk(struct _reent * reent_ptr,
+                         struct __malloc_heap_info * info)
+{
+    chunk * pf;
+
+    MALLOC_LOCK;
+
+    info->heap = sbrk_start ? (char *)_SBRK_R(RCALL 0) - sbrk_start : 0;
+    info->peak_heap = info->heap;
+    info->free_chunks = 0;
+    info->free_bytes = 0;
+    info->largest_free = 0;
+
+    for (pf = free_list; pf; pf = pf->next)
+    {
+        info->free_chunks++;
+        info->free_bytes += pf->size;
+        info->largest_free = MAX(info->largest_free, (malloc_size_t)pf->size);
+    }
+
+#ifdef MALLOC_BINS
+    {
+        unsigned int i;
+        malloc_size_t size;
+
+        for (i = 0; i < MALLOC_NBINS; i++)
+            for (pf = free_bins[i]; pf; pf = pf->next)
+            {
+                size = pf->size & ~CHUNK_BINNED;
+                info->free_chunks++;
+                info->free_bytes += size;
+                info->largest_free = MAX(info->largest_free, size);
+            }
+    }
+#endif
+
+    MALLOC_UNLOCK;
+}
+#endif /* _MALLOC_STATS */
 #endif /* DEFINE_MALLINFO */
 
 #ifdef DEFINE_MALLOC_STATS
@@ -650,8 +928,17 @@ void * nano_memalign(RARG size_t align, size_t s)
     }
     size_with_padding = ma_size + (align - MALLOC_ALIGN);
 
+#ifdef _MALLOC_STATS
+    allocated = malloc_unhooked(RCALL size_with_padding);
+    if (allocated == NULL)
+    {
+        MALLOC_STATS_FAIL(s);
+        return NULL;
+    }
+#else
     allocated = nano_malloc(RCALL size_with_padding);
     if (allocated == NULL) return NULL;
+#endif
 
     chunk_p = get_chunk_from_ptr(allocated);
     aligned_p = (char *)ALIGN_PTR(
@@ -668,7 +955,9 @@ void * nano_memalign(RARG size_t align, size_t s)
             chunk_p = (chunk *)((char *)chunk_p + offset);
             chunk_p->size = front_chunk->size - offset;
             front_chunk->size = offset;
-            nano_free(RCALL (char *)front_chunk + CHUNK_OFFSET);
+            MALLOC_LOCK;
+            insert_chunk(RCALL front_chunk);
+            MALLOC_UNLOCK;
         }
         else
         {
@@ -688,8 +977,11 @@ void * nano_memalign(RARG size_t align, size_t s)
         chunk * tail_chunk = (chunk *)(aligned_p + ma_size);
         chunk_p->size = aligned_p + ma_size - (char *)chunk_p;
         tail_chunk->size = size_allocated - chunk_p->size;
-        nano_free(RCALL (char *)tail_chunk + CHUNK_OFFSET);
+        MALLOC_LOCK;
+        insert_chunk(RCALL tail_chunk);
+        MALLOC_UNLOCK;
     }
+    MALLOC_STATS_ALLOC(aligned_p, s, chunk_p->size);
     return aligned_p;
 }
 #endif /* DEFINE_MEMALIGN */
@@ -135,6 +135,7 @@ THIS SOFTWARE.
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include "mprec.h"
 #include "gdtoa.h"
 #include "../locale/setlocale.h"
@@ -239,6 +240,343 @@ ULtod (__ULong *L,
 }
 #endif /* !NO_HEX_FP */
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__) \
+    && defined(IEEE_Arith) && !defined(_DOUBLE_IS_32BITS) \
+    && !defined(Honor_FLT_ROUNDS) && !defined(SET_INEXACT)
+#define Fast_Path_Lemire
+#endif
+
+#ifdef Fast_Path_Lemire /*{*/
+/* Eisel and Lemire's conversion: the first 64 significant bits of the
+ * decimal mantissa times a 128-bit approximation of the power of ten
+ * almost always pins down the correctly rounded double.  When the
+ * product is too close to a rounding boundary to tell, or the result
+ * is subnormal or overflows, lemire() gives up and the Bigint loop
+ * below decides.  The powers are truncated to 128 bits and cover
+ * 10^LEMIRE_MIN_EXP through 10^LEMIRE_MAX_EXP, which is where nearly
+ * all decimal input lands; other exponents take the usual path.
+ */
+
+#define LEMIRE_MIN_EXP	-100
+#define LEMIRE_MAX_EXP	100
+
+static const uint64_t pow10_128[LEMIRE_MAX_EXP - LEMIRE_MIN_EXP + 1][2] = {
+  { 0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL },
+  { 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL },
+  { 0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL },
+  { 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL },
+  { 0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL },
+  { 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL },
+  { 0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL },
+  { 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL },
+  { 0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL },
+  { 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL },
+  { 0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL },
+  { 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL },
+  { 0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL },
+  { 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL },
+  { 0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL },
+  { 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL },
+  { 0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL },
+  { 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL },
+  { 0xc24452da229b021bULL, 0xfbe85badce996168ULL },
+  { 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL },
+  { 0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL },
+  { 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL },
+  { 0xed246723473e3813ULL, 0x290123e9aab23b68ULL },
+  { 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL },
+  { 0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL },
+  { 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL },
+  { 0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL },
+  { 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL },
+  { 0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL },
+  { 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL },
+  { 0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL },
+  { 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL },
+  { 0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL },
+  { 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL },
+  { 0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL },
+  { 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL },
+  { 0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL },
+  { 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL },
+  { 0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL },
+  { 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL },
+  { 0xcdb02555653131b6ULL, 0x3792f412cb06794dULL },
+  { 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL },
+  { 0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL },
+  { 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL },
+  { 0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL },
+  { 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL },
+  { 0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL },
+  { 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL },
+  { 0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL },
+  { 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL },
+  { 0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL },
+  { 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL },
+  { 0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL },
+  { 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL },
+  { 0x9226712162ab070dULL, 0xcab3961304ca70e8ULL },
+  { 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL },
+  { 0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL },
+  { 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL },
+  { 0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL },
+  { 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL },
+  { 0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL },
+  { 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL },
+  { 0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL },
+  { 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL },
+  { 0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL },
+  { 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL },
+  { 0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL },
+  { 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL },
+  { 0xcfb11ead453994baULL, 0x67de18eda5814af2ULL },
+  { 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL },
+  { 0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL },
+  { 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL },
+  { 0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL },
+  { 0x9e74d1b791e07e48ULL, 0x775ea264cf55347dULL },
+  { 0xc612062576589ddaULL, 0x95364afe032a819dULL },
+  { 0xf79687aed3eec551ULL, 0x3a83ddbd83f52204ULL },
+  { 0x9abe14cd44753b52ULL, 0xc4926a9672793542ULL },
+  { 0xc16d9a0095928a27ULL, 0x75b7053c0f178293ULL },
+  { 0xf1c90080baf72cb1ULL, 0x5324c68b12dd6338ULL },
+  { 0x971da05074da7beeULL, 0xd3f6fc16ebca5e03ULL },
+  { 0xbce5086492111aeaULL, 0x88f4bb1ca6bcf584ULL },
+  { 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e5ULL },
+  { 0x9392ee8e921d5d07ULL, 0x3aff322e62439fcfULL },
+  { 0xb877aa3236a4b449ULL, 0x09befeb9fad487c2ULL },
+  { 0xe69594bec44de15bULL, 0x4c2ebe687989a9b3ULL },
+  { 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a10ULL },
+  { 0xb424dc35095cd80fULL, 0x538484c19ef38c94ULL },
+  { 0xe12e13424bb40e13ULL, 0x2865a5f206b06fb9ULL },
+  { 0x8cbccc096f5088cbULL, 0xf93f87b7442e45d3ULL },
+  { 0xafebff0bcb24aafeULL, 0xf78f69a51539d748ULL },
+  { 0xdbe6fecebdedd5beULL, 0xb573440e5a884d1bULL },
+  { 0x89705f4136b4a597ULL, 0x31680a88f8953030ULL },
+  { 0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3dULL },
+  { 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4cULL },
+  { 0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b10fULL },
+  { 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d53ULL },
+  { 0xd1b71758e219652bULL, 0xd3c36113404ea4a8ULL },
+  { 0x83126e978d4fdf3bULL, 0x645a1cac083126e9ULL },
+  { 0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a3ULL },
+  { 0xccccccccccccccccULL, 0xccccccccccccccccULL },
+  { 0x8000000000000000ULL, 0x0000000000000000ULL },
+  { 0xa000000000000000ULL, 0x0000000000000000ULL },
+  { 0xc800000000000000ULL, 0x0000000000000000ULL },
+  { 0xfa00000000000000ULL, 0x0000000000000000ULL },
+  { 0x9c40000000000000ULL, 0x0000000000000000ULL },
+  { 0xc350000000000000ULL, 0x0000000000000000ULL },
+  { 0xf424000000000000ULL, 0x0000000000000000ULL },
+  { 0x9896800000000000ULL, 0x0000000000000000ULL },
+  { 0xbebc200000000000ULL, 0x0000000000000000ULL },
+  { 0xee6b280000000000ULL, 0x0000000000000000ULL },
+  { 0x9502f90000000000ULL, 0x0000000000000000ULL },
+  { 0xba43b74000000000ULL, 0x0000000000000000ULL },
+  { 0xe8d4a51000000000ULL, 0x0000000000000000ULL },
+  { 0x9184e72a00000000ULL, 0x0000000000000000ULL },
+  { 0xb5e620f480000000ULL, 0x0000000000000000ULL },
+  { 0xe35fa931a0000000ULL, 0x0000000000000000ULL },
+  { 0x8e1bc9bf04000000ULL, 0x0000000000000000ULL },
+  { 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL },
+  { 0xde0b6b3a76400000ULL, 0x0000000000000000ULL },
+  { 0x8ac7230489e80000ULL, 0x0000000000000000ULL },
+  { 0xad78ebc5ac620000ULL, 0x0000000000000000ULL },
+  { 0xd8d726b7177a8000ULL, 0x0000000000000000ULL },
+  { 0x878678326eac9000ULL, 0x0000000000000000ULL },
+  { 0xa968163f0a57b400ULL, 0x0000000000000000ULL },
+  { 0xd3c21bcecceda100ULL, 0x0000000000000000ULL },
+  { 0x84595161401484a0ULL, 0x0000000000000000ULL },
+  { 0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL },
+  { 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL },
+  { 0x813f3978f8940984ULL, 0x4000000000000000ULL },
+  { 0xa18f07d736b90be5ULL, 0x5000000000000000ULL },
+  { 0xc9f2c9cd04674edeULL, 0xa400000000000000ULL },
+  { 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL },
+  { 0x9dc5ada82b70b59dULL, 0xf020000000000000ULL },
+  { 0xc5371912364ce305ULL, 0x6c28000000000000ULL },
+  { 0xf684df56c3e01bc6ULL, 0xc732000000000000ULL },
+  { 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL },
+  { 0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL },
+  { 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL },
+  { 0x96769950b50d88f4ULL, 0x1314448000000000ULL },
+  { 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL },
+  { 0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL },
+  { 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL },
+  { 0xb7abc627050305adULL, 0xf14a3d9e40000000ULL },
+  { 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL },
+  { 0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL },
+  { 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL },
+  { 0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL },
+  { 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL },
+  { 0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL },
+  { 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL },
+  { 0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL },
+  { 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL },
+  { 0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL },
+  { 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL },
+  { 0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL },
+  { 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL },
+  { 0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL },
+  { 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL },
+  { 0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL },
+  { 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL },
+  { 0x9f4f2726179a2245ULL, 0x01d762422c946590ULL },
+  { 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL },
+  { 0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL },
+  { 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL },
+  { 0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL },
+  { 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL },
+  { 0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL },
+  { 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL },
+  { 0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL },
+  { 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL },
+  { 0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL },
+  { 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL },
+  { 0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL },
+  { 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL },
+  { 0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL },
+  { 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL },
+  { 0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL },
+  { 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL },
+  { 0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL },
+  { 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL },
+  { 0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL },
+  { 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL },
+  { 0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL },
+  { 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL },
+  { 0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL },
+  { 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL },
+  { 0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL },
+  { 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL },
+  { 0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL },
+  { 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL },
+  { 0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL },
+  { 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL },
+  { 0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL },
+  { 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL },
+  { 0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL },
+  { 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL },
+  { 0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL },
+  { 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL },
+  { 0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL },
+  { 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL },
+  { 0x924d692ca61be758ULL, 0x593c2626705f9c56ULL },
+};
+
+/* The 128-bit product of A and B, returning the high half.  */
+static uint64_t
+mul64x64 (uint64_t a,
+	uint64_t b,
+	uint64_t *lo)
+{
+	uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+	uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+	uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+	uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+
+	*lo = (mid << 32) | (uint32_t)p00;
+	return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+/* Set *RV to MAN * 10**EXP10 and return 1, or return 0 if that cannot
+ * be done cheaply.  MAN must not be zero.
+ */
+static int
+lemire (uint64_t man,
+	int exp10,
+	U *rv)
+{
+	const uint64_t *pow;
+	uint64_t xhi, xlo, yhi, ylo, mhi, mlo, mant, exp2;
+	int clz = 0;
+	U r;
+
+	if (exp10 < LEMIRE_MIN_EXP || exp10 > LEMIRE_MAX_EXP)
+		return 0;
+	pow = pow10_128[exp10 - LEMIRE_MIN_EXP];
+
+	/* Normalize without a count-leading-zeros instruction. */
+	if (!(man >> 32)) { man <<= 32; clz += 32; }
+	if (!(man >> 48)) { man <<= 16; clz += 16; }
+	if (!(man >> 56)) { man <<= 8; clz += 8; }
+	if (!(man >> 60)) { man <<= 4; clz += 4; }
+	if (!(man >> 62)) { man <<= 2; clz += 2; }
+	if (!(man >> 63)) { man <<= 1; clz += 1; }
+	/* 217706 / 2^16 is log2(10). */
+	exp2 = (uint64_t)(((217706 * exp10) >> 16) + 64 + 1023) - clz;
+
+	xhi = mul64x64 (man, pow[0], &xlo);
+	if ((xhi & 0x1ff) == 0x1ff && xlo + man < man) {
+		/* The low half of the power may carry into the bits that
+		 * decide the rounding; bring it in.
+		 */
+		yhi = mul64x64 (man, pow[1], &ylo);
+		mhi = xhi;
+		mlo = xlo + yhi;
+		if (mlo < xlo)
+			mhi++;
+		if ((mhi & 0x1ff) == 0x1ff && mlo + 1 == 0 && ylo + man < man)
+			return 0;
+		xhi = mhi;
+		xlo = mlo;
+	}
+
+	/* Keep 54 bits, then round to 53 unless exactly half way. */
+	mant = xhi >> ((xhi >> 63) + 9);
+	exp2 -= 1 ^ (xhi >> 63);
+	if (xlo == 0 && (xhi & 0x1ff) == 0 && (mant & 3) == 1)
+		return 0;
+	mant += mant & 1;
+	mant >>= 1;
+	if (mant >> 53) {
+		mant >>= 1;
+		exp2++;
+	}
+	/* Subnormal, infinite or out of range. */
+	if (exp2 - 1 >= 0x7ff - 1)
+		return 0;
+
+	dword0(r) = (__ULong)(exp2 << 20) | ((__ULong)(mant >> 32) & 0xfffff);
+	dword1(r) = (__ULong)mant;
+	*rv = r;
+	return 1;
+}
+
+/* Try lemire() on the ND significant digits at S0: ND0 of them, then a
+ * decimal point DEC_LEN characters long, then the rest, all scaled by
+ * 10**E.  Only the first 19 digits fit in 64 bits; when there are more
+ * the answer stands only if rounding the truncated mantissa both down
+ * and up gives the same double.
+ */
+static int
+strtod_fast (const char *s0,
+	int nd0,
+	int nd,
+	int dec_len,
+	int e,
+	U *rv)
+{
+	uint64_t man = 0;
+	U r, r1;
+	int i, n;
+
+	n = nd < 19 ? nd : 19;
+	for (i = 0; i < n; i++, s0++) {
+		if (i == nd0)
+			s0 += dec_len;
+		man = 10 * man + (*s0 - '0');
+		}
+	if (!lemire (man, e + nd - n, &r))
+		return 0;
+	if (nd > n && (!lemire (man + 1, e + nd - n, &r1)
+		       || dword0(r1) != dword0(r) || dword1(r1) != dword1(r)))
+		return 0;
+	*rv = r;
+	return 1;
+}
+#endif /*}*/
+
 double
 _strtod_l (struct _reent *ptr, const char *__restrict s00, char **__restrict se,
 	   locale_t loc)
@@ -351,7 +689,7 @@ _strtod_l (struct _reent *ptr, const char *__restrict s00, char **__restrict se,
 	for(nd = nf = 0; (c = *s) >= '0' && c <= '9'; nd++, s++)
 		if (nd < 9)
 			y = 10*y + c - '0';
-		else
+		else if (nd < DBL_DIG + 1)
 			z = 10*z + c - '0';
 	nd0 = nd;
 	if (strncmp (s, decimal_point, dec_len) == 0)
@@ -564,6 +902,10 @@ _strtod_l (struct _reent *ptr, const char *__restrict s00, char **__restrict se,
 			}
 #endif
 		}
+#ifdef Fast_Path_Lemire
+	if (Flt_Rounds == 1 && strtod_fast (s0, nd0, nd, dec_len, e, &rv))
+		goto ret;
+#endif
 	e1 += nd - k;
 
 #ifdef IEEE_Arith
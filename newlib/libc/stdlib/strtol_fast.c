@@ -0,0 +1,79 @@
+/* strtol_fast.c -- common case of the strtol family.
+
+   Most numbers handed to strtol and friends are plain decimal or
+   hexadecimal digit strings, perhaps with a sign, that fit comfortably
+   in the result.  __strtou64_fast handles exactly those in a single
+   loop with no per-digit overflow check: 19 decimal or 16 hexadecimal
+   digits always fit in 64 bits, so the length of the run alone says
+   whether the value is exact.  Anything else -- leading white space, a
+   0x prefix, an octal base, a run that may not fit -- is left to the
+   caller's general loop.  */
+
+#include <_ansi.h>
+#include <stdlib.h>
+#include "local.h"
+
+#define IS_DIGIT(c)	((unsigned) ((c) - '0') < 10)
+#define IS_XDIGIT(c)	(IS_DIGIT (c) | ((unsigned) (((c) | 0x20) - 'a') < 6))
+/* The value of hexadecimal digit C, without a branch.  */
+#define XDIGIT_VALUE(c)	(((c) & 0x0f) + ((c) >> 6) * 9)
+
+const char *
+__strtou64_fast (const char *nptr,
+	int base,
+	uint64_t *valp,
+	int *negp)
+{
+  const unsigned char *s = (const unsigned char *) nptr;
+  const unsigned char *digits;
+  uint64_t acc = 0;
+
+  *negp = 0;
+  if (*s == '-')
+    {
+      *negp = 1;
+      s++;
+    }
+  else if (*s == '+')
+    s++;
+
+  /* Base 0 is decimal unless it starts with 0, and hexadecimal input
+     with a 0x prefix goes the long way.  */
+  if (base == 0)
+    {
+      if (*s < '1' || *s > '9')
+	return NULL;
+      base = 10;
+    }
+  else if (base == 16)
+    {
+      if (s[0] == '0' && (s[1] | 0x20) == 'x')
+	return NULL;
+    }
+  else if (base != 10)
+    return NULL;
+
+  digits = s;
+  if (base == 10)
+    {
+      while (IS_DIGIT (*s))
+	acc = acc * 10 + (*s++ - '0');
+      if (s - digits > 19)
+	return NULL;
+    }
+  else
+    {
+      while (IS_XDIGIT (*s))
+	{
+	  acc = (acc << 4) | XDIGIT_VALUE (*s);
+	  s++;
+	}
+      if (s - digits > 16)
+	return NULL;
+    }
+  if (s == digits)
+    return NULL;
+
+  *valp = acc;
+  return (const char *) s;
+}
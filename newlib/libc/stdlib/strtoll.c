@@ -124,6 +124,7 @@ No supporting OS subroutines are required.
 #include <stdlib.h>
 #include <reent.h>
 #include "../locale/setlocale.h"
+#include "local.h"
 
 /*
  * Convert a string to a long long integer.
@@ -138,6 +139,26 @@ _strtoll_l (struct _reent *rptr, const char *__restrict nptr,
 	register unsigned long long cutoff;
 	register int neg = 0, any, cutlim;
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+	/*
+	 * Plain decimal or hex digits that are known to fit need none
+	 * of the checks below.
+	 */
+	{
+		const char *end;
+		uint64_t val;
+		int fneg;
+
+		end = __strtou64_fast (nptr, base, &val, &fneg);
+		if (end != NULL && val <= (fneg ? -(unsigned long long)LONG_LONG_MIN : LONG_LONG_MAX)) {
+			acc = val;
+			if (endptr != 0)
+				*endptr = (char *) end;
+			return (fneg ? -acc : acc);
+		}
+	}
+#endif
+
 	/*
 	 * Skip white space and pick up leading +/- sign if any.
 	 * If base is 0, allow 0x for hex and 0 for octal, else
@@ -122,6 +122,7 @@ PORTABILITY
 #include <stdlib.h>
 #include <reent.h>
 #include "../locale/setlocale.h"
+#include "local.h"
 
 /*
  * Convert a string to an unsigned long integer.
@@ -136,6 +137,26 @@ _strtoul_l (struct _reent *rptr, const char *__restrict nptr,
 	register unsigned long cutoff;
 	register int neg = 0, any, cutlim;
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+	/*
+	 * Plain decimal or hex digits that are known to fit need none
+	 * of the checks below.
+	 */
+	{
+		const char *end;
+		uint64_t val;
+		int fneg;
+
+		end = __strtou64_fast (nptr, base, &val, &fneg);
+		if (end != NULL && val <= ULONG_MAX) {
+			acc = val;
+			if (endptr != 0)
+				*endptr = (char *) end;
+			return (fneg ? -acc : acc);
+		}
+	}
+#endif
+
 	/*
 	 * See strtol for comments as to the logic used.
 	 */
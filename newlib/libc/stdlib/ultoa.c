@@ -0,0 +1,52 @@
+/*
+FUNCTION
+<<ultoa>>---unsigned long to string
+
+INDEX
+	ultoa
+
+SYNOPSIS
+	#include <stdlib.h>
+	char *ultoa(unsigned long <[value]>, char *<[str]>, int <[base]>);
+	char *__ultoa(unsigned long <[value]>, char *<[str]>, int <[base]>);
+
+DESCRIPTION
+<<ultoa>> converts the unsigned long <[value]> to a null-terminated string
+using the specified base, which must be between 2 and 36, inclusive.
+<[str]> should be an array long enough to contain the converted
+value, which in the worst case is sizeof(long)*8+1 bytes.
+
+RETURNS
+A pointer to the string, <[str]>, or NULL if <[base]> is invalid.
+
+PORTABILITY
+<<ultoa>> is non-ANSI.
+
+No supporting OS subroutine calls are required.
+*/
+
+#include <stdlib.h>
+#include "local.h"
+
+char *
+__ultoa (unsigned long value,
+        char *str,
+        int base)
+{
+  /* Check base is supported. */
+  if ((base < 2) || (base > 36))
+    {
+      str[0] = '\0';
+      return NULL;
+    }
+
+  return __ulltoa_base (value, str, base);
+}
+
+char *
+ultoa (unsigned long value,
+        char *str,
+        int base)
+{
+  return __ultoa (value, str, base);
+}
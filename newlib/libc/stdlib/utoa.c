@@ -26,43 +26,21 @@ No supporting OS subroutine calls are required.
 */
 
 #include <stdlib.h>
+#include "local.h"
 
 char *
 __utoa (unsigned value,
         char *str,
         int base)
 {
-  const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
-  int i, j;
-  unsigned remainder;
-  char c;
-  
   /* Check base is supported. */
   if ((base < 2) || (base > 36))
     { 
       str[0] = '\0';
       return NULL;
     }  
-    
-  /* Convert to string. Digits are in reverse order.  */
-  i = 0;
-  do 
-    {
-      remainder = value % base;
-      str[i++] = digits[remainder];
-      value = value / base;
-    } while (value != 0);  
-  str[i] = '\0'; 
-  
-  /* Reverse string.  */
-  for (j = 0, i--; j < i; j++, i--)
-    {
-      c = str[j];
-      str[j] = str[i];
-      str[i] = c; 
-    }       
-  
-  return str;
+
+  return __ulltoa_base (value, str, base);
 }
 
 char *  
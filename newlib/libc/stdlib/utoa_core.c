@@ -0,0 +1,254 @@
+/* utoa_core.c -- integer to digit string conversion shared by utoa,
+   ltoa and the printf family.
+
+   Digits are produced from the least significant end straight into
+   their final place, so callers that want the string at the start of a
+   buffer ask for its length first instead of reversing it afterwards.
+   Decimal conversion peels 32-bit chunks off 64-bit values with at most
+   two real divisions and then emits two digits per step from a table,
+   dividing by 100 with a multiply by its reciprocal.  */
+
+#include <_ansi.h>
+#include <stdlib.h>
+#include <string.h>
+#include "local.h"
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+
+static const char dec_pairs[200] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static const uint64_t pow10_tab[20] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL,
+  10000000000000000000ULL
+};
+
+/* V / 100 for any 32-bit V.  */
+#define DIV100(v)	((uint32_t) (((uint64_t) (v) * 1374389535U) >> 37))
+
+/* Store the digits of V, without leading zeros, before END.  */
+static char *
+put32 (uint32_t v,
+	char *end)
+{
+  uint32_t q;
+
+  while (v >= 100)
+    {
+      q = DIV100 (v);
+      end -= 2;
+      memcpy (end, &dec_pairs[2 * (v - q * 100)], 2);
+      v = q;
+    }
+  if (v >= 10)
+    {
+      end -= 2;
+      memcpy (end, &dec_pairs[2 * v], 2);
+    }
+  else
+    *--end = '0' + v;
+  return end;
+}
+
+/* Store exactly eight digits of V, which is below 10^8, before END.  */
+static char *
+put8 (uint32_t v,
+	char *end)
+{
+  uint32_t q;
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      q = DIV100 (v);
+      end -= 2;
+      memcpy (end, &dec_pairs[2 * (v - q * 100)], 2);
+      v = q;
+    }
+  return end;
+}
+
+int
+__dec_len64 (uint64_t v)
+{
+  int lo = 1, hi = 20, mid;
+
+  /* The smallest N with V < 10^N, or 20.  */
+  while (lo < hi)
+    {
+      mid = (lo + hi) / 2;
+      if (v < pow10_tab[mid])
+	hi = mid;
+      else
+	lo = mid + 1;
+    }
+  return lo;
+}
+
+char *
+__dec_put64 (uint64_t v,
+	char *end)
+{
+  while (v > 0xffffffffU)
+    {
+      end = put8 ((uint32_t) (v % 100000000), end);
+      v /= 100000000;
+    }
+  return put32 ((uint32_t) v, end);
+}
+
+#else /* PREFER_SIZE_OVER_SPEED || __OPTIMIZE_SIZE__ */
+
+int
+__dec_len64 (uint64_t v)
+{
+  int n = 1;
+
+  while (v >= 10)
+    {
+      v /= 10;
+      n++;
+    }
+  return n;
+}
+
+char *
+__dec_put64 (uint64_t v,
+	char *end)
+{
+  do
+    {
+      *--end = '0' + (char) (v % 10);
+      v /= 10;
+    }
+  while (v != 0);
+  return end;
+}
+
+#endif /* PREFER_SIZE_OVER_SPEED || __OPTIMIZE_SIZE__ */
+
+#ifdef __SIZEOF_INT128__
+
+/* Larger values are divided down by 10^9 over 32-bit limbs, so that no
+   128-bit division helper is needed.  */
+
+int
+__dec_len128 (unsigned __int128 v)
+{
+  unsigned __int128 p = (unsigned __int128) 10000000000000000000ULL * 10;
+  int n = 20;
+
+  if ((v >> 64) == 0)
+    return __dec_len64 ((uint64_t) v);
+  while (n < 39 && v >= p)
+    {
+      p *= 10;
+      n++;
+    }
+  return n;
+}
+
+char *
+__dec_put128 (unsigned __int128 v,
+	char *end)
+{
+  uint32_t limb[4];
+  uint64_t cur;
+  uint32_t rem;
+  int i;
+
+  if ((v >> 64) == 0)
+    return __dec_put64 ((uint64_t) v, end);
+
+  for (i = 0; i < 4; i++)
+    limb[i] = (uint32_t) (v >> (32 * i));
+  while (limb[3] != 0 || limb[2] != 0)
+    {
+      rem = 0;
+      for (i = 3; i >= 0; i--)
+	{
+	  cur = ((uint64_t) rem << 32) | limb[i];
+	  limb[i] = (uint32_t) (cur / 1000000000);
+	  rem = (uint32_t) (cur % 1000000000);
+	}
+      /* Nine digits, leading zeros included: convert 10^9 + REM and
+	 drop the 1, whose place the higher digits overwrite later.  */
+      end = __dec_put64 (rem + 1000000000ULL, end) + 1;
+    }
+  return __dec_put64 (((uint64_t) limb[1] << 32) | limb[0], end);
+}
+
+#endif /* __SIZEOF_INT128__ */
+
+char *
+__hex_put64 (uint64_t v,
+	char *end,
+	const char *xdigits)
+{
+  do
+    {
+      *--end = xdigits[v & 15];
+      v >>= 4;
+    }
+  while (v != 0);
+  return end;
+}
+
+char *
+__ulltoa_base (uint64_t value,
+	char *str,
+	int base)
+{
+  const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  unsigned int shift = 0;
+  uint64_t v;
+  char *end;
+  int n;
+
+  /* Count the digits first so that they can be stored in place.  */
+  if (base == 10)
+    n = __dec_len64 (value);
+  else if ((base & (base - 1)) == 0)
+    {
+      while ((1 << shift) < base)
+	shift++;
+      for (n = 1, v = value >> shift; v != 0; v >>= shift)
+	n++;
+    }
+  else
+    for (n = 1, v = value; v >= (uint64_t) base; v /= base)
+      n++;
+  end = str + n;
+  *end = '\0';
+
+  if (base == 10)
+    __dec_put64 (value, end);
+  else if (shift != 0)
+    do
+      {
+	*--end = digits[value & (base - 1)];
+	value >>= shift;
+      }
+    while (value != 0);
+  else
+    do
+      {
+	*--end = digits[value % base];
+	value /= base;
+      }
+    while (value != 0);
+  return str;
+}
@@ -81,6 +81,9 @@ _wcsnrtombs_l (struct _reent *r, char *dst, const wchar_t **src, size_t nwc,
   wchar_t *pwcs;
   size_t n;
   int i;
+#ifdef __UTF8_RUNS
+  int utf8 = loc->wctomb == __utf8_wctomb;
+#endif
 
 #ifdef _MB_CAPABLE
   if (ps == NULL)
@@ -97,11 +100,30 @@ _wcsnrtombs_l (struct _reent *r, char *dst, const wchar_t **src, size_t nwc,
   n = 0;
   pwcs = (wchar_t *)(*src);
 
-  while (n < len && nwc-- > 0)
+  while (n < len && nwc > 0)
     {
+#ifdef __UTF8_RUNS
+      if (utf8 && ps->__count == 0)
+	{
+	  const wchar_t *p = pwcs;
+	  size_t k = __utf8_wcsrun (ptr, &p, nwc, len - n);
+
+	  nwc -= p - pwcs;
+	  pwcs = (wchar_t *) p;
+	  n += k;
+	  if (dst)
+	    {
+	      ptr += k;
+	      *src = p;
+	    }
+	  if (n == len || nwc == 0)
+	    break;
+	}
+#endif
       int count = ps->__count;
       wint_t wch = ps->__value.__wch;
       int bytes = loc->wctomb (r, buff, *pwcs, ps);
+      --nwc;
       if (bytes == -1)
 	{
 	  r->_errno = EILSEQ;
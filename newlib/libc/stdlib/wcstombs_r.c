@@ -13,12 +13,27 @@ _wcstombs_r (struct _reent *r,
   size_t max = n;
   char buff[8];
   int i, bytes, num_to_copy;
+#ifdef __UTF8_RUNS
+  int utf8 = __WCTOMB == __utf8_wctomb;
+  const wchar_t *p;
+  size_t n1;
+#endif
 
   if (s == NULL)
     {
       size_t num_bytes = 0;
       while (*pwcs != 0)
 	{
+#ifdef __UTF8_RUNS
+	  if (utf8 && state->__count == 0)
+	    {
+	      p = pwcs;
+	      num_bytes += __utf8_wcsrun (NULL, &p, (size_t) -1, (size_t) -1);
+	      pwcs = p;
+	      if (*pwcs == 0)
+		break;
+	    }
+#endif
 	  bytes = __WCTOMB (r, buff, *pwcs++, state);
 	  if (bytes == -1)
 	    return -1;
@@ -30,6 +45,18 @@ _wcstombs_r (struct _reent *r,
     {
       while (n > 0)
         {
+#ifdef __UTF8_RUNS
+          if (utf8 && state->__count == 0)
+            {
+              p = pwcs;
+              n1 = __utf8_wcsrun (ptr, &p, (size_t) -1, n);
+              pwcs = p;
+              ptr += n1;
+              n -= n1;
+              if (n == 0)
+                break;
+            }
+#endif
           bytes = __WCTOMB (r, buff, *pwcs, state);
           if (bytes == -1)
             return -1;
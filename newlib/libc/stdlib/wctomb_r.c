@@ -137,6 +137,80 @@ __utf8_wctomb (struct _reent *r,
   return -1;
 }
 
+#ifdef __UTF8_RUNS
+/* Convert at most N wide characters at *PWCS to at most LEN bytes of
+   UTF-8 at S, or only count the bytes if S is NULL.  Only what
+   __utf8_wctomb converts from the initial state is taken; the run
+   stops before a null character, a character which does not fit, a
+   character __utf8_wctomb rejects and, with a 16-bit wchar_t, a
+   surrogate.  *PWCS is advanced past the characters converted, and the
+   number of bytes is returned.  */
+size_t
+__utf8_wcsrun (char          *s,
+        const wchar_t **pwcs,
+        size_t          n,
+        size_t          len)
+{
+  const wchar_t *p = *pwcs;
+  size_t count = 0;
+  wint_t wchar;
+
+  for (; n > 0; --n, ++p)
+    {
+      wchar = *p;
+      if (wchar >= 0x01 && wchar <= 0x7f)
+	{
+	  if (count == len)
+	    break;
+	  if (s != NULL)
+	    s[count] = wchar;
+	  count += 1;
+	}
+      else if (wchar >= 0x80 && wchar <= 0x7ff)
+	{
+	  if (len - count < 2)
+	    break;
+	  if (s != NULL)
+	    {
+	      s[count]     = 0xc0 | ((wchar & 0x7c0) >> 6);
+	      s[count + 1] = 0x80 |  (wchar &  0x3f);
+	    }
+	  count += 2;
+	}
+      else if (wchar >= 0x800 && wchar <= 0xffff)
+	{
+	  if (len - count < 3
+	      || (sizeof (wchar_t) == 2 && wchar >= 0xd800 && wchar <= 0xdfff))
+	    break;
+	  if (s != NULL)
+	    {
+	      s[count]     = 0xe0 | ((wchar & 0xf000) >> 12);
+	      s[count + 1] = 0x80 | ((wchar &  0xfc0) >> 6);
+	      s[count + 2] = 0x80 |  (wchar &   0x3f);
+	    }
+	  count += 3;
+	}
+      else if (wchar >= 0x10000 && wchar <= 0x10ffff)
+	{
+	  if (len - count < 4)
+	    break;
+	  if (s != NULL)
+	    {
+	      s[count]     = 0xf0 | ((wchar & 0x1c0000) >> 18);
+	      s[count + 1] = 0x80 | ((wchar &  0x3f000) >> 12);
+	      s[count + 2] = 0x80 | ((wchar &    0xfc0) >> 6);
+	      s[count + 3] = 0x80 |  (wchar &     0x3f);
+	    }
+	  count += 4;
+	}
+      else
+	break;
+    }
+  *pwcs = p;
+  return count;
+}
+#endif /* __UTF8_RUNS */
+
 /* Cygwin defines its own doublebyte charset conversion functions 
    because the underlying OS requires wchar_t == UTF-16. */
 #ifndef __CYGWIN__
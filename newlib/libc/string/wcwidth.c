@@ -96,6 +96,7 @@ PORTABILITY
 #include "local.h"
 
 #ifdef _MB_CAPABLE
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
 struct interval
 {
   int first;
@@ -124,6 +125,16 @@ bisearch(wint_t ucs, const struct interval *table, int max)
 
   return 0;
 }
+#else /* !PREFER_SIZE_OVER_SPEED */
+/* combining.t, wide.t and ambiguous.t merged into one two-stage table
+   of flags, indexed by the block of 128 characters and the character
+   within it.  */
+#define COMBINING	1
+#define WIDE		2
+#define AMBIGUOUS	4
+
+#include "width2.t"
+#endif /* !PREFER_SIZE_OVER_SPEED */
 #endif /* _MB_CAPABLE */
 
 /* The following function defines the column width of an ISO 10646
@@ -167,6 +178,7 @@ int
 __wcwidth (const wint_t ucs)
 {
 #ifdef _MB_CAPABLE
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   /* sorted list of non-overlapping intervals of East Asian Ambiguous chars */
   static const struct interval ambiguous[] =
 #include "ambiguous.t"
@@ -180,6 +192,7 @@ __wcwidth (const wint_t ucs)
    */
   static const struct interval wide[] =
 #include "wide.t"
+#endif /* PREFER_SIZE_OVER_SPEED */
 
   /* Test for NUL character */
   if (ucs == 0)
@@ -200,6 +213,20 @@ __wcwidth (const wint_t ucs)
   /* check CJK width mode (1: ambiguous-wide, 0: normal, -1: disabled) */
   int cjk_lang = __locale_cjk_lang ();
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+  int flags = ucs < WIDTH_LIMIT
+	      ? width_leaf[width_index[ucs >> WIDTH_SHIFT]]
+			  [ucs & ((1 << WIDTH_SHIFT) - 1)]
+	      : 0;
+
+  if (cjk_lang > 0 && (flags & AMBIGUOUS))
+    return 2;
+  if (flags & COMBINING)
+    return 0;
+  if (cjk_lang >= 0 && (flags & WIDE))
+    return 2;
+  return 1;
+#else /* PREFER_SIZE_OVER_SPEED */
   /* binary search in table of ambiguous characters */
   if (cjk_lang > 0
       && bisearch(ucs, ambiguous,
@@ -220,6 +247,7 @@ __wcwidth (const wint_t ucs)
     return 2;
   else
     return 1;
+#endif /* PREFER_SIZE_OVER_SPEED */
 #else /* !_MB_CAPABLE */
   if (iswprint (ucs))
     return 1;
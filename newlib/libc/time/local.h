@@ -21,6 +21,7 @@
 #define isleap(y) ((((y) % 4) == 0 && ((y) % 100) != 0) || ((y) % 400) == 0)
 
 int         __tzcalc_limits (int __year);
+int         __tm_normalize (struct tm *, time_t *);
 
 extern const int __month_lengths[2][MONSPERYEAR];
 
@@ -0,0 +1,55 @@
+/*
+ * timegm.c
+ *
+ * Converts the broken-down time, expressed as UTC, in the structure pointed
+ * to by tim_p into a calendar time value.  Unlike mktime(), it neither looks
+ * at nor locks the time zone information.
+ */
+
+/*
+FUNCTION
+<<timegm>>---convert UTC time to arithmetic representation
+
+INDEX
+	timegm
+
+SYNOPSIS
+	#include <time.h>
+	time_t timegm(struct tm *<[timp]>);
+
+DESCRIPTION
+<<timegm>> is like <<mktime>>, except that it takes the time at
+<[timp]> to be Coordinated Universal Time rather than local time.  The
+fields of <[timp]> are normalized the same way, <<tm_wday>> and
+<<tm_yday>> are filled in and <<tm_isdst>> is set to zero.  The time
+zone is never consulted, so <<timegm>> does not call <<tzset>> or take
+the time zone lock.
+
+<<gmtime>> is the inverse of <<timegm>>.
+
+RETURNS
+If the contents of the structure at <[timp]> do not form a valid
+calendar time representation, the result is <<-1>>.  Otherwise, the
+result is the time, converted to a <<time_t>> value.
+
+PORTABILITY
+<<timegm>> is a BSD and GNU extension, not required by ANSI C or POSIX.
+
+<<timegm>> requires no supporting OS subroutines.
+*/
+
+#include <time.h>
+#include "local.h"
+
+time_t
+timegm (struct tm *tim_p)
+{
+  time_t days;
+
+  if (__tm_normalize (tim_p, &days) < 0)
+    return (time_t) -1;
+  tim_p->tm_isdst = 0;
+
+  return days * SECSPERDAY + tim_p->tm_hour * SECSPERHOUR
+      + tim_p->tm_min * SECSPERMIN + tim_p->tm_sec;
+}
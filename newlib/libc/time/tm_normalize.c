@@ -0,0 +1,156 @@
+/*
+ * tm_normalize.c
+ *
+ * Brings the fields of a struct tm into their usual ranges and counts the
+ * days from the epoch to the date, for mktime() and timegm().  The date is
+ * converted with the closed-form days_from_civil() algorithm by Howard
+ * Hinnant, the inverse of the one gmtime_r() uses, so the cost does not
+ * depend on how far the year is from 1970 or how far tm_mday is out of
+ * range.  It lives in a file of its own so that timegm() does not pull in
+ * the time zone code.
+ *
+ * Years more than 10000 from 1900 are refused, before the date is
+ * converted, so that no arithmetic is done on a year that could overflow.
+ */
+
+#include <stdlib.h>
+#include "local.h"
+
+/* see gmtime_r.c */
+#define EPOCH_ADJUSTMENT_DAYS	719468L
+#define DAYS_PER_ERA		146097L
+#define DAYS_PER_CENTURY	36524L
+#define DAYS_PER_4_YEARS	(3 * 365 + 366)
+#define DAYS_PER_YEAR		365
+#define YEARS_PER_ERA		400
+
+/* The tm_year values mktime() and timegm() accept.  */
+#define TM_YEAR_OK(y)		((y) >= -10000 && (y) <= 10000)
+
+static const int DAYS_BEFORE_MONTH[MONSPERYEAR] =
+{0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+/* Days from 1 March of year 0 to 1 March of YEAR.  */
+static time_t
+days_to_march (time_t year)
+{
+  time_t era;
+  unsigned erayear;
+
+  era = (year >= 0 ? year : year - (YEARS_PER_ERA - 1)) / YEARS_PER_ERA;
+  erayear = (unsigned) (year - era * YEARS_PER_ERA);	/* [0, 399] */
+  return era * DAYS_PER_ERA + DAYS_PER_YEAR * erayear + erayear / 4
+      - erayear / 100;
+}
+
+/* Days from the epoch to MDAY (counted from 1) of month MON of YEAR,
+   where MON is in [0, 11] but MDAY may be anything.  */
+static time_t
+days_from_civil (time_t year,
+	int mon,
+	int mday)
+{
+  /* Months counted from March, so that the leap day comes last.  */
+  unsigned marmon = mon >= 2 ? mon - 2 : mon + 10;	/* [0, 11] */
+
+  return days_to_march (year - (mon < 2)) + (153 * marmon + 2) / 5
+      + (time_t) mday - 1 - EPOCH_ADJUSTMENT_DAYS;
+}
+
+/* Normalize *TIM_P and store the days from the epoch to its date in
+   *DAYS_P.  Returns -1, with *DAYS_P unset, if the year is out of
+   range, else 0.  */
+int
+__tm_normalize (struct tm *tim_p,
+	time_t *days_p)
+{
+  div_t res;
+  time_t days, year, era;
+  unsigned long eraday;
+  unsigned erayear, yearday, month;
+  int weekday;
+
+  /* calculate time & date to account for out of range values */
+  if (tim_p->tm_sec < 0 || tim_p->tm_sec > 59)
+    {
+      res = div (tim_p->tm_sec, 60);
+      tim_p->tm_min += res.quot;
+      if ((tim_p->tm_sec = res.rem) < 0)
+	{
+	  tim_p->tm_sec += 60;
+	  --tim_p->tm_min;
+	}
+    }
+
+  if (tim_p->tm_min < 0 || tim_p->tm_min > 59)
+    {
+      res = div (tim_p->tm_min, 60);
+      tim_p->tm_hour += res.quot;
+      if ((tim_p->tm_min = res.rem) < 0)
+	{
+	  tim_p->tm_min += 60;
+	  --tim_p->tm_hour;
+	}
+    }
+
+  if (tim_p->tm_hour < 0 || tim_p->tm_hour > 23)
+    {
+      res = div (tim_p->tm_hour, 24);
+      tim_p->tm_mday += res.quot;
+      if ((tim_p->tm_hour = res.rem) < 0)
+	{
+	  tim_p->tm_hour += 24;
+	  --tim_p->tm_mday;
+	}
+    }
+
+  if (tim_p->tm_mon < 0 || tim_p->tm_mon > 11)
+    {
+      res = div (tim_p->tm_mon, 12);
+      tim_p->tm_year += res.quot;
+      if ((tim_p->tm_mon = res.rem) < 0)
+	{
+	  tim_p->tm_mon += 12;
+	  --tim_p->tm_year;
+	}
+    }
+
+  if (!TM_YEAR_OK (tim_p->tm_year))
+    return -1;
+  year = (time_t) tim_p->tm_year + YEAR_BASE;
+  days = days_from_civil (year, tim_p->tm_mon, tim_p->tm_mday);
+
+  /* A day outside the month moves the date; convert back as gmtime_r
+     does.  */
+  if (tim_p->tm_mday < 1
+      || tim_p->tm_mday > __month_lengths[isleap (year)][tim_p->tm_mon])
+    {
+      days += EPOCH_ADJUSTMENT_DAYS;
+      era = (days >= 0 ? days : days - (DAYS_PER_ERA - 1)) / DAYS_PER_ERA;
+      eraday = days - era * DAYS_PER_ERA;	/* [0, 146096] */
+      erayear = (eraday - eraday / (DAYS_PER_4_YEARS - 1) + eraday / DAYS_PER_CENTURY -
+	  eraday / (DAYS_PER_ERA - 1)) / 365;	/* [0, 399] */
+      yearday = eraday - (DAYS_PER_YEAR * erayear + erayear / 4 - erayear / 100);	/* [0, 365] */
+      month = (5 * yearday + 2) / 153;	/* [0, 11] */
+      tim_p->tm_mday = yearday - (153 * month + 2) / 5 + 1;	/* [1, 31] */
+      month += month < 10 ? 2 : -10;
+      year = erayear + era * YEARS_PER_ERA + (month <= 1);
+      tim_p->tm_mon = month;
+      tim_p->tm_year = year - YEAR_BASE;
+      days -= EPOCH_ADJUSTMENT_DAYS;
+      if (!TM_YEAR_OK (year - YEAR_BASE))
+	return -1;
+    }
+
+  /* compute day of the year */
+  tim_p->tm_yday = DAYS_BEFORE_MONTH[tim_p->tm_mon] + tim_p->tm_mday - 1
+      + (tim_p->tm_mon > 1 && isleap (year));
+
+  /* compute day of the week */
+  if ((weekday = (days + EPOCH_WDAY) % DAYSPERWEEK) < 0)
+    weekday += DAYSPERWEEK;
+  tim_p->tm_wday = weekday;
+
+  *days_p = days;
+  return 0;
+}
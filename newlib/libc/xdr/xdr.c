@@ -39,6 +39,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
 
 #include <rpc/types.h>
 #include <rpc/xdr.h>
@@ -685,6 +686,59 @@ xdr_bytes (XDR * xdrs,
   return FALSE;
 }
 
+/*
+ * XDR opaque data without copying it on decode:  *cpp is set to point
+ * at the cnt bytes in the stream's buffer, which must be able to lend
+ * them (from x_inline) and must outlive *cpp.  For cnt 0, *cpp is set
+ * to NULL.  Nothing is allocated, so there is nothing to free.
+ */
+bool_t
+xdr_opaque_ref (XDR * xdrs,
+	char ** cpp,
+	u_int cnt)
+{
+  int32_t *buf;
+
+  switch (xdrs->x_op)
+    {
+    case XDR_DECODE:
+      if (cnt == 0)
+        {
+          *cpp = NULL;
+          return TRUE;
+        }
+      if (cnt > RNDUP (cnt)
+          || (buf = XDR_INLINE (xdrs, RNDUP (cnt))) == NULL)
+        return FALSE;
+      *cpp = (char *) buf;
+      return TRUE;
+
+    case XDR_ENCODE:
+      return xdr_opaque (xdrs, *cpp, cnt);
+
+    case XDR_FREE:
+      return TRUE;
+    }
+  return FALSE;
+}
+
+/*
+ * XDR counted bytes as xdr_bytes, but decoding to a pointer into the
+ * stream's buffer as xdr_opaque_ref.
+ */
+bool_t
+xdr_bytes_ref (XDR * xdrs,
+	char ** cpp,
+	u_int * sizep,
+	u_int maxsize)
+{
+  if (!xdr_u_int (xdrs, sizep))
+    return FALSE;
+  if ((*sizep > maxsize) && (xdrs->x_op != XDR_FREE))
+    return FALSE;
+  return xdr_opaque_ref (xdrs, cpp, *sizep);
+}
+
 /*
  * Implemented here due to commonality of the object.
  */
@@ -46,6 +46,136 @@
 
 #include "xdr_private.h"
 
+#ifndef ntohl
+# define ntohl(x) xdr_ntohl(x)
+#endif
+#ifndef htonl
+# define htonl(x) xdr_htonl(x)
+#endif
+
+/* at most this many bytes of an array are asked of x_inline at once */
+#define XDR_ARRAY_CHUNK 4096
+
+/*
+ * If elproc is one of the integer or IEEE floating point filters and
+ * elsize its size, elements are XDR'd a run at a time:  the number of
+ * 32 bit words per element, and whether the two words of an 8 byte
+ * element are in the opposite order in memory.  0 otherwise.
+ */
+static u_int
+xdr_array_words (xdrproc_t elproc,
+	u_int elsize,
+	int *swap)
+{
+  *swap = 0;
+  if (elsize == sizeof (int32_t))
+    {
+      if (elproc == (xdrproc_t) xdr_int32_t
+          || elproc == (xdrproc_t) xdr_uint32_t
+          || elproc == (xdrproc_t) xdr_u_int32_t)
+        return 1;
+#if INT_MAX == 0x7fffffff
+      if (elproc == (xdrproc_t) xdr_int
+          || elproc == (xdrproc_t) xdr_u_int)
+        return 1;
+#endif
+#if defined(__IEEE_LITTLE_ENDIAN) || defined(__IEEE_BIG_ENDIAN)
+      if (elproc == (xdrproc_t) xdr_float)
+        return 1;
+#endif
+    }
+#if defined(___int64_t_defined)
+  if (elsize == sizeof (int64_t))
+    {
+      *swap = _BYTE_ORDER == _LITTLE_ENDIAN;
+      if (elproc == (xdrproc_t) xdr_int64_t
+          || elproc == (xdrproc_t) xdr_uint64_t
+          || elproc == (xdrproc_t) xdr_u_int64_t
+          || elproc == (xdrproc_t) xdr_hyper
+          || elproc == (xdrproc_t) xdr_u_hyper
+          || elproc == (xdrproc_t) xdr_longlong_t
+          || elproc == (xdrproc_t) xdr_u_longlong_t)
+        return 2;
+    }
+#endif
+#if (defined(__IEEE_LITTLE_ENDIAN) || defined(__IEEE_BIG_ENDIAN)) \
+    && !defined(_DOUBLE_IS_32BITS)
+  if (elsize == sizeof (double) && elproc == (xdrproc_t) xdr_double)
+    {
+#if defined(__IEEE_BIG_ENDIAN)
+      *swap = 0;
+#else
+      *swap = 1;
+#endif
+      return 2;
+    }
+#endif
+  return 0;
+}
+
+/*
+ * XDR nelem elements of nwords 32 bit words each, as xdr_array_words
+ * describes them, converting whole runs of the stream's buffer from
+ * x_inline.  Where the stream has no buffer to lend, one element
+ * goes through elproc before trying again.
+ */
+static bool_t
+xdr_array_run (XDR * xdrs,
+	char *addr,
+	u_int nelem,
+	u_int nwords,
+	int swap,
+	xdrproc_t elproc)
+{
+  int32_t *buf;
+  int32_t *p = (int32_t *) (void *) addr;
+  u_int i, n;
+
+  if (xdrs->x_op == XDR_FREE)
+    return TRUE;
+
+  while (nelem > 0)
+    {
+      n = XDR_ARRAY_CHUNK / (nwords * BYTES_PER_XDR_UNIT);
+      if (n > nelem)
+        n = nelem;
+      buf = XDR_INLINE (xdrs, n * nwords * BYTES_PER_XDR_UNIT);
+      if (buf == NULL)
+        {
+          if (!(*elproc) (xdrs, p))
+            return FALSE;
+          n = 1;
+        }
+      else if (xdrs->x_op == XDR_ENCODE)
+        {
+          if (!swap)
+            for (i = 0; i < n * nwords; i++)
+              buf[i] = (int32_t) htonl ((u_int32_t) p[i]);
+          else
+            for (i = 0; i < n * 2; i += 2)
+              {
+                buf[i] = (int32_t) htonl ((u_int32_t) p[i + 1]);
+                buf[i + 1] = (int32_t) htonl ((u_int32_t) p[i]);
+              }
+        }
+      else
+        {
+          if (!swap)
+            for (i = 0; i < n * nwords; i++)
+              p[i] = (int32_t) ntohl ((u_int32_t) buf[i]);
+          else
+            for (i = 0; i < n * 2; i += 2)
+              {
+                p[i + 1] = (int32_t) ntohl ((u_int32_t) buf[i]);
+                p[i] = (int32_t) ntohl ((u_int32_t) buf[i + 1]);
+              }
+        }
+      p += n * nwords;
+      nelem -= n;
+    }
+  return TRUE;
+}
+
 /*
  * XDR an array of arbitrary elements
  * *addrp is a pointer to the array, *sizep is the number of elements.
@@ -66,6 +196,8 @@ xdr_array (XDR * xdrs,
   u_int c;                      /* the actual element count */
   bool_t stat = TRUE;
   u_int nodesize;
+  u_int nwords;
+  int swap;
 
   /* like strings, arrays are really counted arrays */
   if (!xdr_u_int (xdrs, sizep))
@@ -109,11 +241,14 @@ xdr_array (XDR * xdrs,
   /*
    * now we xdr each element of array
    */
-  for (i = 0; (i < c) && stat; i++)
-    {
-      stat = (*elproc) (xdrs, target);
-      target += elsize;
-    }
+  if ((nwords = xdr_array_words (elproc, elsize, &swap)) != 0)
+    stat = xdr_array_run (xdrs, target, c, nwords, swap, elproc);
+  else
+    for (i = 0; (i < c) && stat; i++)
+      {
+        stat = (*elproc) (xdrs, target);
+        target += elsize;
+      }
 
   /*
    * the array may need freeing
@@ -145,6 +280,11 @@ xdr_vector (XDR * xdrs,
 {
   u_int i;
   char *elptr;
+  u_int nwords;
+  int swap;
+
+  if ((nwords = xdr_array_words (xdr_elem, elemsize, &swap)) != 0)
+    return xdr_array_run (xdrs, basep, nelem, nwords, swap, xdr_elem);
 
   elptr = basep;
   for (i = 0; i < nelem; i++)
@@ -157,3 +297,66 @@ xdr_vector (XDR * xdrs,
     }
   return TRUE;
 }
+
+/*
+ * XDR fixed length arrays of integers and floating point numbers, as
+ * xdr_vector with the matching filter does, converting whole runs of
+ * the stream's buffer where it has one.
+ */
+bool_t
+xdr_int32_array (XDR * xdrs,
+	int32_t * ip,
+	u_int nelem)
+{
+  return xdr_vector (xdrs, (char *) ip, nelem, sizeof (int32_t),
+                     (xdrproc_t) xdr_int32_t);
+}
+
+bool_t
+xdr_uint32_array (XDR * xdrs,
+	uint32_t * up,
+	u_int nelem)
+{
+  return xdr_vector (xdrs, (char *) up, nelem, sizeof (uint32_t),
+                     (xdrproc_t) xdr_uint32_t);
+}
+
+#if defined(___int64_t_defined)
+bool_t
+xdr_int64_array (XDR * xdrs,
+	int64_t * llp,
+	u_int nelem)
+{
+  return xdr_vector (xdrs, (char *) llp, nelem, sizeof (int64_t),
+                     (xdrproc_t) xdr_int64_t);
+}
+
+bool_t
+xdr_uint64_array (XDR * xdrs,
+	uint64_t * ullp,
+	u_int nelem)
+{
+  return xdr_vector (xdrs, (char *) ullp, nelem, sizeof (uint64_t),
+                     (xdrproc_t) xdr_uint64_t);
+}
+#endif /* ___int64_t_defined */
+
+bool_t
+xdr_float_array (XDR * xdrs,
+	float *fp,
+	u_int nelem)
+{
+  return xdr_vector (xdrs, (char *) fp, nelem, sizeof (float),
+                     (xdrproc_t) xdr_float);
+}
+
+#if !defined(_DOUBLE_IS_32BITS)
+bool_t
+xdr_double_array (XDR * xdrs,
+	double *dp,
+	u_int nelem)
+{
+  return xdr_vector (xdrs, (char *) dp, nelem, sizeof (double),
+                     (xdrproc_t) xdr_double);
+}
+#endif /* !_DOUBLE_IS_32BITS */
@@ -0,0 +1,296 @@
+/*
+ * xdr_iov.c, XDR implementation using a chain of memory buffers.
+ *
+ * The stream encodes straight into, and decodes straight out of, the
+ * caller's segments; nothing is copied through a buffer of its own.
+ * Runs which lie within one segment and are aligned are lent out by
+ * x_inline, so that xdr_opaque_ref() and xdr_bytes_ref() can point into
+ * the input and arrays of numbers are converted in place.
+ *
+ * To allocate the output exactly once, size the data with xdr_sizeof()
+ * first.
+ */
+
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <rpc/types.h>
+#include <rpc/xdr.h>
+
+#include "xdr_private.h"
+
+#ifndef ntohl
+# define ntohl(x) xdr_ntohl(x)
+#endif
+#ifndef htonl
+# define htonl(x) xdr_htonl(x)
+#endif
+
+typedef struct iov_stream
+{
+  const struct xdr_iovec *iov;  /* the segments */
+  u_int iovcnt;
+  u_int seg;                    /* the current one */
+  size_t start;                 /* stream position of its start */
+  size_t size;                  /* total size of the segments */
+  char *finger;                 /* next byte in it */
+  size_t left;                  /* bytes after finger in it */
+} IOVSTREAM;
+
+static bool_t xdriov_getlong (XDR *, long *);
+static bool_t xdriov_putlong (XDR *, const long *);
+static bool_t xdriov_getbytes (XDR *, char *, u_int);
+static bool_t xdriov_putbytes (XDR *, const char *, u_int);
+static u_int xdriov_getpos (XDR *);
+static bool_t xdriov_setpos (XDR *, u_int);
+static int32_t *xdriov_inline (XDR *, u_int);
+static void xdriov_destroy (XDR *);
+static bool_t xdriov_getint32 (XDR *, int32_t *);
+static bool_t xdriov_putint32 (XDR *, const int32_t *);
+
+static const struct xdr_ops xdriov_ops = {
+  xdriov_getlong,
+  xdriov_putlong,
+  xdriov_getbytes,
+  xdriov_putbytes,
+  xdriov_getpos,
+  xdriov_setpos,
+  xdriov_inline,
+  xdriov_destroy,
+  xdriov_getint32,
+  xdriov_putint32
+};
+
+/* The stream position.  */
+static size_t
+iov_pos (IOVSTREAM * istrm)
+{
+  if (istrm->iovcnt == 0)
+    return 0;
+  return istrm->start + (istrm->iov[istrm->seg].iov_len - istrm->left);
+}
+
+/* Make the segment at position POS of the stream the current one.  */
+static void
+iov_seek (IOVSTREAM * istrm,
+	size_t pos)
+{
+  u_int i = 0;
+  size_t start = 0;
+
+  while (i + 1 < istrm->iovcnt && pos - start >= istrm->iov[i].iov_len)
+    start += istrm->iov[i++].iov_len;
+  istrm->seg = i;
+  istrm->start = start;
+  if (istrm->iovcnt == 0)
+    {
+      istrm->finger = NULL;
+      istrm->left = 0;
+    }
+  else
+    {
+      istrm->finger = (char *) istrm->iov[i].iov_base + (pos - start);
+      istrm->left = istrm->iov[i].iov_len - (pos - start);
+    }
+}
+
+/* Move on to the next segment with something in it.  */
+static void
+iov_next (IOVSTREAM * istrm)
+{
+  while (istrm->left == 0 && istrm->seg + 1 < istrm->iovcnt)
+    {
+      istrm->start += istrm->iov[istrm->seg++].iov_len;
+      istrm->finger = (char *) istrm->iov[istrm->seg].iov_base;
+      istrm->left = istrm->iov[istrm->seg].iov_len;
+    }
+}
+
+/*
+ * The procedure xdriov_create initializes a stream descriptor for the
+ * IOVCNT segments at IOV, which must stay valid as long as the stream
+ * and the references into them are used.
+ */
+void
+xdriov_create (XDR * xdrs,
+	const struct xdr_iovec *iov,
+	u_int iovcnt,
+	enum xdr_op op)
+{
+  IOVSTREAM *istrm;
+  u_int i;
+
+  istrm = (IOVSTREAM *) mem_alloc (sizeof (IOVSTREAM));
+  if (istrm == NULL)
+    {
+      xdr_warnx ("xdriov_create: out of memory");
+      errno = ENOMEM;
+      return;
+    }
+  istrm->iov = iov;
+  istrm->iovcnt = iovcnt;
+  istrm->size = 0;
+  for (i = 0; i < iovcnt; i++)
+    istrm->size += iov[i].iov_len;
+  iov_seek (istrm, 0);
+
+  xdrs->x_op = op;
+  xdrs->x_ops = (struct xdr_ops *) &xdriov_ops;
+  xdrs->x_private = istrm;
+  xdrs->x_base = NULL;
+  xdrs->x_handy = 0;
+}
+
+static void
+xdriov_destroy (XDR * xdrs)
+{
+  mem_free (xdrs->x_private, sizeof (IOVSTREAM));
+  xdrs->x_private = NULL;
+}
+
+static bool_t
+xdriov_getbytes (XDR * xdrs,
+	char *addr,
+	u_int len)
+{
+  IOVSTREAM *istrm = (IOVSTREAM *) xdrs->x_private;
+  size_t n;
+
+  if (istrm->size - iov_pos (istrm) < len)
+    return FALSE;
+  while (len > 0)
+    {
+      iov_next (istrm);
+      n = istrm->left < len ? istrm->left : len;
+      memcpy (addr, istrm->finger, n);
+      istrm->finger += n;
+      istrm->left -= n;
+      addr += n;
+      len -= n;
+    }
+  return TRUE;
+}
+
+static bool_t
+xdriov_putbytes (XDR * xdrs,
+	const char *addr,
+	u_int len)
+{
+  IOVSTREAM *istrm = (IOVSTREAM *) xdrs->x_private;
+  size_t n;
+
+  if (istrm->size - iov_pos (istrm) < len)
+    return FALSE;
+  while (len > 0)
+    {
+      iov_next (istrm);
+      n = istrm->left < len ? istrm->left : len;
+      memcpy (istrm->finger, addr, n);
+      istrm->finger += n;
+      istrm->left -= n;
+      addr += n;
+      len -= n;
+    }
+  return TRUE;
+}
+
+static bool_t
+xdriov_getint32 (XDR * xdrs,
+	int32_t * ip)
+{
+  IOVSTREAM *istrm = (IOVSTREAM *) xdrs->x_private;
+  u_int32_t l;
+
+  iov_next (istrm);
+  if (istrm->left >= sizeof (int32_t))
+    {
+      memcpy (&l, istrm->finger, sizeof (int32_t));
+      istrm->finger += sizeof (int32_t);
+      istrm->left -= sizeof (int32_t);
+    }
+  else if (!xdriov_getbytes (xdrs, (char *) &l, sizeof (int32_t)))
+    return FALSE;
+  *ip = (int32_t) ntohl (l);
+  return TRUE;
+}
+
+static bool_t
+xdriov_putint32 (XDR * xdrs,
+	const int32_t * ip)
+{
+  IOVSTREAM *istrm = (IOVSTREAM *) xdrs->x_private;
+  u_int32_t l = htonl ((u_int32_t) * ip);
+
+  iov_next (istrm);
+  if (istrm->left >= sizeof (int32_t))
+    {
+      memcpy (istrm->finger, &l, sizeof (int32_t));
+      istrm->finger += sizeof (int32_t);
+      istrm->left -= sizeof (int32_t);
+      return TRUE;
+    }
+  return xdriov_putbytes (xdrs, (const char *) &l, sizeof (int32_t));
+}
+
+static bool_t
+xdriov_getlong (XDR * xdrs,
+	long *lp)
+{
+  int32_t i;
+
+  if (!xdriov_getint32 (xdrs, &i))
+    return FALSE;
+  *lp = (long) i;
+  return TRUE;
+}
+
+static bool_t
+xdriov_putlong (XDR * xdrs,
+	const long *lp)
+{
+  int32_t i = (int32_t) *lp;
+
+  return xdriov_putint32 (xdrs, &i);
+}
+
+static u_int
+xdriov_getpos (XDR * xdrs)
+{
+  return (u_int) iov_pos ((IOVSTREAM *) xdrs->x_private);
+}
+
+static bool_t
+xdriov_setpos (XDR * xdrs,
+	u_int pos)
+{
+  IOVSTREAM *istrm = (IOVSTREAM *) xdrs->x_private;
+
+  if (pos > istrm->size)
+    return FALSE;
+  iov_seek (istrm, pos);
+  return TRUE;
+}
+
+/*
+ * Lend out the next LEN bytes if they are in the current segment and
+ * aligned for int32_t; otherwise NULL, and the stream does not move.
+ */
+static int32_t *
+xdriov_inline (XDR * xdrs,
+	u_int len)
+{
+  IOVSTREAM *istrm = (IOVSTREAM *) xdrs->x_private;
+  int32_t *buf;
+
+  if (len > 0)
+    iov_next (istrm);
+  if (istrm->left < len
+      || ((unsigned long) istrm->finger & (sizeof (int32_t) - 1)))
+    return NULL;
+  buf = (int32_t *) (void *) istrm->finger;
+  istrm->finger += len;
+  istrm->left -= len;
+  return buf;
+}
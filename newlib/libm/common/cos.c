@@ -0,0 +1,40 @@
+/* Double-precision cosine.  */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH
+
+#include <math.h>
+#include "math_config.h"
+#include "sincos.h"
+
+/* As sin, with the quadrants turned by one.  Worst-case error is below
+   1 ULP.  */
+double
+cos (double x)
+{
+  double hi, lo;
+  uint64_t ix = absbits (x);
+
+  if (ix <= asuint64 (Pio4))
+    {
+      if (unlikely (ix < SMALL))
+	return 1.0;
+      return cos_poly (x, 0.0);
+    }
+  if (unlikely (ix >= 0x7ff0000000000000ULL))
+    return __math_invalid (x);
+
+  switch (reduce (x, &hi, &lo) & 3)
+    {
+    case 0:
+      return cos_poly (hi, lo);
+    case 1:
+      return -sin_poly (hi, lo);
+    case 2:
+      return -cos_poly (hi, lo);
+    default:
+      return sin_poly (hi, lo);
+    }
+}
+
+#endif /* __OBSOLETE_MATH */
@@ -225,15 +225,22 @@ extern float __ieee754_scalbf __P((float,int));
 extern float __ieee754_scalbf __P((float,float));
 #endif
 
-#if !__OBSOLETE_MATH
+#if !__OBSOLETE_MATH || defined (_INTEGER_MATH)
 /* The new math code does not provide separate wrapper function
    for error handling, so the extern symbol is called directly.
    This is valid as long as there are no namespace issues (the
    extern symbol is reserved whenever the caller is reserved)
-   and there are no observable error handling side effects.  */
+   and there are no observable error handling side effects.
+   The integer kernels of _INTEGER_MATH work the same way.  math.h
+   leaves these out under _REENT_ONLY, so declare them here.  */
+extern double exp __P((double));
+extern double log __P((double));
+extern double pow __P((double,double));
 # define __ieee754_exp(x) exp(x)
 # define __ieee754_log(x) log(x)
 # define __ieee754_pow(x,y) pow(x,y)
+#endif
+#if !__OBSOLETE_MATH
 # define __ieee754_expf(x) expf(x)
 # define __ieee754_logf(x) logf(x)
 # define __ieee754_powf(x,y) powf(x,y)
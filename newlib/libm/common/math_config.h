@@ -436,4 +436,17 @@ extern const struct pow_log_data
   struct {double invc, pad, logc, logctail;} tab[1 << POW_LOG_TABLE_BITS];
 } __pow_log_data HIDDEN;
 
+#define SINCOS_POLY_ORDER 6
+#define TAN_POLY_ORDER 13
+extern const struct sincos_data
+{
+  double invpio2;
+  double shift;
+  double pio2_1, pio2_1t;	/* pi/2 = pio2_1 + pio2_1t, pio2_1 has 33 bits.  */
+  double pio4, pio4lo;
+  double sin_poly[SINCOS_POLY_ORDER];
+  double cos_poly[SINCOS_POLY_ORDER];
+  double tan_poly[TAN_POLY_ORDER];
+} __sincos_data HIDDEN;
+
 #endif
@@ -61,7 +61,7 @@ C99, POSIX, System V Interface Definition (Issue 6).
  */
 
 #include "fdlibm.h"
-#if __OBSOLETE_MATH
+#if __OBSOLETE_MATH && !defined (_INTEGER_MATH)
 #include <errno.h>
 #include <math.h>
 #undef log2
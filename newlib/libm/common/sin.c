@@ -0,0 +1,46 @@
+/* Double-precision sine.  */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH
+
+#include <math.h>
+#include "math_config.h"
+#include "sincos.h"
+
+/* The reduction of sincos.h and the fdlibm polynomial, inlined, so that
+   an argument below 2^19 costs one multiply-subtract and the polynomial
+   with no calls.  Worst-case error is below 1 ULP.  */
+double
+sin (double x)
+{
+  double hi, lo;
+  uint64_t ix = absbits (x);
+
+  if (ix <= asuint64 (Pio4))
+    {
+      if (unlikely (ix < SMALL))
+	{
+	  if (unlikely (ix < 0x0010000000000000ULL))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      return sin_poly (x, 0.0);
+    }
+  if (unlikely (ix >= 0x7ff0000000000000ULL))
+    return __math_invalid (x);
+
+  switch (reduce (x, &hi, &lo) & 3)
+    {
+    case 0:
+      return sin_poly (hi, lo);
+    case 1:
+      return cos_poly (hi, lo);
+    case 2:
+      return -sin_poly (hi, lo);
+    default:
+      return -cos_poly (hi, lo);
+    }
+}
+
+#endif /* __OBSOLETE_MATH */
@@ -0,0 +1,63 @@
+/* Double-precision sincos.  */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH
+
+#include <math.h>
+#include "math_config.h"
+#include "sincos.h"
+
+/* One reduction and one pass over the powers of r for both results,
+   which are the same as those of sin and cos.  */
+void
+sincos (double x, double *sinp, double *cosp)
+{
+  double hi, lo, s, c;
+  uint64_t ix = absbits (x);
+  int n;
+
+  if (ix <= asuint64 (Pio4))
+    {
+      if (unlikely (ix < SMALL))
+	{
+	  if (unlikely (ix < 0x0010000000000000ULL))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  *sinp = x;
+	  *cosp = 1.0;
+	  return;
+	}
+      sincos_poly (x, 0.0, sinp, cosp);
+      return;
+    }
+  if (unlikely (ix >= 0x7ff0000000000000ULL))
+    {
+      /* Return NaN for both, and set errno once for an infinity.  */
+      *sinp = *cosp = __math_invalid (x);
+      return;
+    }
+
+  n = reduce (x, &hi, &lo);
+  sincos_poly (hi, lo, &s, &c);
+  switch (n & 3)
+    {
+    case 0:
+      *sinp = s;
+      *cosp = c;
+      break;
+    case 1:
+      *sinp = c;
+      *cosp = -s;
+      break;
+    case 2:
+      *sinp = -s;
+      *cosp = -c;
+      break;
+    default:
+      *sinp = -c;
+      *cosp = s;
+      break;
+    }
+}
+
+#endif /* __OBSOLETE_MATH */
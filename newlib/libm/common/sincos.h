@@ -0,0 +1,163 @@
+/* Shared code between sin, cos, sincos and tan.
+
+   Arguments up to 2^19 are reduced to r = x - n pi/2, |r| <= pi/4, with
+   one Cody-Waite step against an 86-bit pi/2, good to 85 bits before the
+   cancellation.  When that loses more than 16 bits, and for larger
+   arguments, __ieee754_rem_pio2 does the reduction.  r is carried as
+   HI + LO, and the polynomials of sincos_data.c take that pair.  */
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+#define InvPio2 __sincos_data.invpio2
+#define Shift __sincos_data.shift
+#define Pio2_1 __sincos_data.pio2_1
+#define Pio2_1t __sincos_data.pio2_1t
+#define Pio4 __sincos_data.pio4
+#define Pio4lo __sincos_data.pio4lo
+#define S __sincos_data.sin_poly
+#define C __sincos_data.cos_poly
+#define T __sincos_data.tan_poly
+
+/* |x| below which sin (x) and tan (x) round to x and cos (x) to 1.  */
+#define SMALL 0x3e40000000000000ULL	/* 2^-27 */
+
+/* The bits of |x|, and the top 12 of them.  */
+static inline uint64_t
+absbits (double x)
+{
+  return asuint64 (x) & 0x7fffffffffffffffULL;
+}
+
+static inline uint32_t
+abstop12 (double x)
+{
+  return absbits (x) >> 52;
+}
+
+/* Store in *HI + *LO the remainder of X, with pi/4 < |X| < inf, by
+   pi/2, and return the quotient; only its low two bits matter.  */
+static inline int
+reduce (double x, double *hi, double *lo)
+{
+  double_t kd, r, w, y;
+  double yy[2];
+  int n;
+
+  if (likely (abstop12 (x) < 0x412))	/* |x| < 2^19 */
+    {
+#if TOINT_INTRINSICS
+      kd = roundtoint (x * InvPio2);
+      n = converttoint (x * InvPio2);
+#else
+      kd = eval_as_double (x * InvPio2 + Shift);
+      n = (int32_t) asuint64 (kd);
+      kd -= Shift;
+#endif
+      /* kd * Pio2_1 is exact, and so is the subtraction.  */
+      r = x - kd * Pio2_1;
+      w = kd * Pio2_1t;
+      y = r - w;
+      if (likely (abstop12 (x) - abstop12 (y) <= 16))
+	{
+	  *hi = y;
+	  *lo = (r - y) - w;
+	  return n;
+	}
+    }
+  n = __ieee754_rem_pio2 (x, yy);
+  *hi = yy[0];
+  *lo = yy[1];
+  return n;
+}
+
+/* sin (X + Y) for |X + Y| <= pi/4, |Y| tiny against X.  */
+static inline double
+sin_poly (double_t x, double_t y)
+{
+  double_t z, w, v, r;
+
+  z = x * x;
+  w = z * z;
+  v = z * x;
+  r = S[1] + z * (S[2] + z * S[3]) + z * w * (S[4] + z * S[5]);
+  return eval_as_double (x - ((z * (0.5 * y - v * r) - y) - v * S[0]));
+}
+
+/* cos (X + Y) likewise.  1 - x^2/2 is summed with its rounding error,
+   which keeps the result within an ulp up to pi/4.  */
+static inline double
+cos_poly (double_t x, double_t y)
+{
+  double_t z, w, r, hz, c;
+
+  z = x * x;
+  w = z * z;
+  r = z * (C[0] + z * (C[1] + z * C[2])) + w * w * (C[3] + z * (C[4] + z * C[5]));
+  hz = 0.5 * z;
+  c = 1.0 - hz;
+  return eval_as_double (c + (((1.0 - c) - hz) + (z * r - x * y)));
+}
+
+/* Both, sharing the powers of X.  */
+static inline void
+sincos_poly (double_t x, double_t y, double *sinp, double *cosp)
+{
+  double_t z, w, v, rs, rc, hz, c;
+
+  z = x * x;
+  w = z * z;
+  v = z * x;
+  rs = S[1] + z * (S[2] + z * S[3]) + z * w * (S[4] + z * S[5]);
+  rc = z * (C[0] + z * (C[1] + z * C[2])) + w * w * (C[3] + z * (C[4] + z * C[5]));
+  hz = 0.5 * z;
+  c = 1.0 - hz;
+  *sinp = eval_as_double (x - ((z * (0.5 * y - v * rs) - y) - v * S[0]));
+  *cosp = eval_as_double (c + (((1.0 - c) - hz) + (z * rc - x * y)));
+}
+
+/* tan (X + Y) if ODD is 0 and -1 / tan (X + Y) if it is 1.  Above
+   0.6744, tan (pi/4 - x) is evaluated instead, and -1/t is computed
+   with the division's error corrected, as fdlibm does.  */
+static inline double
+tan_poly (double_t x, double_t y, int odd)
+{
+  double_t z, w, r, v, s, a, a0, w0;
+  int big, sign;
+
+  big = absbits (x) >= 0x3fe5942800000000ULL;	/* 0.6744 */
+  sign = asuint64 (x) >> 63;
+  if (big)
+    {
+      if (sign)
+	{
+	  x = -x;
+	  y = -y;
+	}
+      x = (Pio4 - x) + (Pio4lo - y);
+      y = 0.0;
+    }
+  z = x * x;
+  w = z * z;
+  /* x^5 (T[1] + x^2 T[2] + ...) split into its odd and even powers of
+     x^2.  */
+  r = T[1] + w * (T[3] + w * (T[5] + w * (T[7] + w * (T[9] + w * T[11]))));
+  v = z * (T[2] + w * (T[4] + w * (T[6] + w * (T[8] + w * (T[10] + w * T[12])))));
+  s = z * x;
+  r = y + z * (s * (r + v) + y) + s * T[0];
+  w = x + r;
+  if (big)
+    {
+      s = 1 - 2 * odd;
+      v = s - 2.0 * (x + (r - w * w / (w + s)));
+      return eval_as_double (sign ? -v : v);
+    }
+  if (!odd)
+    return eval_as_double (w);
+  w0 = asdouble (asuint64 (w) & 0xffffffff00000000ULL);
+  v = r - (w0 - x);
+  a = -1.0 / w;
+  a0 = asdouble (asuint64 (a) & 0xffffffff00000000ULL);
+  return eval_as_double (a0 + a * (1.0 + a0 * w0 + a0 * v));
+}
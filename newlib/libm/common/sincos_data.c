@@ -0,0 +1,55 @@
+/* Shared data between sin, cos, sincos and tan.
+
+   The polynomials are the fdlibm ones, minimax on [-pi/4, pi/4]: sin is
+   x + x^3 (S1 + ...), cos is 1 - x^2/2 + x^4 (C1 + ...) and tan is
+   x + x^3 (T0 + ...).  */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH
+
+#include "math_config.h"
+
+const struct sincos_data __sincos_data = {
+// 2/pi
+.invpio2 = 0x1.45f306dc9c883p-1,
+// Adding and subtracting it rounds to an integer held in the low bits.
+.shift = 0x1.8p52,
+// pi/2, the first 33 bits and the rest
+.pio2_1 = 0x1.921fb54400000p0,
+.pio2_1t = 0x1.0b4611a626331p-34,
+// pi/4
+.pio4 = 0x1.921fb54442d18p-1,
+.pio4lo = 0x1.1a62633145c07p-55,
+.sin_poly = {
+-0x1.5555555555549p-3,
+0x1.111111110f8a6p-7,
+-0x1.a01a019c161d5p-13,
+0x1.71de357b1fe7dp-19,
+-0x1.ae5e68a2b9cebp-26,
+0x1.5d93a5acfd57cp-33,
+},
+.cos_poly = {
+0x1.555555555554cp-5,
+-0x1.6c16c16c15177p-10,
+0x1.a01a019cb1590p-16,
+-0x1.27e4f809c52adp-22,
+0x1.1ee9ebdb4b1c4p-29,
+-0x1.8fae9be8838d4p-37,
+},
+.tan_poly = {
+0x1.5555555555563p-2,
+0x1.111111110fe7ap-3,
+0x1.ba1ba1bb341fep-5,
+0x1.664f48406d637p-6,
+0x1.226e3e96e8493p-7,
+0x1.d6d22c9560328p-9,
+0x1.7dbc8fee08315p-10,
+0x1.344d8f2f26501p-11,
+0x1.026f71a8d1068p-12,
+0x1.47e88a03792a6p-14,
+0x1.2b80f32f0a7e9p-14,
+-0x1.375cbdb605373p-16,
+0x1.b2a7074bf7ad4p-16,
+},
+};
+#endif /* __OBSOLETE_MATH */
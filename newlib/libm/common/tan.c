@@ -0,0 +1,38 @@
+/* Double-precision tangent.  */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH
+
+#include <math.h>
+#include "math_config.h"
+#include "sincos.h"
+
+/* The reduction of sincos.h and the fdlibm tangent polynomial, which
+   gives -1/tan for odd quadrants directly.  Worst-case error is below
+   1 ULP.  */
+double
+tan (double x)
+{
+  double hi, lo;
+  uint64_t ix = absbits (x);
+  int n;
+
+  if (ix <= asuint64 (Pio4))
+    {
+      if (unlikely (ix < SMALL))
+	{
+	  if (unlikely (ix < 0x0010000000000000ULL))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      return tan_poly (x, 0.0, 0);
+    }
+  if (unlikely (ix >= 0x7ff0000000000000ULL))
+    return __math_invalid (x);
+
+  n = reduce (x, &hi, &lo);
+  return tan_poly (hi, lo, n & 1);
+}
+
+#endif /* __OBSOLETE_MATH */
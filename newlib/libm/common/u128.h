@@ -0,0 +1,194 @@
+/* u128.h -- 128-bit unsigned integer arithmetic without __int128.
+
+   Values wider than 64 bits are kept in a pair of 64-bit words, which
+   is read as two's complement where a sign is needed.  Products are
+   built from 32-bit halves and no count-leading-zeros instruction is
+   assumed, so these work on targets such as SBF.  Used by the integer
+   math kernels and by the fixed-point functions.  */
+
+#ifndef _U128_H_
+#define _U128_H_
+
+#include <stdint.h>
+
+typedef struct
+{
+  uint64_t hi;
+  uint64_t lo;
+} __u128;
+
+/* The full product of A and B; the low half is stored in *LO.  */
+static inline uint64_t
+__mul64 (uint64_t a, uint64_t b, uint64_t *lo)
+{
+  uint64_t a0 = (uint32_t) a, a1 = a >> 32;
+  uint64_t b0 = (uint32_t) b, b1 = b >> 32;
+  uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  uint64_t mid = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+
+  *lo = (mid << 32) | (uint32_t) p00;
+  return p11 + (mid >> 32) + (p01 >> 32) + (p10 >> 32);
+}
+
+static inline uint64_t
+__mulhi64 (uint64_t a, uint64_t b)
+{
+  uint64_t lo;
+
+  return __mul64 (a, b, &lo);
+}
+
+/* A * B / 2^63 for signed Q63 fixed-point A and B, truncated.  */
+static inline int64_t
+__mulq63 (int64_t a, int64_t b)
+{
+  uint64_t hi = __mulhi64 (a, b);
+
+  if (a < 0)
+    hi -= b;
+  if (b < 0)
+    hi -= a;
+  return (int64_t) (hi << 1);
+}
+
+static inline __u128
+__add128 (__u128 a, __u128 b)
+{
+  __u128 r;
+
+  r.lo = a.lo + b.lo;
+  r.hi = a.hi + b.hi + (r.lo < a.lo);
+  return r;
+}
+
+static inline __u128
+__sub128 (__u128 a, __u128 b)
+{
+  __u128 r;
+
+  r.lo = a.lo - b.lo;
+  r.hi = a.hi - b.hi - (a.lo < b.lo);
+  return r;
+}
+
+static inline __u128
+__neg128 (__u128 a)
+{
+  __u128 r;
+
+  r.lo = -a.lo;
+  r.hi = -a.hi - (a.lo != 0);
+  return r;
+}
+
+/* The top 128 bits of the 192-bit product of A and B.  */
+static inline __u128
+__mul128x64 (__u128 a, uint64_t b)
+{
+  uint64_t lo, hi1, hi2;
+  __u128 r;
+
+  hi1 = __mulhi64 (a.lo, b);
+  hi2 = __mul64 (a.hi, b, &lo);
+  r.lo = lo + hi1;
+  r.hi = hi2 + (r.lo < lo);
+  return r;
+}
+
+/* The top 128 bits of the 256-bit product of A and B.  */
+static inline __u128
+__mul128hi (__u128 a, __u128 b)
+{
+  uint64_t hh, hl, h2, l2, h3, l3, h4, mid, carry;
+  __u128 r;
+
+  hh = __mul64 (a.hi, b.hi, &hl);
+  h2 = __mul64 (a.hi, b.lo, &l2);
+  h3 = __mul64 (a.lo, b.hi, &l3);
+  h4 = __mulhi64 (a.lo, b.lo);
+  mid = l2 + l3;
+  carry = mid < l2;
+  mid += h4;
+  carry += mid < h4;
+  r.lo = hl + h2;
+  r.hi = hh + (r.lo < h2);
+  r.lo += h3;
+  r.hi += r.lo < h3;
+  r.lo += carry;
+  r.hi += r.lo < carry;
+  return r;
+}
+
+/* The same for A and B read as two's complement.  */
+static inline __u128
+__smul128hi (__u128 a, __u128 b)
+{
+  __u128 r = __mul128hi (a, b);
+
+  if ((int64_t) a.hi < 0)
+    r = __sub128 (r, b);
+  if ((int64_t) b.hi < 0)
+    r = __sub128 (r, a);
+  return r;
+}
+
+/* The number of leading zero bits in X, which is not zero.  */
+static inline int
+__clz64 (uint64_t x)
+{
+  int n = 0;
+
+  if ((x >> 32) == 0)
+    n += 32, x <<= 32;
+  if ((x >> 48) == 0)
+    n += 16, x <<= 16;
+  if ((x >> 56) == 0)
+    n += 8, x <<= 8;
+  if ((x >> 60) == 0)
+    n += 4, x <<= 4;
+  if ((x >> 62) == 0)
+    n += 2, x <<= 2;
+  if ((x >> 63) == 0)
+    n += 1;
+  return n;
+}
+
+/* A shifted left by N, 0 < N < 128.  */
+static inline __u128
+__shl128 (__u128 a, int n)
+{
+  __u128 r;
+
+  if (n >= 64)
+    {
+      r.hi = a.lo << (n - 64);
+      r.lo = 0;
+    }
+  else
+    {
+      r.hi = (a.hi << n) | (a.lo >> (64 - n));
+      r.lo = a.lo << n;
+    }
+  return r;
+}
+
+/* A shifted right by N, 0 < N < 128.  */
+static inline __u128
+__shr128 (__u128 a, int n)
+{
+  __u128 r;
+
+  if (n >= 64)
+    {
+      r.lo = a.hi >> (n - 64);
+      r.hi = 0;
+    }
+  else
+    {
+      r.lo = (a.lo >> n) | (a.hi << (64 - n));
+      r.hi = a.hi >> n;
+    }
+  return r;
+}
+
+#endif /* _U128_H_ */
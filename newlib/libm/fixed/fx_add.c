@@ -0,0 +1,84 @@
+/*
+FUNCTION
+<<fxq64_add>>, <<fxq64_sub>>, <<fxd18_add>>, <<fxd18_sub>>---add and subtract fixed-point numbers
+
+INDEX
+	fxq64_add
+INDEX
+	fxq64_sub
+INDEX
+	fxd18_add
+INDEX
+	fxd18_sub
+
+SYNOPSIS
+	#include <fixmath.h>
+	int fxq64_add(fxq64_t *<[r]>, fxq64_t <[x]>, fxq64_t <[y]>);
+	int fxq64_sub(fxq64_t *<[r]>, fxq64_t <[x]>, fxq64_t <[y]>);
+	int fxd18_add(fxd18_t *<[r]>, fxd18_t <[x]>, fxd18_t <[y]>);
+	int fxd18_sub(fxd18_t *<[r]>, fxd18_t <[x]>, fxd18_t <[y]>);
+
+	Link with -lm.
+
+DESCRIPTION
+These functions store <[x]> + <[y]> or <[x]> - <[y]> in <<*<[r]>>>.
+The results are exact.
+
+RETURNS
+Zero, or <<ERANGE>> if the result does not fit, in which case
+<<*<[r]>>> is not changed.  For <<fxd18_sub>> that includes every
+<[y]> greater than <[x]>.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+int
+fxq64_add (fxq64_t *r, fxq64_t x, fxq64_t y)
+{
+  uint64_t lo = x.lo + y.lo;
+  int64_t hi = (int64_t) ((uint64_t) x.hi + (uint64_t) y.hi + (lo < x.lo));
+
+  if (((x.hi ^ hi) & (y.hi ^ hi)) < 0)
+    return ERANGE;
+  r->hi = hi;
+  r->lo = lo;
+  return 0;
+}
+
+int
+fxq64_sub (fxq64_t *r, fxq64_t x, fxq64_t y)
+{
+  uint64_t lo = x.lo - y.lo;
+  int64_t hi = (int64_t) ((uint64_t) x.hi - (uint64_t) y.hi - (x.lo < y.lo));
+
+  if (((x.hi ^ y.hi) & (x.hi ^ hi)) < 0)
+    return ERANGE;
+  r->hi = hi;
+  r->lo = lo;
+  return 0;
+}
+
+int
+fxd18_add (fxd18_t *r, fxd18_t x, fxd18_t y)
+{
+  __u128 s = __add128 ((__u128) { x.hi, x.lo }, (__u128) { y.hi, y.lo });
+
+  if (s.hi < x.hi || (s.hi == x.hi && s.lo < x.lo))
+    return ERANGE;
+  r->hi = s.hi;
+  r->lo = s.lo;
+  return 0;
+}
+
+int
+fxd18_sub (fxd18_t *r, fxd18_t x, fxd18_t y)
+{
+  if (y.hi > x.hi || (y.hi == x.hi && y.lo > x.lo))
+    return ERANGE;
+  r->lo = x.lo - y.lo;
+  r->hi = x.hi - y.hi - (x.lo < y.lo);
+  return 0;
+}
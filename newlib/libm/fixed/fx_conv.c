@@ -0,0 +1,81 @@
+/*
+FUNCTION
+<<fxd18_from_uint>>, <<fxd18_from_q64>>, <<fxq64_from_d18>>---convert between fixed-point formats
+
+INDEX
+	fxd18_from_uint
+INDEX
+	fxd18_from_q64
+INDEX
+	fxq64_from_d18
+
+SYNOPSIS
+	#include <fixmath.h>
+	fxd18_t fxd18_from_uint(uint64_t <[n]>);
+	int fxd18_from_q64(fxd18_t *<[r]>, fxq64_t <[x]>, int <[rnd]>);
+	int fxq64_from_d18(fxq64_t *<[r]>, fxd18_t <[x]>, int <[rnd]>);
+
+	Link with -lm.
+
+DESCRIPTION
+<<fxd18_from_uint>> returns the integer <[n]> as a <<fxd18_t>>, which
+is exact.  A <<fxq64_t>> integer is just <<{ <[n]>, 0 }>>.
+
+<<fxd18_from_q64>> and <<fxq64_from_d18>> store <[x]> in the other
+format in <<*<[r]>>>, rounded in the direction <[rnd]> as for
+<<fxq64_mul>>.
+
+RETURNS
+<<fxd18_from_q64>> and <<fxq64_from_d18>> return zero, or <<ERANGE>>
+if the result does not fit, including a negative <[x]> that does not
+round to zero, or <<EDOM>> if <[rnd]> is not a rounding mode.  On an
+error <<*<[r]>>> is not changed.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+fxd18_t
+fxd18_from_uint (uint64_t n)
+{
+  fxd18_t r;
+
+  r.hi = __mul64 (n, __FX_D18, &r.lo);
+  return r;
+}
+
+int
+fxd18_from_q64 (fxd18_t *r, fxq64_t x, int rnd)
+{
+  uint64_t w[3];
+  __u128 q;
+  int neg = x.hi < 0;
+
+  if (!__FX_RNDOK (rnd))
+    return EDOM;
+  __fx_mul192 (w, __fx_absq64 (x), __FX_D18);
+  if (__fx_round (&q, w, 3, 64, neg, rnd) != 0
+      || (neg && (q.hi | q.lo) != 0))
+    return ERANGE;
+  r->hi = q.hi;
+  r->lo = q.lo;
+  return 0;
+}
+
+int
+fxq64_from_d18 (fxq64_t *r, fxd18_t x, int rnd)
+{
+  uint64_t n[3];
+  __u128 q;
+
+  if (!__FX_RNDOK (rnd))
+    return EDOM;
+  n[0] = 0;
+  n[1] = x.lo;
+  n[2] = x.hi;
+  if (__fx_divround (&q, n, 3, (__u128) { 0, __FX_D18 }, 0, rnd) != 0)
+    return ERANGE;
+  return __fx_setq64 (r, q, 0);
+}
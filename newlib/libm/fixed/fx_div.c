@@ -0,0 +1,173 @@
+/* fx_div.c -- division of wide integers.
+
+   Knuth's algorithm D (TAOCP vol. 2, 4.3.1) on 32-bit digits, so that
+   every step is a 64-bit by 32-bit division the target has.  */
+
+#include "local.h"
+
+#define B (1ULL << 32)
+
+static int
+clz32 (uint32_t x)
+{
+  return __clz64 ((uint64_t) x << 32);
+}
+
+/* Store in Q[0] to Q[NN - 1] the quotient of the NN-word number at N,
+   NN <= 4, by D, which is not zero, and return the remainder.  Words
+   are least significant first.  */
+__u128
+__fx_udivrem (uint64_t *q, const uint64_t *n, int nn, __u128 d)
+{
+  uint32_t un[9], vn[4], qd[8];
+  uint64_t qhat, rhat, p, r[2];
+  int64_t t, k;
+  int m, len, s, i, j;
+
+  m = 2 * nn;
+  for (i = 0; i < nn; i++)
+    {
+      un[2 * i] = (uint32_t) n[i];
+      un[2 * i + 1] = n[i] >> 32;
+    }
+  while (m > 0 && un[m - 1] == 0)
+    m--;
+  vn[0] = (uint32_t) d.lo;
+  vn[1] = d.lo >> 32;
+  vn[2] = (uint32_t) d.hi;
+  vn[3] = d.hi >> 32;
+  for (len = 4; vn[len - 1] == 0; len--)
+    ;
+  for (i = 0; i < 8; i++)
+    qd[i] = 0;
+
+  if (m < len)
+    {
+      /* The quotient is zero and the remainder N.  */
+      r[0] = n[0];
+      r[1] = nn > 1 ? n[1] : 0;
+    }
+  else if (len == 1)
+    {
+      uint64_t rem = 0;
+
+      for (j = m - 1; j >= 0; j--)
+	{
+	  uint64_t cur = rem * B + un[j];
+
+	  qd[j] = cur / vn[0];
+	  rem = cur - (uint64_t) qd[j] * vn[0];
+	}
+      r[0] = rem;
+      r[1] = 0;
+    }
+  else
+    {
+      /* Normalize so that the top digit of the divisor has its top bit
+	 set, which keeps each estimate at most two too large.  */
+      s = clz32 (vn[len - 1]);
+      if (s != 0)
+	{
+	  for (i = len - 1; i > 0; i--)
+	    vn[i] = vn[i] << s | vn[i - 1] >> (32 - s);
+	  vn[0] <<= s;
+	  un[m] = un[m - 1] >> (32 - s);
+	  for (i = m - 1; i > 0; i--)
+	    un[i] = un[i] << s | un[i - 1] >> (32 - s);
+	  un[0] <<= s;
+	}
+      else
+	un[m] = 0;
+
+      for (j = m - len; j >= 0; j--)
+	{
+	  uint64_t top = (uint64_t) un[j + len] * B + un[j + len - 1];
+
+	  qhat = top / vn[len - 1];
+	  rhat = top - qhat * vn[len - 1];
+	  while (qhat >= B
+		 || qhat * vn[len - 2] > rhat * B + un[j + len - 2])
+	    {
+	      qhat--;
+	      rhat += vn[len - 1];
+	      if (rhat >= B)
+		break;
+	    }
+
+	  /* Multiply and subtract.  */
+	  k = 0;
+	  for (i = 0; i < len; i++)
+	    {
+	      p = qhat * vn[i];
+	      t = un[i + j] - k - (int64_t) (p & 0xffffffff);
+	      un[i + j] = t;
+	      k = (p >> 32) - (t >> 32);
+	    }
+	  t = un[j + len] - k;
+	  un[j + len] = t;
+
+	  qd[j] = qhat;
+	  if (t < 0)
+	    {
+	      /* Subtracted once too often; add back.  */
+	      qd[j]--;
+	      k = 0;
+	      for (i = 0; i < len; i++)
+		{
+		  t = (uint64_t) un[i + j] + vn[i] + k;
+		  un[i + j] = t;
+		  k = t >> 32;
+		}
+	      un[j + len] += k;
+	    }
+	}
+
+      /* Unnormalize the remainder.  */
+      for (i = 0; i < len; i++)
+	un[i] = s != 0 ? un[i] >> s | un[i + 1] << (32 - s) : un[i];
+      for (i = len; i < 4; i++)
+	un[i] = 0;
+      r[0] = (uint64_t) un[1] << 32 | un[0];
+      r[1] = (uint64_t) un[3] << 32 | un[2];
+    }
+
+  for (i = 0; i < nn; i++)
+    q[i] = (uint64_t) qd[2 * i + 1] << 32 | qd[2 * i];
+  return (__u128) { r[1], r[0] };
+}
+
+/* Store in *Q the quotient of the NN-word number at N by D, which is
+   not zero, rounded in mode RND as the magnitude of a result with sign
+   NEG.  Returns ERANGE if it does not fit in 128 bits.  */
+int
+__fx_divround (__u128 *q, const uint64_t *n, int nn, __u128 d, int neg,
+	       int rnd)
+{
+  uint64_t w[4];
+  __u128 rem, rest;
+  int i, round, sticky;
+
+  rem = __fx_udivrem (w, n, nn, d);
+  for (i = 2; i < nn; i++)
+    if (w[i] != 0)
+      return ERANGE;
+
+  /* Compare the remainder with half the divisor as REM against
+     D - REM, which cannot overflow.  */
+  rest = __sub128 (d, rem);
+  sticky = (rem.hi | rem.lo) != 0;
+  if (rem.hi != rest.hi)
+    round = rem.hi > rest.hi;
+  else
+    round = rem.lo >= rest.lo;
+  if (round && rem.hi == rest.hi && rem.lo == rest.lo)
+    sticky = 0;
+  if (__fx_roundup (w[0] & 1, round, sticky, neg, rnd))
+    {
+      if (++w[0] == 0 && (nn < 2 || ++w[1] == 0))
+	return ERANGE;
+    }
+  q->lo = w[0];
+  q->hi = nn > 1 ? w[1] : 0;
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+FUNCTION
+<<fxq64_exp2>>, <<fxq64_exp>>, <<fxd18_exp2>>, <<fxd18_exp>>---exponentials of fixed-point numbers
+
+INDEX
+	fxq64_exp2
+INDEX
+	fxq64_exp
+INDEX
+	fxd18_exp2
+INDEX
+	fxd18_exp
+
+SYNOPSIS
+	#include <fixmath.h>
+	int fxq64_exp2(fxq64_t *<[r]>, fxq64_t <[x]>);
+	int fxq64_exp(fxq64_t *<[r]>, fxq64_t <[x]>);
+	int fxd18_exp2(fxd18_t *<[r]>, fxd18_t <[x]>);
+	int fxd18_exp(fxd18_t *<[r]>, fxd18_t <[x]>);
+
+	Link with -lm.
+
+DESCRIPTION
+These functions store 2 or e raised to the power <[x]> in <<*<[r]>>>,
+rounded to nearest.  The power is computed with a relative error below
+2^-120, so results below 2^55 are within one unit in the last place
+and nearly always correctly rounded, and larger ones keep that relative
+error.  Results too small to be represented are zero.  <<fxq64_exp2>>
+of an integer is exact.
+
+RETURNS
+Zero, or <<ERANGE>> if the result is too large, in which case
+<<*<[r]>>> is not changed.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+/* *R = 2^*T, or zero if that is too small to represent.  These are
+   used by the powers too.  */
+int
+__fx_expq64 (fxq64_t *r, const __fxval *t)
+{
+  __fxval v;
+
+  if (__fx_exp2 (&v, t) != 0)
+    {
+      if (!t->neg)
+	return ERANGE;
+      r->hi = 0;
+      r->lo = 0;
+      return 0;
+    }
+  return __fx_toq64 (r, &v);
+}
+
+int
+__fx_expd18 (fxd18_t *r, const __fxval *t)
+{
+  __fxval v;
+
+  if (__fx_exp2 (&v, t) != 0)
+    {
+      if (!t->neg)
+	return ERANGE;
+      r->hi = 0;
+      r->lo = 0;
+      return 0;
+    }
+  return __fx_tod18 (r, &v);
+}
+
+int
+fxq64_exp2 (fxq64_t *r, fxq64_t x)
+{
+  __fxval t;
+
+  __fx_fromq64 (&t, x);
+  return __fx_expq64 (r, &t);
+}
+
+int
+fxq64_exp (fxq64_t *r, fxq64_t x)
+{
+  __fxval t;
+
+  __fx_fromq64 (&t, x);
+  __fx_mul (&t, &t, &__fx_log2e);
+  return __fx_expq64 (r, &t);
+}
+
+int
+fxd18_exp2 (fxd18_t *r, fxd18_t x)
+{
+  __fxval t;
+
+  __fx_fromd18 (&t, x);
+  return __fx_expd18 (r, &t);
+}
+
+int
+fxd18_exp (fxd18_t *r, fxd18_t x)
+{
+  __fxval t;
+
+  __fx_fromd18 (&t, x);
+  __fx_mul (&t, &t, &__fx_log2e);
+  return __fx_expd18 (r, &t);
+}
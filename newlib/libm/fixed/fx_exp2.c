@@ -0,0 +1,145 @@
+/* fx_exp2.c -- exp2 in the working format.
+
+   Split t = n + f with n an integer and f in [0, 1) in Q128, and f
+   further into j/64 + u with u < 2^-6, so that
+
+     2^t = 2^n 2^(j/64) 2^u,
+
+   with 2^(j/64) from a table and 2^u - 1 = sum (u ln2)^k / k! summed to
+   fourteen terms in 128 bits.  */
+
+#include "local.h"
+
+/* 2^(j/64) in Q127 and (ln2)^k / k! in Q128.  */
+static const __u128 exp2tab[64] = {
+  { 0x8000000000000000, 0x0000000000000000 },
+  { 0x8164d1f3bc030773, 0x7be56527bd14def5 },
+  { 0x82cd8698ac2ba1d7, 0x3e2a475b46520bff },
+  { 0x843a28c3acde4046, 0x1af92eca13fd1582 },
+  { 0x85aac367cc487b14, 0xc5c95b8c2154c1b2 },
+  { 0x871f61969e8d1010, 0x3a1727c57b52a956 },
+  { 0x88980e8092da8527, 0x5df8d76c98c67563 },
+  { 0x8a14d575496efd9a, 0x080ca1d92c3680c2 },
+  { 0x8b95c1e3ea8bd6e6, 0xfbe4628758a53c90 },
+  { 0x8d1adf5b7e5ba9e5, 0xb4c7b4968e41ad36 },
+  { 0x8ea4398b45cd53c0, 0x2dc0144c8783d4c6 },
+  { 0x9031dc431466b1dc, 0x775814a8494e87e2 },
+  { 0x91c3d373ab11c336, 0x0fd6d8e0ae5ac9d8 },
+  { 0x935a2b2f13e6e92b, 0xd339940e9d924ee7 },
+  { 0x94f4efa8fef70961, 0x2e8afad12551de54 },
+  { 0x96942d3720185a00, 0x48ea9b683a9c22c5 },
+  { 0x9837f0518db8a96f, 0x46ad23182e42f6f6 },
+  { 0x99e0459320b7fa64, 0xe43086cb34b5fcaf },
+  { 0x9b8d39b9d54e5538, 0xa2a817a2a3cc3f1f },
+  { 0x9d3ed9a72cffb750, 0xde494cf050e99b0b },
+  { 0x9ef5326091a111ad, 0xa0911f09ebb9fdd1 },
+  { 0xa0b0510fb9714fc2, 0x192dc79edb0fd9a9 },
+  { 0xa27043030c496818, 0x9b7a04ef80cfdea8 },
+  { 0xa43515ae09e6809e, 0x0d1db4831781e1ef },
+  { 0xa5fed6a9b15138ea, 0x1cbd7f621710701b },
+  { 0xa7cd93b4e9653569, 0x9ec5b4d5039f72af },
+  { 0xa9a15ab4ea7c0ef8, 0x541e24ec3531fa73 },
+  { 0xab7a39b5a93ed337, 0x658023b2759e0079 },
+  { 0xad583eea42a14ac6, 0x4980a8c8f59a2ec4 },
+  { 0xaf3b78ad690a4374, 0xdf26101ccbb35033 },
+  { 0xb123f581d2ac258f, 0x87d037e96d215d8e },
+  { 0xb311c412a9112489, 0x3ecf14dc798a519c },
+  { 0xb504f333f9de6484, 0x597d89b3754abe9f },
+  { 0xb6fd91e328d17791, 0x07165f0ddd541a5a },
+  { 0xb8fbaf4762fb9ee9, 0x1b879778566b65a2 },
+  { 0xbaff5ab2133e45fb, 0x74d519d24593838c },
+  { 0xbd08a39f580c36be, 0xa8811fb66d0faf7a },
+  { 0xbf1799b67a731082, 0xe815d0abcbf0b851 },
+  { 0xc12c4cca66709456, 0x7c457d59a50087b5 },
+  { 0xc346ccda24976407, 0x20ec856128b83a42 },
+  { 0xc5672a115506dadd, 0x3e2ad0c964dd9f37 },
+  { 0xc78d74c8abb9b15c, 0xc13a2e3976c0277e },
+  { 0xc9b9bd866e2f27a2, 0x80e1f92a0511697e },
+  { 0xcbec14fef2727c5c, 0xf4907c8f45ebf6dd },
+  { 0xce248c151f8480e3, 0xe235838f95f2c6ed },
+  { 0xd06333daef2b2594, 0xd6d45c6559a4d502 },
+  { 0xd2a81d91f12ae45a, 0x12248e57c3de4028 },
+  { 0xd4f35aabcfedfa1f, 0x5921deffa6262c5b },
+  { 0xd744fccad69d6af4, 0x39a68bb9902d3fde },
+  { 0xd99d15c278afd7b5, 0xfe873deca3e12bac },
+  { 0xdbfbb797daf23755, 0x3d840d5a9e29aa64 },
+  { 0xde60f4825e0e9123, 0xdd07a2d9e8466859 },
+  { 0xe0ccdeec2a94e111, 0x065895048dd333ca },
+  { 0xe33f8972be8a5a51, 0x09bfe90795980eed },
+  { 0xe5b906e77c8348a8, 0x1e5e8f4a4edbb0ed },
+  { 0xe8396a503c4bdc68, 0x791790d0ac70c7de },
+  { 0xeac0c6e7dd24392e, 0xd02d75b3706e54fb },
+  { 0xed4f301ed9942b84, 0x600d2db6a64bfb12 },
+  { 0xefe4b99bdcdaf5cb, 0x46561cf6948db913 },
+  { 0xf281773c59ffb139, 0xe8980a9cc8f47a4b },
+  { 0xf5257d152486cc2c, 0x7b9d0c7aed980fc3 },
+  { 0xf7d0df730ad13bb8, 0xfe90d496d60fb6eb },
+  { 0xfa83b2db722a033a, 0x7c25bb14315d7fcd },
+  { 0xfd3e0c0cf486c174, 0x853f3a5931e0ee03 },
+};
+
+static const __u128 b[14] = {
+  { 0xb17217f7d1cf79ab, 0xc9e3b39803f2f6af },
+  { 0x3d7f7bff058b1d50, 0xde2d60dd92e6bf95 },
+  { 0x0e35846b82505fc5, 0x99d3b15d995e96f7 },
+  { 0x0276556df749cee5, 0x39977c16a7dd58a1 },
+  { 0x005761ff9e299cc4, 0x41c5fda69452fb0d },
+  { 0x000a184897c363c3, 0xb7a58544c3591a10 },
+  { 0x0000ffe5fe2c4586, 0x34358a8e643ec735 },
+  { 0x0000162c0223a5c8, 0x23fd8ffe606da77c },
+  { 0x000001b5253d395e, 0x7c3da4a70e5a4ff9 },
+  { 0x0000001e4cf5158b, 0x8ec9f6fda1d952e7 },
+  { 0x00000001e8cac735, 0x1bb24c0f57995e47 },
+  { 0x000000001c3bd650, 0xfc2985e2b5687e18 },
+  { 0x0000000001816193, 0x166d0f96281ac301 },
+  { 0x0000000000131496, 0x4d5878a973f14362 },
+};
+
+/* *R = 2^*T.  Returns ERANGE, leaving *R alone, if |*T| >= 2^15.  */
+int
+__fx_exp2 (__fxval *r, const __fxval *t)
+{
+  __u128 f, u, p, m;
+  int n, sh, j, k;
+
+  n = 0;
+  f.hi = f.lo = 0;
+  if ((t->m.hi | t->m.lo) != 0)
+    {
+      if (t->e >= -112)
+	return ERANGE;
+      sh = -t->e;
+      if (sh < 128)
+	{
+	  n = t->m.hi >> (sh - 64);
+	  f = __shl128 (t->m, 128 - sh);
+	}
+      else if (sh == 128)
+	f = t->m;
+      else if (sh < 256)
+	f = __shr128 (t->m, sh - 128);
+      if (t->neg)
+	{
+	  n = -n;
+	  if ((f.hi | f.lo) != 0)
+	    {
+	      n--;
+	      f = __neg128 (f);
+	    }
+	}
+    }
+
+  j = f.hi >> 58;
+  u.hi = f.hi & ((1ULL << 58) - 1);
+  u.lo = f.lo;
+  p = b[13];
+  for (k = 12; k >= 0; k--)
+    p = __add128 (b[k], __mul128hi (p, u));
+  p = __mul128hi (p, u);
+  m = __add128 (exp2tab[j], __mul128hi (exp2tab[j], p));
+
+  r->m = m;
+  r->e = n - 127;
+  r->neg = 0;
+  return 0;
+}
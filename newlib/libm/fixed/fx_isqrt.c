@@ -0,0 +1,69 @@
+/* fx_isqrt.c -- integer square root of a wide integer.  */
+
+#include "local.h"
+
+static uint64_t
+isqrt64 (uint64_t x)
+{
+  uint64_t s, t;
+
+  if (x == 0)
+    return 0;
+  s = 1ULL << (65 - __clz64 (x)) / 2;
+  while ((t = (s + x / s) / 2) < s)
+    s = t;
+  return s;
+}
+
+/* The square root of the 3-word number at N, least significant word
+   first, rounded down.  N minus its square is stored in *REM.
+
+   Newton's iteration decreases monotonically to the root from any
+   start above it; starting from the root of the top 64 bits, which is
+   good to 32 bits, it takes three or four divisions.  */
+__u128
+__fx_isqrt (const uint64_t *n, __u128 *rem)
+{
+  uint64_t top, q[3], w[4];
+  int len, h, bs;
+  __u128 s, t;
+
+  if (n[2] != 0)
+    len = 192 - __clz64 (n[2]);
+  else if (n[1] != 0)
+    len = 128 - __clz64 (n[1]);
+  else
+    len = n[0] != 0 ? 64 - __clz64 (n[0]) : 0;
+  if (len == 0)
+    {
+      *rem = (__u128) { 0, 0 };
+      return *rem;
+    }
+
+  /* The top of N, shifted by an even amount 2H to fit in 64 bits.  */
+  h = len > 64 ? (len - 63) / 2 : 0;
+  bs = 2 * h % 64;
+  top = n[2 * h / 64] >> bs;
+  if (bs != 0 && 2 * h / 64 < 2)
+    top |= n[2 * h / 64 + 1] << (64 - bs);
+
+  /* (isqrt64 (TOP) + 1) * 2^H is above the root of N.  */
+  s.hi = 0;
+  s.lo = isqrt64 (top) + 1;
+  if (h != 0)
+    s = __shl128 (s, h);
+
+  for (;;)
+    {
+      __fx_udivrem (q, n, 3, s);
+      t = __add128 (s, (__u128) { q[1], q[0] });
+      t = __shr128 (t, 1);
+      if (t.hi > s.hi || (t.hi == s.hi && t.lo >= s.lo))
+	break;
+      s = t;
+    }
+
+  __fx_mul256 (w, s, s);
+  *rem = __sub128 ((__u128) { n[1], n[0] }, (__u128) { w[1], w[0] });
+  return s;
+}
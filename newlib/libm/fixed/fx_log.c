@@ -0,0 +1,104 @@
+/*
+FUNCTION
+<<fxq64_log2>>, <<fxq64_ln>>, <<fxd18_log2>>, <<fxd18_ln>>---logarithms of fixed-point numbers
+
+INDEX
+	fxq64_log2
+INDEX
+	fxq64_ln
+INDEX
+	fxd18_log2
+INDEX
+	fxd18_ln
+
+SYNOPSIS
+	#include <fixmath.h>
+	int fxq64_log2(fxq64_t *<[r]>, fxq64_t <[x]>);
+	int fxq64_ln(fxq64_t *<[r]>, fxq64_t <[x]>);
+	int fxd18_log2(fxd18_t *<[r]>, fxd18_t <[x]>);
+	int fxd18_ln(fxd18_t *<[r]>, fxd18_t <[x]>);
+
+	Link with -lm.
+
+DESCRIPTION
+These functions store the base 2 or natural logarithm of <[x]> in
+<<*<[r]>>>, rounded to nearest.  The logarithm is computed to about
+120 bits, so the result is within one unit in the last place of the
+format, and is correctly rounded but for values very near a halfway
+point.  <<fxq64_log2>> of a power of two is exact.
+
+RETURNS
+Zero, or <<EDOM>> if <[x]> is negative, or <<ERANGE>> if <[x]> is zero
+or, for the <<fxd18_t>> functions, less than one, whose logarithm is
+negative.  On an error <<*<[r]>>> is not changed.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+static int
+logq64 (__fxval *v, fxq64_t x)
+{
+  if (x.hi < 0)
+    return EDOM;
+  if ((x.hi | x.lo) == 0)
+    return ERANGE;
+  __fx_log2 (v, (__u128) { x.hi, x.lo }, -64);
+  return 0;
+}
+
+static int
+logd18 (__fxval *v, fxd18_t x)
+{
+  __fxval t;
+
+  if ((x.hi | x.lo) == 0)
+    return ERANGE;
+  __fx_fromd18 (&t, x);
+  __fx_log2 (v, t.m, t.e);
+  return 0;
+}
+
+int
+fxq64_log2 (fxq64_t *r, fxq64_t x)
+{
+  __fxval v;
+  int err = logq64 (&v, x);
+
+  return err != 0 ? err : __fx_toq64 (r, &v);
+}
+
+int
+fxq64_ln (fxq64_t *r, fxq64_t x)
+{
+  __fxval v;
+  int err = logq64 (&v, x);
+
+  if (err != 0)
+    return err;
+  __fx_mul (&v, &v, &__fx_ln2);
+  return __fx_toq64 (r, &v);
+}
+
+int
+fxd18_log2 (fxd18_t *r, fxd18_t x)
+{
+  __fxval v;
+  int err = logd18 (&v, x);
+
+  return err != 0 ? err : __fx_tod18 (r, &v);
+}
+
+int
+fxd18_ln (fxd18_t *r, fxd18_t x)
+{
+  __fxval v;
+  int err = logd18 (&v, x);
+
+  if (err != 0)
+    return err;
+  __fx_mul (&v, &v, &__fx_ln2);
+  return __fx_tod18 (r, &v);
+}
@@ -0,0 +1,109 @@
+/*
+FUNCTION
+<<fxq64_mul>>, <<fxq64_div>>, <<fxd18_mul>>, <<fxd18_div>>---multiply and divide fixed-point numbers
+
+INDEX
+	fxq64_mul
+INDEX
+	fxq64_div
+INDEX
+	fxd18_mul
+INDEX
+	fxd18_div
+
+SYNOPSIS
+	#include <fixmath.h>
+	int fxq64_mul(fxq64_t *<[r]>, fxq64_t <[x]>, fxq64_t <[y]>, int <[rnd]>);
+	int fxq64_div(fxq64_t *<[r]>, fxq64_t <[x]>, fxq64_t <[y]>, int <[rnd]>);
+	int fxd18_mul(fxd18_t *<[r]>, fxd18_t <[x]>, fxd18_t <[y]>, int <[rnd]>);
+	int fxd18_div(fxd18_t *<[r]>, fxd18_t <[x]>, fxd18_t <[y]>, int <[rnd]>);
+
+	Link with -lm.
+
+DESCRIPTION
+These functions store <[x]> * <[y]> or <[x]> / <[y]> in <<*<[r]>>>,
+rounded in the direction <[rnd]>: <<FX_TONEAREST>> (ties to even),
+<<FX_TOWARDZERO>>, <<FX_UPWARD>> or <<FX_DOWNWARD>>.  The product or
+quotient is formed exactly before it is rounded, so the result is the
+representable number next to it in that direction.  Rounding up or
+down, rather than to nearest, is what keeps a sequence of payments or
+share computations from ever giving out more than it holds.
+
+RETURNS
+Zero, or <<ERANGE>> if the result does not fit, or <<EDOM>> if
+<[y]> is zero for a division or <[rnd]> is not one of the four
+modes.  On an error <<*<[r]>>> is not changed.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+static const __u128 d18 = { 0, __FX_D18 };
+
+int
+fxq64_mul (fxq64_t *r, fxq64_t x, fxq64_t y, int rnd)
+{
+  uint64_t w[4];
+  __u128 q;
+  int neg = (x.hi < 0) ^ (y.hi < 0);
+
+  if (!__FX_RNDOK (rnd))
+    return EDOM;
+  __fx_mul256 (w, __fx_absq64 (x), __fx_absq64 (y));
+  if (__fx_round (&q, w, 4, 64, neg, rnd) != 0)
+    return ERANGE;
+  return __fx_setq64 (r, q, neg);
+}
+
+int
+fxq64_div (fxq64_t *r, fxq64_t x, fxq64_t y, int rnd)
+{
+  uint64_t n[3];
+  __u128 d, q;
+  int neg = (x.hi < 0) ^ (y.hi < 0);
+
+  d = __fx_absq64 (y);
+  if (!__FX_RNDOK (rnd) || (d.hi | d.lo) == 0)
+    return EDOM;
+  q = __fx_absq64 (x);
+  n[0] = 0;
+  n[1] = q.lo;
+  n[2] = q.hi;
+  if (__fx_divround (&q, n, 3, d, neg, rnd) != 0)
+    return ERANGE;
+  return __fx_setq64 (r, q, neg);
+}
+
+int
+fxd18_mul (fxd18_t *r, fxd18_t x, fxd18_t y, int rnd)
+{
+  uint64_t w[4];
+  __u128 q;
+
+  if (!__FX_RNDOK (rnd))
+    return EDOM;
+  __fx_mul256 (w, (__u128) { x.hi, x.lo }, (__u128) { y.hi, y.lo });
+  if (__fx_divround (&q, w, 4, d18, 0, rnd) != 0)
+    return ERANGE;
+  r->hi = q.hi;
+  r->lo = q.lo;
+  return 0;
+}
+
+int
+fxd18_div (fxd18_t *r, fxd18_t x, fxd18_t y, int rnd)
+{
+  uint64_t n[3];
+  __u128 q;
+
+  if (!__FX_RNDOK (rnd) || (y.hi | y.lo) == 0)
+    return EDOM;
+  __fx_mul192 (n, (__u128) { x.hi, x.lo }, __FX_D18);
+  if (__fx_divround (&q, n, 3, (__u128) { y.hi, y.lo }, 0, rnd) != 0)
+    return ERANGE;
+  r->hi = q.hi;
+  r->lo = q.lo;
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+FUNCTION
+<<fxq64_pow>>, <<fxd18_pow>>---powers of fixed-point numbers
+
+INDEX
+	fxq64_pow
+INDEX
+	fxd18_pow
+
+SYNOPSIS
+	#include <fixmath.h>
+	int fxq64_pow(fxq64_t *<[r]>, fxq64_t <[x]>, fxq64_t <[y]>);
+	int fxd18_pow(fxd18_t *<[r]>, fxd18_t <[x]>, fxd18_t <[y]>);
+
+	Link with -lm.
+
+DESCRIPTION
+These functions store <[x]> raised to the power <[y]> in <<*<[r]>>>,
+rounded to nearest, as 2 raised to <[y]> times the base 2 logarithm of
+<[x]>.  The accuracy is that of <<fxq64_exp>>: a relative error below
+2^-120 before the final rounding.  Any number to the power zero is
+one, zero included, and results too small to be represented are
+zero.
+
+RETURNS
+Zero, or <<EDOM>> if <[x]> is negative, or <<ERANGE>> if the result is
+too large or <[x]> is zero and <[y]> negative.  On an error
+<<*<[r]>>> is not changed.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+int
+fxq64_pow (fxq64_t *r, fxq64_t x, fxq64_t y)
+{
+  __fxval l, t;
+
+  if ((y.hi | y.lo) == 0)
+    {
+      r->hi = 1;
+      r->lo = 0;
+      return 0;
+    }
+  if (x.hi < 0)
+    return EDOM;
+  if ((x.hi | x.lo) == 0)
+    {
+      if (y.hi < 0)
+	return ERANGE;
+      r->hi = 0;
+      r->lo = 0;
+      return 0;
+    }
+  __fx_log2 (&l, (__u128) { x.hi, x.lo }, -64);
+  __fx_fromq64 (&t, y);
+  __fx_mul (&t, &t, &l);
+  return __fx_expq64 (r, &t);
+}
+
+int
+fxd18_pow (fxd18_t *r, fxd18_t x, fxd18_t y)
+{
+  __fxval l, t;
+
+  if ((y.hi | y.lo) == 0)
+    {
+      *r = fxd18_from_uint (1);
+      return 0;
+    }
+  if ((x.hi | x.lo) == 0)
+    {
+      r->hi = 0;
+      r->lo = 0;
+      return 0;
+    }
+  __fx_fromd18 (&t, x);
+  __fx_log2 (&l, t.m, t.e);
+  __fx_fromd18 (&t, y);
+  __fx_mul (&t, &t, &l);
+  return __fx_expd18 (r, &t);
+}
@@ -0,0 +1,49 @@
+/* fx_round.c -- shift a wide integer right, rounding.  */
+
+#include "local.h"
+
+/* Store in *Q the NW-word number at W (least significant word first)
+   shifted right by SH bits, 0 <= SH <= 64 * NW, rounded in mode RND as
+   the magnitude of a result with sign NEG.  Returns ERANGE if that does
+   not fit in 128 bits.  */
+int
+__fx_round (__u128 *q, const uint64_t *w, int nw, int sh, int neg, int rnd)
+{
+  uint64_t r[3], sticky;
+  int ws = sh / 64, bs = sh % 64, round, i;
+
+  for (i = 0; i < 3; i++)
+    {
+      int k = ws + i;
+
+      r[i] = k < nw ? w[k] >> bs : 0;
+      if (bs != 0 && k + 1 < nw)
+	r[i] |= w[k + 1] << (64 - bs);
+    }
+  if (r[2] != 0)
+    return ERANGE;
+  for (i = ws + 3; i < nw; i++)
+    if (w[i] != 0)
+      return ERANGE;
+
+  round = 0;
+  sticky = 0;
+  if (sh != 0)
+    {
+      int rb = sh - 1;
+
+      round = w[rb / 64] >> (rb % 64) & 1;
+      for (i = 0; i < rb / 64; i++)
+	sticky |= w[i];
+      sticky |= w[rb / 64] & ((1ULL << (rb % 64)) - 1);
+    }
+  if (__fx_roundup (r[0] & 1, round, sticky != 0, neg, rnd))
+    {
+      r[0]++;
+      if (r[0] == 0 && ++r[1] == 0)
+	return ERANGE;
+    }
+  q->hi = r[1];
+  q->lo = r[0];
+  return 0;
+}
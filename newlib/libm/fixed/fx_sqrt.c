@@ -0,0 +1,83 @@
+/*
+FUNCTION
+<<fxq64_sqrt>>, <<fxd18_sqrt>>---square root of a fixed-point number
+
+INDEX
+	fxq64_sqrt
+INDEX
+	fxd18_sqrt
+
+SYNOPSIS
+	#include <fixmath.h>
+	int fxq64_sqrt(fxq64_t *<[r]>, fxq64_t <[x]>, int <[rnd]>);
+	int fxd18_sqrt(fxd18_t *<[r]>, fxd18_t <[x]>, int <[rnd]>);
+
+	Link with -lm.
+
+DESCRIPTION
+These functions store the square root of <[x]> in <<*<[r]>>>, rounded
+in the direction <[rnd]> as for <<fxq64_mul>>.  The result is the
+correctly rounded root.
+
+RETURNS
+Zero, or <<EDOM>> if <[x]> is negative or <[rnd]> is not a rounding
+mode, in which case <<*<[r]>>> is not changed.
+
+PORTABILITY
+The fixed-point functions are a newlib extension.
+*/
+
+#include "local.h"
+
+/* The root of N rounded in mode RND.  Since N - s^2 <= 2s, the root is
+   nearer s + 1 than s exactly when that remainder exceeds s; it is
+   never halfway.  */
+static __u128
+sqrtround (const uint64_t *n, int rnd)
+{
+  __u128 s, rem;
+  int up;
+
+  s = __fx_isqrt (n, &rem);
+  if (rnd == FX_UPWARD)
+    up = (rem.hi | rem.lo) != 0;
+  else if (rnd == FX_TONEAREST)
+    up = rem.hi > s.hi || (rem.hi == s.hi && rem.lo > s.lo);
+  else
+    up = 0;
+  if (up)
+    s = __add128 (s, (__u128) { 0, 1 });
+  return s;
+}
+
+int
+fxq64_sqrt (fxq64_t *r, fxq64_t x, int rnd)
+{
+  uint64_t n[3];
+  __u128 s;
+
+  if (!__FX_RNDOK (rnd) || x.hi < 0)
+    return EDOM;
+  n[0] = 0;
+  n[1] = x.lo;
+  n[2] = x.hi;
+  s = sqrtround (n, rnd);
+  r->hi = s.hi;
+  r->lo = s.lo;
+  return 0;
+}
+
+int
+fxd18_sqrt (fxd18_t *r, fxd18_t x, int rnd)
+{
+  uint64_t n[3];
+  __u128 s;
+
+  if (!__FX_RNDOK (rnd))
+    return EDOM;
+  __fx_mul192 (n, (__u128) { x.hi, x.lo }, __FX_D18);
+  s = sqrtround (n, rnd);
+  r->hi = s.hi;
+  r->lo = s.lo;
+  return 0;
+}
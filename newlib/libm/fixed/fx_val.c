@@ -0,0 +1,95 @@
+/* fx_val.c -- the working format of the logarithms and exponentials.  */
+
+#include "local.h"
+
+const __fxval __fx_ln2 = { { 0xb17217f7d1cf79ab, 0xc9e3b39803f2f6af }, -128, 0 };
+const __fxval __fx_log2e = { { 0xb8aa3b295c17f0bb, 0xbe87fed0691d3e89 }, -127, 0 };
+
+/* 10^-18.  */
+static const __fxval d18inv = { { 0x9392ee8e921d5d07, 0x3aff322e62439fcf }, -187, 0 };
+
+/* *R = *A * *B, truncated to 128 bits.  */
+void
+__fx_mul (__fxval *r, const __fxval *a, const __fxval *b)
+{
+  __u128 m = __mul128hi (a->m, b->m);
+
+  r->neg = a->neg ^ b->neg;
+  r->e = a->e + b->e + 128;
+  r->m = m;
+  if ((m.hi | m.lo) != 0 && m.hi >> 63 == 0)
+    {
+      r->m = __shl128 (m, 1);
+      r->e--;
+    }
+}
+
+void
+__fx_fromq64 (__fxval *r, fxq64_t x)
+{
+  r->m = __fx_absq64 (x);
+  r->e = -64;
+  r->neg = x.hi < 0;
+  __fx_normalize (r);
+}
+
+void
+__fx_fromd18 (__fxval *r, fxd18_t x)
+{
+  __fxval v;
+
+  v.m.hi = x.hi;
+  v.m.lo = x.lo;
+  v.e = 0;
+  v.neg = 0;
+  __fx_normalize (&v);
+  __fx_mul (r, &v, &d18inv);
+}
+
+/* Round *V to nearest into *R, or return ERANGE if it is out of
+   range.  */
+int
+__fx_toq64 (fxq64_t *r, const __fxval *v)
+{
+  uint64_t w[2];
+  __u128 q;
+  int sh = -(v->e + 64);
+
+  if ((v->m.hi | v->m.lo) == 0 || sh > 128)
+    {
+      r->hi = 0;
+      r->lo = 0;
+      return 0;
+    }
+  if (sh < 0)
+    return ERANGE;
+  w[0] = v->m.lo;
+  w[1] = v->m.hi;
+  if (__fx_round (&q, w, 2, sh, v->neg, FX_TONEAREST) != 0)
+    return ERANGE;
+  return __fx_setq64 (r, q, v->neg);
+}
+
+int
+__fx_tod18 (fxd18_t *r, const __fxval *v)
+{
+  uint64_t w[3];
+  __u128 q;
+  int sh = -v->e;
+
+  if ((v->m.hi | v->m.lo) == 0 || sh > 192)
+    q.hi = q.lo = 0;
+  else
+    {
+      if (sh < 0)
+	return ERANGE;
+      __fx_mul192 (w, v->m, __FX_D18);
+      if (__fx_round (&q, w, 3, sh, v->neg, FX_TONEAREST) != 0)
+	return ERANGE;
+      if (v->neg && (q.hi | q.lo) != 0)
+	return ERANGE;
+    }
+  r->hi = q.hi;
+  r->lo = q.lo;
+  return 0;
+}
@@ -0,0 +1,139 @@
+/* local.h -- internal interfaces of the fixed-point functions.
+
+   The logarithms and exponentials work on a 128-bit binary floating
+   format, __fxval, so that their precision does not depend on where
+   the binary point of the caller's format is.  Everything else is
+   integer arithmetic on 64-bit words.  */
+
+#ifndef _FIXED_LOCAL_H_
+#define _FIXED_LOCAL_H_
+
+#include <errno.h>
+#include <fixmath.h>
+#include "u128.h"
+
+/* (-1)^NEG * M * 2^E.  M has its top bit set, or is zero.  */
+typedef struct
+{
+  __u128 m;
+  int e;
+  int neg;
+} __fxval;
+
+#define __FX_RNDOK(rnd) ((unsigned) (rnd) <= FX_DOWNWARD)
+
+/* 10^18, the scale of fxd18_t.  */
+#define __FX_D18 1000000000000000000ULL
+
+/* Whether the magnitude of a result with sign NEG, whose last kept bit
+   is ODD and which is followed by the ROUND bit and the STICKY or of
+   all later bits, is to be incremented in rounding mode RND.  */
+static inline int
+__fx_roundup (int odd, int round, int sticky, int neg, int rnd)
+{
+  switch (rnd)
+    {
+    case FX_TOWARDZERO:
+      return 0;
+    case FX_UPWARD:
+      return !neg && (round | sticky);
+    case FX_DOWNWARD:
+      return neg && (round | sticky);
+    default:
+      return round && (sticky | odd);
+    }
+}
+
+/* Shift the top bit of V->M to the top.  */
+static inline void
+__fx_normalize (__fxval *v)
+{
+  int s;
+
+  if (v->m.hi != 0)
+    s = __clz64 (v->m.hi);
+  else if (v->m.lo != 0)
+    s = 64 + __clz64 (v->m.lo);
+  else
+    return;
+  if (s != 0)
+    v->m = __shl128 (v->m, s);
+  v->e -= s;
+}
+
+/* The full product of A and B in W[0] (least significant) to W[3].  */
+static inline void
+__fx_mul256 (uint64_t *w, __u128 a, __u128 b)
+{
+  uint64_t h0, l0, h1, l1, h2, l2, h3, l3, c;
+
+  h0 = __mul64 (a.lo, b.lo, &l0);
+  h1 = __mul64 (a.lo, b.hi, &l1);
+  h2 = __mul64 (a.hi, b.lo, &l2);
+  h3 = __mul64 (a.hi, b.hi, &l3);
+  w[0] = l0;
+  w[1] = h0 + l1;
+  c = w[1] < l1;
+  w[1] += l2;
+  c += w[1] < l2;
+  w[2] = h1 + c;
+  c = w[2] < c;
+  w[2] += h2;
+  c += w[2] < h2;
+  w[2] += l3;
+  c += w[2] < l3;
+  w[3] = h3 + c;
+}
+
+/* The product of A and B in W[0] to W[2].  */
+static inline void
+__fx_mul192 (uint64_t *w, __u128 a, uint64_t b)
+{
+  uint64_t h, l;
+
+  h = __mul64 (a.lo, b, &w[0]);
+  w[2] = __mul64 (a.hi, b, &l);
+  w[1] = h + l;
+  w[2] += w[1] < l;
+}
+
+/* The magnitude of a fxq64_t, and the fxq64_t of magnitude M and sign
+   NEG.  */
+static inline __u128
+__fx_absq64 (fxq64_t x)
+{
+  __u128 m = { (uint64_t) x.hi, x.lo };
+
+  return x.hi < 0 ? __neg128 (m) : m;
+}
+
+static inline int
+__fx_setq64 (fxq64_t *r, __u128 m, int neg)
+{
+  if (m.hi >> 63 && !(neg && m.hi == 1ULL << 63 && m.lo == 0))
+    return ERANGE;
+  if (neg)
+    m = __neg128 (m);
+  r->hi = (int64_t) m.hi;
+  r->lo = m.lo;
+  return 0;
+}
+
+extern int __fx_round (__u128 *, const uint64_t *, int, int, int, int);
+extern __u128 __fx_udivrem (uint64_t *, const uint64_t *, int, __u128);
+extern int __fx_divround (__u128 *, const uint64_t *, int, __u128, int, int);
+extern __u128 __fx_isqrt (const uint64_t *, __u128 *);
+
+extern void __fx_mul (__fxval *, const __fxval *, const __fxval *);
+extern void __fx_fromq64 (__fxval *, fxq64_t);
+extern void __fx_fromd18 (__fxval *, fxd18_t);
+extern int __fx_toq64 (fxq64_t *, const __fxval *);
+extern int __fx_tod18 (fxd18_t *, const __fxval *);
+extern void __fx_log2 (__fxval *, __u128, int);
+extern int __fx_exp2 (__fxval *, const __fxval *);
+extern int __fx_expq64 (fxq64_t *, const __fxval *);
+extern int __fx_expd18 (fxd18_t *, const __fxval *);
+
+extern const __fxval __fx_ln2, __fx_log2e;
+
+#endif /* _FIXED_LOCAL_H_ */
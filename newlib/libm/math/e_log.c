@@ -63,7 +63,7 @@
  */
 
 #include "fdlibm.h"
-#if __OBSOLETE_MATH
+#if __OBSOLETE_MATH && !defined (_INTEGER_MATH)
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -60,7 +60,7 @@
 #include "fdlibm.h"
 #include "math_config.h"
 
-#if __OBSOLETE_MATH
+#if __OBSOLETE_MATH && !defined (_INTEGER_MATH)
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -83,7 +83,7 @@
 
 #include "fdlibm.h"
 
-#ifndef _DOUBLE_IS_32BITS
+#if !defined (_DOUBLE_IS_32BITS) && !defined (_INTEGER_MATH)
 
 #ifdef __STDC__
 static	const volatile double	one	= 1.0, tiny=1.0e-300;
@@ -192,7 +192,7 @@ static	double	volatile one	= 1.0, tiny=1.0e-300;
 	return z;
 }
  
-#endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* !_DOUBLE_IS_32BITS && !_INTEGER_MATH */
 
 /*
 Other methods  (use floating-point arithmetic)
@@ -0,0 +1,33 @@
+/* ei_exp.c -- exp on integers.
+
+   exp(x) = 2^(x * log2(e)), with the product formed exactly enough in
+   128 bits and handed to __ki_exp2.  Used in place of e_exp.c and
+   w_exp.c when _INTEGER_MATH is defined.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+/* log2(e) in Q127.  */
+static const __u128 log2e = { 0xb8aa3b295c17f0bb, 0xbe87fed0691d3e89 };
+
+double
+exp (double x)
+{
+  uint64_t ix, mx, f;
+  int ex, n;
+
+  ix = asuint64 (x);
+  if ((ix >> 52 & 0x7ff) == 0x7ff)
+    {
+      if (ix == asuint64 (-INFINITY))
+	return 0.0;
+      return 1.0 + x;
+    }
+  mx = __ki_mant (ix, &ex);
+  if (__ki_mulsplit (mx, ex, ix >> 63, log2e, 127, &n, &f))
+    return ix >> 63 ? __math_uflow (0) : __math_oflow (0);
+  return __ki_exp2 (n, f, 0);
+}
+
+#endif /* _INTEGER_MATH */
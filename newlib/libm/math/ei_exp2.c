@@ -0,0 +1,32 @@
+/* ei_exp2.c -- exp2 on integers.
+
+   The argument is split exactly into its integer and fractional parts
+   for __ki_exp2.  Used in place of w_exp2.c when _INTEGER_MATH is
+   defined.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+static const __u128 one = { 0x8000000000000000, 0 };
+
+double
+exp2 (double x)
+{
+  uint64_t ix, mx, f;
+  int ex, n;
+
+  ix = asuint64 (x);
+  if ((ix >> 52 & 0x7ff) == 0x7ff)
+    {
+      if (ix == asuint64 (-INFINITY))
+	return 0.0;
+      return 1.0 + x;
+    }
+  mx = __ki_mant (ix, &ex);
+  if (__ki_mulsplit (mx, ex, ix >> 63, one, 127, &n, &f))
+    return ix >> 63 ? __math_uflow (0) : __math_oflow (0);
+  return __ki_exp2 (n, f, 0);
+}
+
+#endif /* _INTEGER_MATH */
@@ -0,0 +1,34 @@
+/* ei_log.c -- log on integers.
+
+   log(x) = log2(x) * ln2, both in 128 bits.  Used in place of e_log.c
+   and w_log.c when _INTEGER_MATH is defined.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+/* ln2 in Q128.  */
+static const __u128 ln2 = { 0xb17217f7d1cf79ab, 0xc9e3b39803f2f6af };
+
+double
+log (double x)
+{
+  uint64_t ix, sign;
+  __u128 m;
+  int scale;
+
+  ix = asuint64 (x);
+  if (ix - 1 >= 0x7ff0000000000000 - 1)
+    {
+      /* x is zero, negative, infinite or nan.  */
+      if (ix * 2 == 0)
+	return __math_divzero (1);
+      if (ix == asuint64 (INFINITY))
+	return x;
+      return __math_invalid (x);
+    }
+  scale = __ki_log2 (ix, &m, &sign);
+  return __ki_todouble (__mul128hi (m, ln2), scale, sign);
+}
+
+#endif /* _INTEGER_MATH */
@@ -0,0 +1,31 @@
+/* ei_log2.c -- log2 on integers.
+
+   Used in place of s_log2.c, which divides log(x) by ln2, when
+   _INTEGER_MATH is defined.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+double
+log2 (double x)
+{
+  uint64_t ix, sign;
+  __u128 m;
+  int scale;
+
+  ix = asuint64 (x);
+  if (ix - 1 >= 0x7ff0000000000000 - 1)
+    {
+      /* x is zero, negative, infinite or nan.  */
+      if (ix * 2 == 0)
+	return __math_divzero (1);
+      if (ix == asuint64 (INFINITY))
+	return x;
+      return __math_invalid (x);
+    }
+  scale = __ki_log2 (ix, &m, &sign);
+  return __ki_todouble (m, scale, sign);
+}
+
+#endif /* _INTEGER_MATH */
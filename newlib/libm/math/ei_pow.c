@@ -0,0 +1,97 @@
+/* ei_pow.c -- pow on integers.
+
+   pow(x, y) = 2^(y * log2|x|), with log2|x| from __ki_log2 good to
+   2^-76 relative, so that the product keeps about 62 bits even for
+   |y * log2|x|| near the overflow threshold.  The special cases are
+   those of the C standard, as in pow.c.  Used in place of e_pow.c and
+   w_pow.c when _INTEGER_MATH is defined.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+/* Returns 0 if not int, 1 if odd int, 2 if even int.  The argument is
+   the bit representation of a non-zero finite floating-point value.  */
+static inline int
+checkint (uint64_t iy)
+{
+  int e = iy >> 52 & 0x7ff;
+  if (e < 0x3ff)
+    return 0;
+  if (e > 0x3ff + 52)
+    return 2;
+  if (iy & ((1ULL << (0x3ff + 52 - e)) - 1))
+    return 0;
+  if (iy & (1ULL << (0x3ff + 52 - e)))
+    return 1;
+  return 2;
+}
+
+/* Returns 1 if input is the bit representation of 0, infinity or nan.  */
+static inline int
+zeroinfnan (uint64_t i)
+{
+  return 2 * i - 1 >= 2 * asuint64 (INFINITY) - 1;
+}
+
+double
+pow (double x, double y)
+{
+  uint64_t ix, iy, my, f, sign, lsign;
+  __u128 l;
+  int ey, n, scale;
+
+  ix = asuint64 (x);
+  iy = asuint64 (y);
+  sign = 0;
+  if (zeroinfnan (iy))
+    {
+      if (2 * iy == 0)
+	return issignaling_inline (x) ? x + y : 1.0;
+      if (ix == asuint64 (1.0))
+	return issignaling_inline (y) ? x + y : 1.0;
+      if (2 * ix > 2 * asuint64 (INFINITY)
+	  || 2 * iy > 2 * asuint64 (INFINITY))
+	return x + y;
+      if (2 * ix == 2 * asuint64 (1.0))
+	return 1.0;
+      if ((2 * ix < 2 * asuint64 (1.0)) == !(iy >> 63))
+	return 0.0; /* |x|<1 && y==inf or |x|>1 && y==-inf.  */
+      return INFINITY;
+    }
+  if (zeroinfnan (ix))
+    {
+      if (2 * ix > 2 * asuint64 (INFINITY))
+	return x + y;
+      if (ix >> 63 && checkint (iy) == 1)
+	sign = 1;
+      /* Zero to a negative power is a pole, infinity to a negative
+	 power is zero.  */
+      if (2 * ix == 0 && iy >> 63)
+	return __math_divzero (sign);
+      if ((2 * ix == 0) == !(iy >> 63))
+	return asdouble (sign << 63);
+      return asdouble (sign << 63 | asuint64 (INFINITY));
+    }
+  if (ix >> 63)
+    {
+      /* Finite x < 0.  */
+      int yint = checkint (iy);
+      if (yint == 0)
+	return __math_invalid (x);
+      if (yint == 1)
+	sign = 1;
+      ix &= 0x7fffffffffffffff;
+    }
+
+  scale = __ki_log2 (ix, &l, &lsign);
+  if (l.hi == 0)
+    return asdouble (sign << 63 | asuint64 (1.0));
+  my = __ki_mant (iy, &ey);
+  lsign ^= iy >> 63;
+  if (__ki_mulsplit (my, ey, lsign, l, scale, &n, &f))
+    return lsign ? __math_uflow (sign) : __math_oflow (sign);
+  return __ki_exp2 (n, f, sign);
+}
+
+#endif /* _INTEGER_MATH */
@@ -0,0 +1,91 @@
+/* ei_sqrt.c -- __ieee754_sqrt on integers.
+
+   Return correctly rounded sqrt, as e_sqrt.c does, in a few integer
+   divisions instead of one loop iteration per bit.  Used in place of
+   e_sqrt.c when _INTEGER_MATH is defined.
+
+   Method:
+	Scale x to m * 2^(2k) with m in [2^52, 2^54), so that
+	sqrt(x) = sqrt(m * 2^52) * 2^(k - 26) and sqrt(m * 2^52) has 53
+	bits.  Three Newton steps from a table estimate give
+	r = floor(sqrt(m * 2^10)), and one more step at full width gives
+	s within one of sqrt(m * 2^52).  The remainder m * 2^52 - s^2,
+	which is small enough to be computed modulo 2^64, then moves s to
+	the floor of the root and decides the rounding; a root of an
+	integer is never half way between two integers.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+/* sqrt(i + 4.5) * 2^30, an estimate of sqrt(t) for t in
+   [(i + 4) * 2^60, (i + 5) * 2^60).  */
+static const uint32_t rsqrt_est[12] = {
+  0x87c3b667, 0x9617e2cb, 0xa32b2af9, 0xaf456e92, 0xba97286e, 0xc542e128,
+  0xcf623a51, 0xd908d8e4, 0xe2463001, 0xeb26a8f0, 0xf3b469cd, 0xfbf7df5c
+};
+
+double
+__ieee754_sqrt (double x)
+{
+  uint64_t ix, m, t, r, s;
+  int64_t d;
+  int e;
+
+  ix = asuint64 (x);
+  if (ix - 0x0010000000000000 >= 0x7ff0000000000000 - 0x0010000000000000)
+    {
+      /* x is zero, subnormal, negative, infinite or nan.  */
+      if (ix * 2 == 0)
+	return x;
+      if (ix >> 63)
+	return (x - x) / (x - x);
+      if (ix >= 0x7ff0000000000000)
+	return x + x;
+    }
+
+  /* x = m * 2^e with e even.  */
+  m = __ki_mant (ix, &e);
+  if (m < 0x0010000000000000)
+    {
+      int j = __clz64 (m) - 11;
+      m <<= j;
+      e -= j;
+    }
+  if (e & 1)
+    {
+      m <<= 1;
+      e--;
+    }
+
+  /* r = floor(sqrt(t)), t = m * 2^10 in [2^62, 2^64).  */
+  t = m << 10;
+  r = rsqrt_est[(t >> 60) - 4];
+  r = (r + t / r) >> 1;
+  r = (r + t / r) >> 1;
+  r = (r + t / r) >> 1;
+  if (r > 0xffffffff)
+    r = 0xffffffff;
+  while (r * r > t)
+    r--;
+
+  /* sqrt(m * 2^52) ~= r * 2^21 + (t - r^2) * 2^20 / r.  */
+  s = (r << 21) + ((t - r * r) << 20) / r;
+  d = (int64_t) ((m << 52) - s * s);
+  while (d < 0)
+    {
+      d += 2 * s - 1;
+      s--;
+    }
+  while (d > (int64_t) (2 * s))
+    {
+      s++;
+      d -= 2 * s - 1;
+    }
+  if (d > (int64_t) s)
+    s++;
+
+  return asdouble (((uint64_t) ((e - 52) / 2 + 0x432) << 52) + s);
+}
+
+#endif /* _INTEGER_MATH */
@@ -0,0 +1,59 @@
+/* intmath.h -- fixed-point support for the integer math kernels.
+
+   With --enable-newlib-integer-math (_INTEGER_MATH) sqrt, exp, exp2,
+   log, log2 and pow are computed on the bit patterns of their
+   arguments, using only integer operations, instead of by the fdlibm
+   code.  On a target with no floating point unit every double
+   operation is a library call, so this is several times cheaper.
+
+   Values wider than 64 bits are kept in the __u128 pairs of u128.h.  */
+
+#ifndef _INTMATH_H_
+#define _INTMATH_H_
+
+#include <stdint.h>
+#include "fdlibm.h"
+#include "u128.h"
+
+#ifdef _INTEGER_MATH
+
+/* The significand of the finite double with bit pattern IX, scaled
+   so that the value is the result times 2^*E, ignoring the sign.  */
+static inline uint64_t
+__ki_mant (uint64_t ix, int *e)
+{
+  int top = (ix >> 52) & 0x7ff;
+
+  ix &= 0x000fffffffffffff;
+  if (top == 0)
+    {
+      *e = -1074;
+      return ix;
+    }
+  *e = top - 1075;
+  return ix | 0x0010000000000000;
+}
+
+/* log2 of the positive finite double with bit pattern IX, as
+   (-1)^*SIGN * *M * 2^-scale, where scale is returned.  *M has its top
+   bit set, or is zero if the argument is 1.  */
+extern int __ki_log2 (uint64_t ix, __u128 *m, uint64_t *sign);
+
+/* The double nearest to M * 2^-SCALE, with SIGN as its sign bit.  The
+   result must be in the normal range.  */
+extern double __ki_todouble (__u128 m, int scale, uint64_t sign);
+
+/* Split (-1)^NEG * MY * 2^EY * V * 2^-SCALE into an integer part *N
+   and a Q64 fraction *F, rounding towards minus infinity.  V must have
+   its top bit set.  Returns nonzero, leaving *N and *F alone, if the
+   magnitude is at least 2048.  */
+extern int __ki_mulsplit (uint64_t my, int ey, int neg, __u128 v, int scale,
+			  int *n, uint64_t *f);
+
+/* 2^(N + F * 2^-64) with SIGN as its sign bit, with overflow and
+   underflow reported as for exp.  */
+extern double __ki_exp2 (int n, uint64_t f, uint64_t sign);
+
+#endif /* _INTEGER_MATH */
+
+#endif /* _INTMATH_H_ */
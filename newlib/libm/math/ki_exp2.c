@@ -0,0 +1,175 @@
+/* ki_exp2.c -- integer exp2 kernel.
+
+   __ki_exp2 (n, f, sign) computes 2^(n + f * 2^-64), f in Q64, as a
+   double with sign bit SIGN.
+
+   Method:
+	The top seven bits of f pick 2^(j/128) from a table, and the rest,
+	u < 2^-7, is handled by
+		2^u - 1 = a1 u + a2 u^2 + ... + a6 u^6,  ai = ln2^i / i!,
+	evaluated in unsigned Q64 on u * 2^7.  The product has more than
+	62 correct bits, and is rounded once, into the subnormal range if
+	need be, so the result is within 0.51 ulp.
+
+   __ki_mulsplit (my, ey, neg, v, scale, n, f) forms the argument of
+   __ki_exp2 from the product of a double and a 128-bit value, for exp
+   (v = log2(e)), exp2 (v = 1) and pow (v = log2(x)).  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+/* 2^(j/128) in Q63.  */
+static const uint64_t exp2tab[128] = {
+  0x8000000000000000, 0x80b1ed4fd999ab6c, 0x8164d1f3bc030773,
+  0x8218af4373fc25ec, 0x82cd8698ac2ba1d7, 0x8383594eefb6ee37,
+  0x843a28c3acde4046, 0x84f1f656379c1a29, 0x85aac367cc487b15,
+  0x8664915b923fba04, 0x871f61969e8d1010, 0x87db357ff698d792,
+  0x88980e8092da8527, 0x8955ee03618e5fdd, 0x8a14d575496efd9a,
+  0x8ad4c6452c728924, 0x8b95c1e3ea8bd6e7, 0x8c57c9c4646f4dde,
+  0x8d1adf5b7e5ba9e6, 0x8ddf042022e69cd6, 0x8ea4398b45cd53c0,
+  0x8f6a8117e6c8e5c4, 0x9031dc431466b1dc, 0x90fa4c8beee4b12b,
+  0x91c3d373ab11c336, 0x928e727d9531f9ac, 0x935a2b2f13e6e92c,
+  0x9426ff0fab1c04b6, 0x94f4efa8fef70961, 0x95c3fe86d6cc7fef,
+  0x96942d3720185a00, 0x97657d49f17ab08e, 0x9837f0518db8a96f,
+  0x990b87e266c189aa, 0x99e0459320b7fa65, 0x9ab62afc94ff864a,
+  0x9b8d39b9d54e5539, 0x9c6573682ec32c2d, 0x9d3ed9a72cffb751,
+  0x9e196e189d472420, 0x9ef5326091a111ae, 0x9fd228256400dd06,
+  0xa0b0510fb9714fc2, 0xa18faeca8544b6e4, 0xa27043030c496819,
+  0xa3520f68e802bb93, 0xa43515ae09e6809e, 0xa5195786be9ef339,
+  0xa5fed6a9b15138ea, 0xa6e594cfeee86b1e, 0xa7cd93b4e965356a,
+  0xa8b6d5167b320e09, 0xa9a15ab4ea7c0ef8, 0xaa8d2652ec907629,
+  0xab7a39b5a93ed337, 0xac6896a4be3fe929, 0xad583eea42a14ac6,
+  0xae493452ca35b80e, 0xaf3b78ad690a4375, 0xb02f0dcbb6e04584,
+  0xb123f581d2ac2590, 0xb21a31a66618fe3b, 0xb311c412a9112489,
+  0xb40aaea2654b9841, 0xb504f333f9de6484, 0xb60093a85ed5f76c,
+  0xb6fd91e328d17791, 0xb7fbefca8ca41e7c, 0xb8fbaf4762fb9ee9,
+  0xb9fcd2452c0b9deb, 0xbaff5ab2133e45fb, 0xbc034a7ef2e9fb0d,
+  0xbd08a39f580c36bf, 0xbe0f6809860993e2, 0xbf1799b67a731083,
+  0xc0213aa1f0d08db0, 0xc12c4cca66709456, 0xc238d2311e3d6673,
+  0xc346ccda24976407, 0xc4563ecc5334cb33, 0xc5672a115506dadd,
+  0xc67990b5aa245f79, 0xc78d74c8abb9b15d, 0xc8a2d85c8ffe2c45,
+  0xc9b9bd866e2f27a3, 0xcad2265e4290774e, 0xcbec14fef2727c5d,
+  0xcd078b86503dcdd2, 0xce248c151f8480e4, 0xcf4318cf191918c1,
+  0xd06333daef2b2595, 0xd184df6251699ac6, 0xd2a81d91f12ae45a,
+  0xd3ccf099859ac379, 0xd4f35aabcfedfa1f, 0xd61b5dfe9f9bce07,
+  0xd744fccad69d6af4, 0xd870394c6db32c84, 0xd99d15c278afd7b6,
+  0xdacb946f2ac9cc72, 0xdbfbb797daf23755, 0xdd2d818508324c20,
+  0xde60f4825e0e9124, 0xdf9612deb8f04420, 0xe0ccdeec2a94e111,
+  0xe2055afffe83d369, 0xe33f8972be8a5a51, 0xe47b6ca0373da88d,
+  0xe5b906e77c8348a8, 0xe6f85aaaee1fce22, 0xe8396a503c4bdc68,
+  0xe97c38406c4f8c57, 0xeac0c6e7dd24392f, 0xec0718b64c1cbddc,
+  0xed4f301ed9942b84, 0xee990f980da3025b, 0xefe4b99bdcdaf5cb,
+  0xf13230a7ad094509, 0xf281773c59ffb13a, 0xf3d28fde3a641a5b,
+  0xf5257d152486cc2c, 0xf67a416c733f846e, 0xf7d0df730ad13bb9,
+  0xf92959bb5dd4ba74, 0xfa83b2db722a033a, 0xfbdfed6ce5f09c49,
+  0xfd3e0c0cf486c175, 0xfe9e115c7b8f884c
+};
+
+/* ln2^i / i! * 2^(-7i) in Q64.  */
+static const uint64_t a[6] = {
+  0x0162e42fefa39ef3, 0x0000f5fdeffc162c, 0x00000071ac235c13,
+  0x00000000276556df, 0x00000000000aec40, 0x0000000000000286
+};
+
+int
+__ki_mulsplit (uint64_t my,
+	int ey,
+	int neg,
+	__u128 v,
+	int scale,
+	int *n,
+	uint64_t *f)
+{
+  __u128 w;
+  int bits, sh;
+  uint64_t ip, fp;
+
+  /* z * 2^64 = (my * v / 2^64) * 2^(128 + ey - scale).  */
+  w = __mul128x64 (v, my);
+  sh = scale - 128 - ey;
+  if (w.hi == 0 && w.lo == 0)
+    bits = 0;
+  else if (w.hi != 0)
+    bits = 128 - __clz64 (w.hi);
+  else
+    bits = 64 - __clz64 (w.lo);
+  if (bits - sh > 75)
+    return 1;
+  if (sh >= 128)
+    w.hi = w.lo = 0;
+  else if (sh > 0)
+    w = __shr128 (w, sh);
+  else if (sh < 0)
+    w = __shl128 (w, -sh);
+
+  ip = w.hi;
+  fp = w.lo;
+  if (neg)
+    {
+      *n = -(int) ip - (fp != 0);
+      *f = -fp;
+    }
+  else
+    {
+      *n = (int) ip;
+      *f = fp;
+    }
+  return 0;
+}
+
+double
+__ki_exp2 (int n,
+	uint64_t f,
+	uint64_t sign)
+{
+  uint64_t u, p, t, mant, rest, half;
+  int j, sh;
+
+  u = f << 7;
+  p = a[5];
+  for (j = 4; j >= 0; j--)
+    p = a[j] + __mulhi64 (p, u);
+  p = __mulhi64 (p, u);
+  t = exp2tab[f >> 57];
+  mant = t + __mulhi64 (t, p);
+
+  if (n > 1023)
+    return __math_oflow (sign);
+  if (n >= -1022)
+    {
+      /* mant in [2^63, 2^64): round off eleven bits.  */
+      sh = 11;
+      u = (uint64_t) (n + 0x3fe) << 52;
+    }
+  else
+    {
+      /* Subnormal: the exponent field stays zero unless rounding
+	 carries into it.  */
+      sh = -1011 - n;
+      u = 0;
+      if (sh > 64)
+	return __math_uflow (sign);
+    }
+  if (sh == 64)
+    {
+      rest = mant;
+      mant = 0;
+    }
+  else
+    {
+      rest = mant & ((1ULL << sh) - 1);
+      mant >>= sh;
+    }
+  half = 1ULL << (sh - 1);
+  if (rest > half || (rest == half && (mant & 1)))
+    mant++;
+  u += mant;
+  if (u == 0)
+    return __math_uflow (sign);
+  if (u >= 0x7ff0000000000000)
+    return __math_oflow (sign);
+  return asdouble ((sign << 63) | u);
+}
+
+#endif /* _INTEGER_MATH */
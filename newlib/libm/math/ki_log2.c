@@ -0,0 +1,292 @@
+/* ki_log2.c -- integer log2 kernel.
+
+   __ki_log2 (ix, m, sign) computes log2 of the positive finite double
+   with bit pattern IX as (-1)^*SIGN * *M * 2^-scale, where scale is the
+   return value and *M is zero or has its top bit set.
+
+   Method:
+	Write x = 2^k * z with z in [0.6875, 1.375), so that x close to 1
+	has k = 0.  The top seven fraction bits of x pick a subinterval of
+	z, whose approximate reciprocal invc has 11 bits.  Then
+		log2(x) = k - log2(invc) + log2(1 + r),  r = z * invc - 1,
+	where r is exact in 64 bits and |r| < 2^-7.  The two intervals
+	next to 1 use invc = 1, so for x near 1 the result is r times a
+	series and keeps its relative precision.
+		log2(1 + r) = r * (c1 - c2 * r + r^2 * Q(r)),
+	c1 = 1/ln2 and c2 = 1/(2 ln2) are 128-bit and Q, of degree 8, is
+	evaluated in Q63.  The error of the fraction is below 2^-84, and
+	relative to the result below 2^-76, enough for pow.
+
+   __ki_todouble (m, scale, sign) rounds M * 2^-SCALE to the nearest
+   double.  */
+
+#include "intmath.h"
+
+#ifdef _INTEGER_MATH
+
+/* invc[i] * 2^-10 is about 1/z at the middle of interval i, and
+   -log2 of it is logc[i] in Q126.  Intervals 48 and up have z < 1.  */
+static const uint16_t invc[128] = {
+  1024, 1012, 1004, 997, 989, 982, 975, 967, 960, 953, 946, 940,
+  933, 926, 920, 913, 907, 901, 895, 889, 883, 877, 871, 865,
+  859, 854, 848, 843, 838, 832, 827, 822, 817, 812, 807, 802,
+  797, 792, 787, 783, 778, 773, 769, 764, 760, 755, 751, 747,
+  1485, 1477, 1469, 1460, 1452, 1444, 1436, 1429, 1421, 1413, 1406, 1398,
+  1391, 1383, 1376, 1369, 1362, 1355, 1348, 1341, 1334, 1327, 1321, 1314,
+  1307, 1301, 1295, 1288, 1282, 1276, 1269, 1263, 1257, 1251, 1245, 1239,
+  1234, 1228, 1222, 1216, 1211, 1205, 1200, 1194, 1189, 1183, 1178, 1173,
+  1168, 1163, 1157, 1152, 1147, 1142, 1137, 1132, 1128, 1123, 1118, 1113,
+  1108, 1104, 1099, 1095, 1090, 1085, 1081, 1077, 1072, 1068, 1063, 1059,
+  1055, 1051, 1046, 1042, 1038, 1034, 1030, 1024
+};
+
+static const __u128 logc[128] = {
+  { 0x0000000000000000, 0x0000000000000000 },
+  { 0x0116a21e20a0a450, 0xbc934138e5ef07a6 },
+  { 0x01d23afc49139f89, 0xbcdae7bd412854f8 },
+  { 0x02779bb373e01e66, 0xbe73b9da03968c22 },
+  { 0x03360a071b0812aa, 0xe6e261cbb11caea8 },
+  { 0x03ddef24a116d3ac, 0x26e64b7363bd2d51 },
+  { 0x048707bd57c1b081, 0x27eec65d189c89aa },
+  { 0x0549c69e188a83da, 0x13c05fd754f4da12 },
+  { 0x05f58125b3eed319, 0xced1447e30ad393f },
+  { 0x06a27d69b726b2fa, 0xf5f9113ae16c949a },
+  { 0x0750c0289493505d, 0xacd2ed7220833ba2 },
+  { 0x07e725770744593a, 0x4cacb5471742647a },
+  { 0x0897d37aa87c4aec, 0x2f946785b08a0473 },
+  { 0x0949d61ee0d33432, 0xf2c33fc5e114dc8d },
+  { 0x09e37db2866f2850, 0xb22563c9ed946209 },
+  { 0x0a9806bcb6f99ccf, 0x128bdc7acb3001c3 },
+  { 0x0b33e041385c8284, 0x3ca722cfa1f32b2c },
+  { 0x0bd0c294b1ac92d3, 0x01fa9fc50d57eed4 },
+  { 0x0c6eb1410a025484, 0x98d260c7ae3de2b5 },
+  { 0x0d0dafe2705a326e, 0x103681685e117174 },
+  { 0x0dadc227da59f78b, 0x247d22ade789c494 },
+  { 0x0e4eebd38768affc, 0x0a6b8959968204c0 },
+  { 0x0ef130bb884681b8, 0xae6c4a2fcf56cf9f },
+  { 0x0f9494ca4b544456, 0x72a725e0a0e3fc0d },
+  { 0x10391bff2dbcf337, 0xf5bde36c450afe3f },
+  { 0x10c318aedff3c076, 0x66d8496e74d50906 },
+  { 0x1169c05363f15872, 0x350f805d5e6dc585 },
+  { 0x11f588973c874718, 0x7d2b3375b4c3a89f },
+  { 0x128225bb5e64a3e8, 0xeab0bf7a2fbc705e },
+  { 0x132bfee370ee6865, 0xa24978de359f2bb8 },
+  { 0x13ba7963fc1f8eef, 0xb009f084fcc942b2 },
+  { 0x1449d115ef7d876c, 0x7b70a92a11742bc4 },
+  { 0x14da08ac46495a4a, 0x17243aaeb360d659 },
+  { 0x156b22e6b578e49c, 0x9e6b38aa8978bc26 },
+  { 0x15fd2291fc33cef5, 0xaf496e3800c691b0 },
+  { 0x16900a8836d0d507, 0x4f35e53bb822d900 },
+  { 0x1723ddb1346b6515, 0x43d29b82074b0d05 },
+  { 0x17b89f02cf2aad31, 0xf13c5d6aa764f368 },
+  { 0x184e5181475448f8, 0x93afdea13d32f8d8 },
+  { 0x18c6c335d8b965b1, 0xb1152c0c098963db },
+  { 0x195e2f9b51f04e2f, 0x266cd8473959eea3 },
+  { 0x19f695efbbd0ee9e, 0x987aef553a768346 },
+  { 0x1a713787ad97a4b8, 0x1ce5925fa47e65fa },
+  { 0x1b0b67f4f4680ff5, 0x0f623e38a2c18a2c },
+  { 0x1b877c57b1b06fef, 0xe2673cacefd889ba },
+  { 0x1c2381c08baf4e9d, 0xd1da1e71ba6e62ba },
+  { 0x1ca111cb2aa5c543, 0xf8dc754ab1cea6e2 },
+  { 0x1d1f4d7febf867fd, 0x81446d061d3f608a },
+  { 0xddae20288319804b, 0xc00da1e8d8122ca6 },
+  { 0xde2dcecf3505a169, 0x084e4386d421be52 },
+  { 0xdeae2efc54be2ac4, 0xaf2f439a08767f92 },
+  { 0xdf3f71cc1b629b82, 0xcdc1c18d007b792b },
+  { 0xdfc151b11b36401b, 0x9a81085cd3b2a92c },
+  { 0xe043e946fd97f5dc, 0x572667587b10ca0e },
+  { 0xe0c73a98433abf2f, 0x01c82d2f412a41f7 },
+  { 0xe13abbbc8398dc79, 0x71899cddb1f8eae9 },
+  { 0xe1bf6eec15577dcf, 0xd3b8f7c1847f5215 },
+  { 0xe244e1e6b47a0cc1, 0x1c80396e8d7d4ca0 },
+  { 0xe2ba458ca455b0f6, 0x3b03cdcc316d4aac },
+  { 0xe341260a447795fa, 0x26ff7f542143d2f7 },
+  { 0xe3b7ccf106e8a051, 0xccda7a9afca18b62 },
+  { 0xe44022d98f29498a, 0x6a98cec3af5ccd65 },
+  { 0xe4b81408c77d5f5b, 0xeb91070275d87152 },
+  { 0xe530a1d24b136c10, 0x1ee1343fe7c9cb4b },
+  { 0xe5a9cdd122c8ce9d, 0x6be8bba16d3371ec },
+  { 0xe62399a6b215874c, 0x7a1f2a26499b140b },
+  { 0xe69e06fad8bf6473, 0x0a6285239b26ac1a },
+  { 0xe719177c156dc50f, 0xbec3aaae14c28768 },
+  { 0xe794ccdfa924feb8, 0x646ed45cc9b6638e },
+  { 0xe81128e1bbb0b6ca, 0x6b4b7a95e77c9d75 },
+  { 0xe87c46d6d4ebee5b, 0x764f013424832a63 },
+  { 0xe8f9dcfaea92e2b1, 0x46e82f874ae57d90 },
+  { 0xe9781ed9dbf4b87d, 0x9c6ca12b134bdb5c },
+  { 0xe9e4e1645ebc89b7, 0xa10ab25510d2d866 },
+  { 0xea5224a2b84cc43c, 0xfb926237a13ba047 },
+  { 0xead24203b3694c82, 0x309f19e0364ad344 },
+  { 0xeb40a03c917a88cc, 0xd426d9b34f21d8c4 },
+  { 0xebaf830122b03c6b, 0x2a5f6003391cf088 },
+  { 0xec318a17577efe80, 0xddd05ebee0097d6a },
+  { 0xeca19059f57e2ecb, 0x081b553655e1d1cc },
+  { 0xed121f2cdf6f0201, 0x02adfaf7ae1984ea },
+  { 0xed8337dea22b4fa9, 0x008d0083f23da7dd },
+  { 0xedf4dbc29dd27ee7, 0x201b3a89513270b1 },
+  { 0xee670c311da84ce4, 0x7a345e010a034a3c },
+  { 0xeec6a0e4a49e5a42, 0x64325dd03386b080 },
+  { 0xef39d68aabd5715b, 0x04e05be7d1ff0ae8 },
+  { 0xefad9ca6454e4c9e, 0x382225249a916b7f },
+  { 0xf021f4a37ecbfaee, 0x2b9333ac3d886507 },
+  { 0xf083591b784e6887, 0xf120dbf6e99a6d48 },
+  { 0xf0f8c04f3480caae, 0xc664ad9757338f3f },
+  { 0xf15b08d9e6d3481b, 0x85a54d7ee2fd5df2 },
+  { 0xf1d184403cfbecce, 0x67fd7b309887c41a },
+  { 0xf234b513b88d6d11, 0xdbcb6e4e976e61f5 },
+  { 0xf2ac49cc41bb69fe, 0x79e0b0d36644ed5f },
+  { 0xf310673cb9f71599, 0xe84ba3cbfe969ff2 },
+  { 0xf374f1b122504bc7, 0xe039b5ae688b7b31 },
+  { 0xf3d9ea17e87e2681, 0x16edb88c4e2b5478 },
+  { 0xf43f51628bc75b6b, 0x437a3fb93546ac20 },
+  { 0xf4b9944189999659, 0x50ab65e9c48bf861 },
+  { 0xf51ff2e30214bc30, 0x2ffa76fafcba2917 },
+  { 0xf586c38260b4d0b3, 0xcc290a3fb4f32090 },
+  { 0xf5ee071e9f68aed8, 0x5fef389b9487f150 },
+  { 0xf655beba135f29b5, 0x7614e1683a65cd55 },
+  { 0xf6bdeb5a7c2ce039, 0x44baa9adeee9e69d },
+  { 0xf7119734556a4250, 0xadd5e7c3e34f5453 },
+  { 0xf77a9916016de49d, 0x5eb60dc814af331c },
+  { 0xf7e412ec386bc7c1, 0x8dda7fe0ab779d0b },
+  { 0xf84e05ca44da4fbd, 0x825a7af1d7d16fff },
+  { 0xf8b872c7291f496c, 0xbd31c3370d069d44 },
+  { 0xf90def6fd4951167, 0x134e9646b9a151e2 },
+  { 0xf9793b091243e9c4, 0x21d3818a8bc9b977 },
+  { 0xf9cf6b3d9c6cf99a, 0xe5befd0a7ed88db7 },
+  { 0xfa3b991e25055e80, 0xd98e794e7cf793f5 },
+  { 0xfaa84652cdee28e0, 0xa8da38376e64f58c },
+  { 0xfaff93c127ea9787, 0x912a070fa0367d1d },
+  { 0xfb573409c4451d47, 0x19c568acbf875682 },
+  { 0xfbc531d817581953, 0x0c22d15199b7a3e6 },
+  { 0xfc1d8ecf99b58c0b, 0xc65f28890d49e134 },
+  { 0xfc8c7a759a9eadd6, 0xe7a9c56b0fba1245 },
+  { 0xfce5974f7abaa516, 0xf0b2e4681d41a618 },
+  { 0xfd3f0a7e080b7d37, 0x89d48d708b6b4d17 },
+  { 0xfd98d4a92ac0f099, 0x8c28f7510295c93e },
+  { 0xfe098cb530796a63, 0x8790ad461f74e761 },
+  { 0xfe641d088b6533da, 0xcf80616876d94d4a },
+  { 0xfebf0687997a2d6c, 0xd3d0585d6cf0ebe5 },
+  { 0xff1a49e2a175d53a, 0x571a92b60f9d0a17 },
+  { 0xff75e7cbf6d11790, 0x209e8847178eefc6 },
+  { 0x0000000000000000, 0x0000000000000000 }
+};
+
+/* 1/ln2 in Q126 and 1/(2 ln2) in Q128.  */
+static const __u128 c1 = { 0x5c551d94ae0bf85d, 0xdf43ff68348e9f44 };
+static const __u128 c2 = { 0xb8aa3b295c17f0bb, 0xbe87fed0691d3e89 };
+
+/* (-1)^(n+1) / (n ln2) * 2^(21 - 7n) in Q63 for n = 3 ... 11, for
+   evaluation at r * 2^7.  */
+static const int64_t q[9] = {
+  0x3d8e13b87407fae9, -0x005c551d94ae0bf8, 0x000093bb62877ce0,
+  -0x000000f6384ee1d0, 0x00000001a61762a8, -0x0000000002e2a8ed,
+  0x000000000005212c, -0x000000000000093c, 0x0000000000000011
+};
+
+int
+__ki_log2 (uint64_t ix,
+	__u128 *m,
+	uint64_t *sign)
+{
+  uint64_t mx, u, qq;
+  int64_t r, rho, p;
+  __u128 s, t, f;
+  int k, i, j, e, scale;
+
+  /* x = mx * 2^(e - 52) with mx in [2^52, 2^53).  */
+  e = (ix >> 52) - 0x3ff;
+  mx = ix & 0x000fffffffffffff;
+  if (e == -0x3ff)
+    {
+      j = __clz64 (mx) - 11;
+      mx <<= j;
+      e = -0x3fe - j;
+    }
+  else
+    mx |= 0x0010000000000000;
+
+  /* r in Q63.  */
+  i = (mx >> 45) & 127;
+  if (i < 48)
+    {
+      k = e;
+      r = (int64_t) (mx * invc[i] - (1ULL << 62)) * 2;
+    }
+  else
+    {
+      k = e + 1;
+      r = (int64_t) (mx * invc[i] - (1ULL << 63));
+    }
+
+  /* Q(r) in Q63, then made a positive Q64.  */
+  rho = r * 128;
+  p = q[8];
+  for (j = 7; j >= 0; j--)
+    p = q[j] + __mulq63 (p, rho);
+  qq = (uint64_t) p << 1;
+
+  /* s = c1 - c2 * r + r^2 * Q(r) in Q126.  */
+  u = r < 0 ? -r : r;
+  s.hi = __mul64 (u, u, &s.lo);
+  s = __mul128x64 (s, qq);
+  t = __shr128 (__mul128x64 (c2, u), 1);
+  if (r >= 0)
+    t = __neg128 (t);
+  s = __add128 (__add128 (s, t), c1);
+
+  /* f = logc + r * s.  */
+  f = __shl128 (__mul128x64 (s, u), 1);
+  if (r < 0)
+    f = __neg128 (f);
+  f = __add128 (f, logc[i]);
+
+  /* Bring in k, which costs ten bits of the fraction.  */
+  scale = 126;
+  if (k != 0)
+    {
+      f.lo = (f.lo >> 10) | (f.hi << 54);
+      f.hi = (uint64_t) ((int64_t) f.hi >> 10) + ((uint64_t) (int64_t) k << 52);
+      scale = 116;
+    }
+
+  *sign = f.hi >> 63;
+  if (*sign)
+    f = __neg128 (f);
+  if (f.hi != 0)
+    j = __clz64 (f.hi);
+  else if (f.lo != 0)
+    j = 64 + __clz64 (f.lo);
+  else
+    j = 0;
+  if (j != 0)
+    f = __shl128 (f, j);
+  *m = f;
+  return scale + j;
+}
+
+double
+__ki_todouble (__u128 m,
+	int scale,
+	uint64_t sign)
+{
+  uint64_t mant, rest, half;
+  int j, e;
+
+  if (m.hi == 0 && m.lo == 0)
+    return asdouble (sign << 63);
+  j = m.hi != 0 ? __clz64 (m.hi) : 64 + __clz64 (m.lo);
+  if (j != 0)
+    m = __shl128 (m, j);
+
+  /* Round the top 53 bits to nearest, ties to even.  */
+  mant = m.hi >> 11;
+  rest = m.hi & 0x7ff;
+  half = 0x400;
+  if (rest > half || (rest == half && (m.lo != 0 || (mant & 1))))
+    mant++;
+
+  e = 127 - j - scale;
+  return asdouble ((sign << 63) + ((uint64_t) (e + 0x3fe) << 52) + mant);
+}
+
+#endif /* _INTEGER_MATH */
@@ -81,6 +81,7 @@ QUICKREF
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -118,3 +119,4 @@ QUICKREF
 }
 
 #endif /* _DOUBLE_IS_32BITS */
+#endif /* __OBSOLETE_MATH */
@@ -49,7 +49,7 @@ PORTABILITY
  */
 
 #include "fdlibm.h"
-#if __OBSOLETE_MATH
+#if __OBSOLETE_MATH && !defined (_INTEGER_MATH)
 #include <errno.h>
 #include <math.h>
 
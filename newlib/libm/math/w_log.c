@@ -45,7 +45,7 @@ PORTABILITY
  */
 
 #include "fdlibm.h"
-#if __OBSOLETE_MATH
+#if __OBSOLETE_MATH && !defined (_INTEGER_MATH)
 #include <errno.h>
 
 #ifndef _DOUBLE_IS_32BITS
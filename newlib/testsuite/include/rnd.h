@@ -0,0 +1,19 @@
+/* A small xorshift generator for the tests that feed random inputs to
+   a function.  It always starts from the same seed, so a failure shows
+   up on every run and on every target alike.  */
+
+#ifndef _RND_H_
+#define _RND_H_
+
+static unsigned long long rnd_seed = 1;
+
+static unsigned long long
+rnd (void)
+{
+  rnd_seed ^= rnd_seed << 13;
+  rnd_seed ^= rnd_seed >> 7;
+  rnd_seed ^= rnd_seed << 17;
+  return rnd_seed;
+}
+
+#endif /* _RND_H_ */
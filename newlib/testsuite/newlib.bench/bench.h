@@ -0,0 +1,88 @@
+/*
+ * bench.h -- shared harness for the newlib.bench cost benchmarks.
+ *
+ * Each benchmark measures one libc call with BENCH_BEGIN/BENCH_END and
+ * reports it with bench_report as a single line
+ *
+ *	BENCH <name> <size> <align> <cost>
+ *
+ * which bench.exp collects.  On SBF the cost is the number of compute
+ * units consumed, read from the interpreter through the
+ * sol_remaining_compute_units syscall and reported through sol_log_.
+ * Elsewhere the harness falls back to clock() so the programs can still
+ * be run natively while working on them.
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __bpf__
+extern uint64_t sol_remaining_compute_units (void);
+extern void sol_log_ (const char *, uint64_t);
+
+#define bench_counter()	(-sol_remaining_compute_units ())
+#else
+#include <time.h>
+
+#define bench_counter()	((uint64_t) clock ())
+#endif
+
+static volatile uintptr_t bench_sink;
+static uint64_t bench_overhead;
+static uint64_t bench_start;
+
+#define BENCH_BEGIN() (bench_start = bench_counter ())
+#define BENCH_END() bench_end ()
+
+static uint64_t
+bench_end (void)
+{
+  uint64_t elapsed = bench_counter () - bench_start;
+
+  return elapsed > bench_overhead ? elapsed - bench_overhead : 0;
+}
+
+/* Measure an empty region once, so that the cost of reading the counter
+   itself is not charged to the routine under test.  */
+static void
+bench_calibrate (void)
+{
+  bench_overhead = 0;
+  BENCH_BEGIN ();
+  bench_overhead = BENCH_END ();
+}
+
+/* The longest benchmark name reported in full; longer ones are cut.  */
+#define BENCH_NAME_MAX 24
+
+/* "BENCH ", the name, three space-separated 64-bit numbers and the NUL.  */
+#define BENCH_LINE_MAX (6 + BENCH_NAME_MAX + 3 * (1 + 20) + 1)
+
+static void
+bench_report (const char *name, size_t size, size_t align, uint64_t cost)
+{
+  char line[BENCH_LINE_MAX];
+
+  snprintf (line, sizeof (line), "BENCH %.*s %llu %llu %llu",
+	    BENCH_NAME_MAX, name, (unsigned long long) size,
+	    (unsigned long long) align, (unsigned long long) cost);
+
+#ifdef __bpf__
+  sol_log_ (line, strlen (line));
+#else
+  puts (line);
+#endif
+}
+
+/* Input sizes and alignments shared by the string and memory matrices.  */
+static const size_t bench_sizes[] = { 0, 1, 7, 8, 15, 16, 31, 64, 255, 1024 };
+static const size_t bench_aligns[] = { 0, 1, 3, 7 };
+
+#define BENCH_NELEM(A) (sizeof (A) / sizeof ((A)[0]))
+
+#endif /* _BENCH_H_ */
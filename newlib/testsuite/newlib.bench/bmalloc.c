@@ -0,0 +1,61 @@
+/*
+ * bmalloc.c -- cost of malloc, free and realloc by request size.
+ */
+
+#include "bench.h"
+
+#define NBLOCKS 32
+
+static void *(*volatile p_malloc) (size_t) = malloc;
+static void (*volatile p_free) (void *) = free;
+static void *(*volatile p_realloc) (void *, size_t) = realloc;
+
+static const size_t sizes[] = { 1, 8, 16, 24, 32, 64, 128, 256, 512, 1024 };
+
+int
+main (void)
+{
+  void *blocks[NBLOCKS];
+  size_t i, k, size;
+  uint64_t cost;
+
+  bench_calibrate ();
+
+  for (i = 0; i < BENCH_NELEM (sizes); i++)
+    {
+      size = sizes[i];
+
+      /* A run of allocations, so the later ones see a longer free list
+	 or a grown heap depending on the allocator.  The reported cost is
+	 the average per call.  */
+      BENCH_BEGIN ();
+      for (k = 0; k < NBLOCKS; k++)
+	blocks[k] = p_malloc (size);
+      cost = BENCH_END ();
+      bench_report ("malloc", size, 0, cost / NBLOCKS);
+
+      /* Free every other block, then reuse the holes.  */
+      BENCH_BEGIN ();
+      for (k = 0; k < NBLOCKS; k += 2)
+	p_free (blocks[k]);
+      cost = BENCH_END ();
+      bench_report ("free", size, 0, cost / (NBLOCKS / 2));
+
+      BENCH_BEGIN ();
+      for (k = 0; k < NBLOCKS; k += 2)
+	blocks[k] = p_malloc (size);
+      cost = BENCH_END ();
+      bench_report ("malloc-reuse", size, 0, cost / (NBLOCKS / 2));
+
+      /* Grow the most recent block, the pattern of a growing buffer.  */
+      BENCH_BEGIN ();
+      blocks[NBLOCKS - 1] = p_realloc (blocks[NBLOCKS - 1], 2 * size);
+      cost = BENCH_END ();
+      bench_report ("realloc", size, 0, cost);
+
+      for (k = 0; k < NBLOCKS; k++)
+	p_free (blocks[k]);
+    }
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * bprintf.c -- cost of formatting integers, strings and floats with snprintf,
+ * by length of the output.
+ */
+
+#include "bench.h"
+
+#include <stdio.h>
+
+static int (*volatile p_snprintf) (char *, size_t, const char *, ...)
+  = snprintf;
+
+static const long values[] = { 0, 7, 4242, 12345678, 1234567890123456789L };
+
+int
+main (void)
+{
+  char buf[64];
+  size_t i;
+  int len;
+  uint64_t cost;
+
+  bench_calibrate ();
+
+  for (i = 0; i < BENCH_NELEM (values); i++)
+    {
+      BENCH_BEGIN ();
+      len = p_snprintf (buf, sizeof (buf), "%ld", values[i]);
+      cost = BENCH_END ();
+      bench_report ("snprintf-d", len, 0, cost);
+
+      BENCH_BEGIN ();
+      len = p_snprintf (buf, sizeof (buf), "%lx", values[i]);
+      cost = BENCH_END ();
+      bench_report ("snprintf-x", len, 0, cost);
+    }
+
+  BENCH_BEGIN ();
+  len = p_snprintf (buf, sizeof (buf), "%s=%d", "lamports", 42);
+  cost = BENCH_END ();
+  bench_report ("snprintf-s", len, 0, cost);
+
+  BENCH_BEGIN ();
+  len = p_snprintf (buf, sizeof (buf), "%.4f", 1234.5678);
+  cost = BENCH_END ();
+  bench_report ("snprintf-f", len, 0, cost);
+
+  return 0;
+}
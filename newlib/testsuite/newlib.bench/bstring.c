@@ -0,0 +1,95 @@
+/*
+ * bstring.c -- cost of the string and memory routines by size and
+ * alignment.
+ */
+
+#include "bench.h"
+
+#define BUFF_SIZE 2048
+
+/* Calls go through volatile pointers so that the compiler cannot expand
+   or fold them, whatever the sizes are.  */
+static size_t (*volatile p_strlen) (const char *) = strlen;
+static char *(*volatile p_strchr) (const char *, int) = strchr;
+static int (*volatile p_strcmp) (const char *, const char *) = strcmp;
+static void *(*volatile p_memchr) (const void *, int, size_t) = memchr;
+static void *(*volatile p_memcpy) (void *, const void *, size_t) = memcpy;
+static void *(*volatile p_memmove) (void *, const void *, size_t) = memmove;
+static void *(*volatile p_memset) (void *, int, size_t) = memset;
+static int (*volatile p_memcmp) (const void *, const void *, size_t) = memcmp;
+
+static char src[BUFF_SIZE] __attribute__ ((aligned (8)));
+static char dst[BUFF_SIZE] __attribute__ ((aligned (8)));
+
+/* Fill SRC with a NUL-terminated string of SIZE bytes at ALIGN, and DST
+   with an equal copy at ALIGN + 1 so that the two operands of the
+   comparison routines are never co-aligned by accident.  */
+static void
+setup (size_t size, size_t align)
+{
+  size_t i;
+
+  memset (src, 0, sizeof (src));
+  memset (dst, 0, sizeof (dst));
+  for (i = 0; i < size; i++)
+    src[align + i] = dst[align + 1 + i] = 'a' + i % 26;
+}
+
+int
+main (void)
+{
+  size_t i, j, size, align;
+  uint64_t cost;
+
+  bench_calibrate ();
+
+  for (i = 0; i < BENCH_NELEM (bench_sizes); i++)
+    for (j = 0; j < BENCH_NELEM (bench_aligns); j++)
+      {
+	size = bench_sizes[i];
+	align = bench_aligns[j];
+	setup (size, align);
+
+	BENCH_BEGIN ();
+	bench_sink = p_strlen (src + align);
+	cost = BENCH_END ();
+	bench_report ("strlen", size, align, cost);
+
+	BENCH_BEGIN ();
+	bench_sink = (uintptr_t) p_strchr (src + align, 'A');
+	cost = BENCH_END ();
+	bench_report ("strchr", size, align, cost);
+
+	BENCH_BEGIN ();
+	bench_sink = p_strcmp (src + align, dst + align + 1);
+	cost = BENCH_END ();
+	bench_report ("strcmp", size, align, cost);
+
+	BENCH_BEGIN ();
+	bench_sink = (uintptr_t) p_memchr (src + align, 'A', size);
+	cost = BENCH_END ();
+	bench_report ("memchr", size, align, cost);
+
+	BENCH_BEGIN ();
+	bench_sink = p_memcmp (src + align, dst + align + 1, size);
+	cost = BENCH_END ();
+	bench_report ("memcmp", size, align, cost);
+
+	BENCH_BEGIN ();
+	p_memcpy (dst + align, src, size);
+	cost = BENCH_END ();
+	bench_report ("memcpy", size, align, cost);
+
+	BENCH_BEGIN ();
+	p_memmove (src + align + 1, src + align, size);
+	cost = BENCH_END ();
+	bench_report ("memmove", size, align, cost);
+
+	BENCH_BEGIN ();
+	p_memset (dst + align, 0x5a, size);
+	cost = BENCH_END ();
+	bench_report ("memset", size, align, cost);
+      }
+
+  return 0;
+}
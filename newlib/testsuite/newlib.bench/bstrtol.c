@@ -0,0 +1,49 @@
+/*
+ * bstrtol.c -- cost of strtol and strtoull by number of digits.
+ */
+
+#include "bench.h"
+
+static long (*volatile p_strtol) (const char *, char **, int) = strtol;
+static unsigned long long (*volatile p_strtoull) (const char *, char **, int)
+  = strtoull;
+
+static const char *const decimal[] = {
+  "7", "42", "1234", "12345678", "123456789012", "1234567890123456789"
+};
+
+static const char *const hex[] = {
+  "f", "2a", "beef", "deadbeef", "123456789abc", "fedcba9876543210"
+};
+
+int
+main (void)
+{
+  size_t i;
+  uint64_t cost;
+
+  bench_calibrate ();
+
+  for (i = 0; i < BENCH_NELEM (decimal); i++)
+    {
+      BENCH_BEGIN ();
+      bench_sink = p_strtol (decimal[i], NULL, 10);
+      cost = BENCH_END ();
+      bench_report ("strtol-10", strlen (decimal[i]), 0, cost);
+
+      BENCH_BEGIN ();
+      bench_sink = p_strtoull (decimal[i], NULL, 10);
+      cost = BENCH_END ();
+      bench_report ("strtoull-10", strlen (decimal[i]), 0, cost);
+    }
+
+  for (i = 0; i < BENCH_NELEM (hex); i++)
+    {
+      BENCH_BEGIN ();
+      bench_sink = p_strtoull (hex[i], NULL, 16);
+      cost = BENCH_END ();
+      bench_report ("strtoull-16", strlen (hex[i]), 0, cost);
+    }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <string.h>
+#include <iconv.h>
+#include <errno.h>
+#include <newlib.h>
+#include "check.h"
+
+/* Conversions between UTF-8, UTF-16 and UCS-4 of text mixing long
+   ASCII runs with longer sequences, so that runs cross the block
+   boundaries of the converter, and stops at invalid input and at the
+   end of the output buffer.  */
+
+#if defined(_ICONV_ENABLED) && \
+    defined(_ICONV_FROM_ENCODING_UTF_8) && \
+    defined(_ICONV_TO_ENCODING_UTF_8) && \
+    defined(_ICONV_FROM_ENCODING_UTF_16BE) && \
+    defined(_ICONV_TO_ENCODING_UTF_16BE) && \
+    defined(_ICONV_FROM_ENCODING_UCS_4) && \
+    defined(_ICONV_TO_ENCODING_UCS_4)
+
+static char utf8[1024];
+static char other[4096];
+static char back[1024];
+
+static size_t
+convert (const char *to, const char *from, char *in, size_t inlen,
+         char *out, size_t outlen, int *err)
+{
+  iconv_t cd;
+  size_t r;
+  char *ip = in, *op = out;
+
+  cd = iconv_open (to, from);
+  CHECK (cd != (iconv_t) -1);
+  r = iconv (cd, &ip, &inlen, &op, &outlen);
+  *err = r == (size_t) -1 ? errno : 0;
+  CHECK (iconv_close (cd) != -1);
+  return op - out;
+}
+
+int main()
+{
+  static const char *pieces[] = {
+    "caf\xc3\xa9 ", "\xe6\x97\xa5\xe6\x9c\xac ", "\xf0\x9f\x98\x80 ",
+    "\xd0\x9f\xd1\x80\xd0\xb8 "
+  };
+  size_t n = 0, m, k, i;
+  int err;
+
+  /* 0..99 ASCII, then the pieces, then ASCII again, repeatedly.  */
+  while (n < sizeof (utf8) - 128)
+    {
+      for (i = 0; i < 100; i++)
+        utf8[n++] = 'a' + i % 26;
+      for (i = 0; i < 4; i++)
+        {
+          memcpy (utf8 + n, pieces[i], strlen (pieces[i]));
+          n += strlen (pieces[i]);
+        }
+    }
+
+  m = convert ("UTF-16BE", "UTF-8", utf8, n, other, sizeof (other), &err);
+  CHECK (err == 0);
+  CHECK (other[0] == 0 && other[1] == 'a');
+  CHECK (memcmp (other + 200, "\0c\0a\0f\0\xe9\0 \x65\xe5\x67\x2c\0 "
+                 "\xd8\x3d\xde\x00\0 ", 22) == 0);
+  k = convert ("UTF-8", "UTF-16BE", other, m, back, sizeof (back), &err);
+  CHECK (err == 0 && k == n && memcmp (back, utf8, n) == 0);
+
+  m = convert ("UCS-4", "UTF-8", utf8, n, other, sizeof (other), &err);
+  CHECK (err == 0);
+  CHECK (memcmp (other + 400, "\0\0\0c\0\0\0a\0\0\0f\0\0\0\xe9", 16) == 0);
+  CHECK (memcmp (other + 432, "\0\x01\xf6\x00", 4) == 0);
+  k = convert ("UTF-8", "UCS-4", other, m, back, sizeof (back), &err);
+  CHECK (err == 0 && k == n && memcmp (back, utf8, n) == 0);
+
+  /* An overlong sequence after a run of ASCII: all of the run is
+     converted.  */
+  memcpy (back, utf8, 100);
+  back[100] = 0xc0;
+  back[101] = 0x80;
+  k = convert ("UTF-16BE", "UTF-8", back, 102, other, sizeof (other), &err);
+  CHECK (err == EILSEQ && k == 200);
+
+  /* An output buffer ending inside a character.  */
+  k = convert ("UTF-16BE", "UTF-8", utf8, n, other, 219, &err);
+  CHECK (err == E2BIG && k == 216);
+
+  exit (0);
+}
+
+#else
+int main()
+{
+  exit (0);
+}
+#endif
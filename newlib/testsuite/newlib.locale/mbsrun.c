@@ -0,0 +1,95 @@
+/* The string conversion functions against mbrtowc and wcrtomb, in the
+   UTF-8 locale, on the sequences of UTF-8.c placed after and before
+   runs of ASCII, so that the runs are converted in bulk.  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <newlib.h>
+#include "check.h"
+
+static const char *seqs[] = {
+  "\xc2\x80", "\xe0\xa0\x80", "\xf0\x90\x80\x80", "\xf8\x88\x80\x80\x80",
+  "\xfc\x84\x80\x80\x80\x80", "\x7f", "\xdf\xbf", "\xef\xbf\xbf",
+  "\xf7\xbf\xbf\xbf", "\xed\x9f\xbf", "\xee\x80\x80", "\xef\xbf\xbd",
+  "\xf4\x8f\xbf\xbf", "\xf4\x90\x80\x80", "\x80", "\xbf", "\x80\xbf\x80",
+  "\xc0 ", "\xe0\x80 ", "\xf0\x80\x80 ", "\xc0\xaf", "\xe0\x80\xaf",
+  "\xf0\x80\x80\xaf", "\xc1\xbf", "\xe0\x9f\xbf", "\xf0\x8f\xbf\xbf",
+  "\xed\xa0\x80", "\xed\xbf\xbf", "\xed\xa0\x80\xed\xb0\x80", "\xfe",
+  "\xff", "\xc3", "\xe6\x97", "\xf0\x9f\x98"
+};
+
+static char mb[256], mb2[256];
+static wchar_t wc[256], wc2[256];
+
+int main()
+{
+#ifdef _MB_CAPABLE
+  size_t i, j, n, len, r;
+  const char *p, *e;
+  const wchar_t *q;
+  mbstate_t st;
+
+  CHECK (setlocale (LC_CTYPE, "C.UTF-8") != 0);
+
+  for (i = 0; i < sizeof (seqs) / sizeof (seqs[0]); ++i)
+    for (j = 0; j < 2; ++j)
+      {
+	memset (mb, 0, sizeof (mb));
+	memset (mb, 'a' + i % 26, 70 + j);
+	strcat (mb, seqs[i]);
+	memset (mb + strlen (mb), 'z', 20);
+	len = strlen (mb);
+
+	/* What mbrtowc makes of it.  */
+	memset (&st, 0, sizeof (st));
+	for (p = mb, n = 0; (r = mbrtowc (&wc[n], p, len + 1 - (p - mb), &st))
+			    != 0; p += r, ++n)
+	  if (r == (size_t) -1)
+	    break;
+	e = p;
+
+	memset (&st, 0, sizeof (st));
+	p = mb;
+	if (r == 0)
+	  {
+	    CHECK (mbstowcs (wc2, mb, 256) == n);
+	    CHECK (memcmp (wc2, wc, (n + 1) * sizeof (wchar_t)) == 0);
+	    CHECK (mbstowcs (NULL, mb, 0) == n);
+	    CHECK (mbsrtowcs (wc2, &p, 256, &st) == n && p == NULL);
+	    p = mb;
+	    CHECK (mbsrtowcs (wc2, &p, n - 1, &st) == n - 1);
+
+	    /* and back again */
+	    CHECK (wcstombs (mb2, wc, 256) == len);
+	    CHECK (strcmp (mb2, mb) == 0);
+	    CHECK (wcstombs (NULL, wc, 0) == len);
+	    q = wc;
+	    CHECK (wcsrtombs (mb2, &q, 256, &st) == len && q == NULL);
+	    q = wc;
+	    CHECK (wcsrtombs (mb2, &q, len - 1, &st) == len - 1);
+	    CHECK (q == wc + n - 1);
+	  }
+	else
+	  {
+	    CHECK (mbstowcs (wc2, mb, 256) == (size_t) -1);
+	    CHECK (mbstowcs (NULL, mb, 0) == (size_t) -1);
+	    CHECK (mbsrtowcs (wc2, &p, 256, &st) == (size_t) -1);
+	    CHECK (p == e && memcmp (wc2, wc, n * sizeof (wchar_t)) == 0);
+	    p = mb;
+	    CHECK (mbsnrtowcs (wc2, &p, 256, n, &st) == n && p == e);
+	  }
+      }
+
+  /* Characters wcrtomb rejects after a run.  */
+  for (i = 0; i < 70; ++i)
+    wc[i] = L'a';
+  wc[70] = 0x110000;
+  wc[71] = 0;
+  CHECK (wcstombs (mb2, wc, 256) == (size_t) -1);
+  CHECK (wcstombs (NULL, wc, 0) == (size_t) -1);
+#endif
+
+  exit (0);
+}
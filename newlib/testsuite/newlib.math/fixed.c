@@ -0,0 +1,312 @@
+/* Test the fixed-point functions of <fixmath.h>: the logarithms,
+   exponentials and powers against the double ones to double accuracy
+   and against a few values correct to the last place, the rounding
+   modes of mul, div and sqrt exactly, and the errors reported.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <math.h>
+#include <fixmath.h>
+#include "check.h"
+#include "rnd.h"
+
+/* Keeps 48 bits of a random fraction, so that with up to five bits of
+   integer part a fxq64_t is exact in double.  */
+#define MASK 0xffffffffffff0000ULL
+
+static double
+q2d (fxq64_t x)
+{
+  return x.hi + ldexp ((double) x.lo, -64);
+}
+
+static double
+d2d (fxd18_t x)
+{
+  return (ldexp ((double) x.hi, 64) + x.lo) / 1e18;
+}
+
+static fxq64_t
+q (long long hi, unsigned long long lo)
+{
+  fxq64_t x = { hi, lo };
+
+  return x;
+}
+
+static fxd18_t
+d (unsigned long long lo)
+{
+  fxd18_t x = { 0, lo };
+
+  return x;
+}
+
+/* GOT, which the function returned with error ERR, is within a relative
+   2^-50 or an absolute TOL of WANT.  */
+static void
+check (const char *name, double x, double y, int err, double got,
+       double want, double tol)
+{
+  int ok = err == 0 && fabs (got - want) <= fmax (ldexp (fabs (want), -50),
+						   tol);
+
+  if (!ok)
+    printf ("%s (%a, %a) = %a, error %d, want %a\n", name, x, y, got, err,
+	    want);
+  CHECK (ok);
+}
+
+static void
+check_q (const char *name, int err, fxq64_t got, int want_err,
+	 long long hi, unsigned long long lo)
+{
+  int ok = err == want_err && (err != 0 || (got.hi == hi && got.lo == lo));
+
+  if (!ok)
+    printf ("%s = %llx.%016llx, error %d, want %llx.%016llx, error %d\n",
+	    name, (long long) got.hi, (unsigned long long) got.lo, err,
+	    hi, lo, want_err);
+  CHECK (ok);
+}
+
+static void
+check_d (const char *name, int err, fxd18_t got, int want_err,
+	 unsigned long long lo)
+{
+  int ok = err == want_err && (err != 0 || (got.hi == 0 && got.lo == lo));
+
+  if (!ok)
+    printf ("%s = %llx:%llu, error %d, want %llu, error %d\n", name,
+	    (unsigned long long) got.hi, (unsigned long long) got.lo, err,
+	    lo, want_err);
+  CHECK (ok);
+}
+
+int
+main (void)
+{
+  fxq64_t qx, qy, qr;
+  fxd18_t dx, dy, dr;
+  double x, y;
+  int i, err;
+
+  /* Against the double functions, on arguments that are exact in
+     double.  */
+  for (i = 0; i < 20000; i++)
+    {
+      qx = q (rnd () >> 40, rnd () & MASK);
+      x = q2d (qx);
+      err = fxq64_ln (&qr, qx);
+      check ("fxq64_ln", x, 0, err, q2d (qr), log (x), 0x1p-60);
+      err = fxq64_log2 (&qr, qx);
+      check ("fxq64_log2", x, 0, err, q2d (qr), log2 (x), 0x1p-60);
+      err = fxq64_sqrt (&qr, qx, FX_TONEAREST);
+      check ("fxq64_sqrt", x, 0, err, q2d (qr), sqrt (x), 0x1p-60);
+
+      qy = q ((long long) (rnd () >> 59) - 16, rnd () & MASK);
+      y = q2d (qy);
+      err = fxq64_exp (&qr, qy);
+      check ("fxq64_exp", y, 0, err, q2d (qr), exp (y), 0x1p-60);
+      err = fxq64_exp2 (&qr, qy);
+      check ("fxq64_exp2", y, 0, err, q2d (qr), exp2 (y), 0x1p-60);
+
+      qx = q (rnd () >> 60, rnd () & MASK);
+      x = q2d (qx);
+      err = fxq64_pow (&qr, qx, qy);
+      if (x != 0 && pow (x, y) < 0x1p62)
+	check ("fxq64_pow", x, y, err, q2d (qr), pow (x, y), 0x1p-60);
+
+      /* x = m 2^-18 is m 5^18 2^0 in fxd18_t.  */
+      x = ldexp ((double) (rnd () >> 42), -18);
+      y = ldexp ((double) (rnd () >> 42), -18);
+      dx = d ((unsigned long long) ldexp (x, 18) * 3814697265625ULL);
+      dy = d ((unsigned long long) ldexp (y, 18) * 3814697265625ULL);
+      if (x >= 1)
+	{
+	  err = fxd18_ln (&dr, dx);
+	  check ("fxd18_ln", x, 0, err, d2d (dr), log (x), 1e-18);
+	  err = fxd18_log2 (&dr, dx);
+	  check ("fxd18_log2", x, 0, err, d2d (dr), log2 (x), 1e-18);
+	}
+      err = fxd18_sqrt (&dr, dx, FX_TONEAREST);
+      check ("fxd18_sqrt", x, 0, err, d2d (dr), sqrt (x), 1e-18);
+      err = fxd18_exp (&dr, dy);
+      check ("fxd18_exp", y, 0, err, d2d (dr), exp (y), 1e-18);
+      err = fxd18_exp2 (&dr, dy);
+      check ("fxd18_exp2", y, 0, err, d2d (dr), exp2 (y), 1e-18);
+      if (x != 0)
+	{
+	  err = fxd18_pow (&dr, dx, dy);
+	  check ("fxd18_pow", x, y, err, d2d (dr), pow (x, y), 1e-18);
+	}
+    }
+
+  /* Correct to the last place.  */
+  err = fxq64_ln (&qr, q (2, 0));
+  check_q ("fxq64_ln (2)", err, qr, 0, 0, 0xb17217f7d1cf79acULL);
+  err = fxq64_exp (&qr, q (1, 0));
+  check_q ("fxq64_exp (1)", err, qr, 0, 2, 0xb7e151628aed2a6bULL);
+  err = fxq64_log2 (&qr, q (3, 0));
+  check_q ("fxq64_log2 (3)", err, qr, 0, 1, 0x95c01a39fbd687a0ULL);
+  err = fxq64_exp2 (&qr, q (0, 1ULL << 63));
+  check_q ("fxq64_exp2 (0.5)", err, qr, 0, 1, 0x6a09e667f3bcc909ULL);
+  err = fxq64_exp (&qr, q (-10, 0));
+  check_q ("fxq64_exp (-10)", err, qr, 0, 0, 0x2f9af36ac8f93ULL);
+  err = fxq64_pow (&qr, q (10, 0), q (0, 1ULL << 62));
+  check_q ("fxq64_pow (10, 0.25)", err, qr, 0, 1, 0xc73d51c54470e310ULL);
+  err = fxd18_exp (&dr, fxd18_from_uint (1));
+  check_d ("fxd18_exp (1)", err, dr, 0, 2718281828459045235ULL);
+  err = fxd18_ln (&dr, fxd18_from_uint (10));
+  check_d ("fxd18_ln (10)", err, dr, 0, 2302585092994045684ULL);
+  err = fxd18_log2 (&dr, fxd18_from_uint (3));
+  check_d ("fxd18_log2 (3)", err, dr, 0, 1584962500721156181ULL);
+  err = fxd18_pow (&dr, d (1050000000000000000ULL), fxd18_from_uint (30));
+  check_d ("fxd18_pow (1.05, 30)", err, dr, 0, 4321942375150662009ULL);
+
+  /* Exact results.  */
+  for (i = -64; i < 63; i++)
+    {
+      qx = i < 0 ? q (0, 1ULL << (i + 64)) : q (1LL << i, 0);
+      err = fxq64_log2 (&qr, qx);
+      check_q ("fxq64_log2 (2^i)", err, qr, 0, i, 0);
+      err = fxq64_exp2 (&qr, q (i, 0));
+      check_q ("fxq64_exp2 (i)", err, qr, 0, qx.hi, qx.lo);
+      err = fxq64_pow (&qr, q (2, 0), q (i, 0));
+      check_q ("fxq64_pow (2, i)", err, qr, 0, qx.hi, qx.lo);
+    }
+  err = fxq64_ln (&qr, q (1, 0));
+  check_q ("fxq64_ln (1)", err, qr, 0, 0, 0);
+  err = fxq64_exp (&qr, q (0, 0));
+  check_q ("fxq64_exp (0)", err, qr, 0, 1, 0);
+  err = fxq64_pow (&qr, q (0, 0), q (0, 0));
+  check_q ("fxq64_pow (0, 0)", err, qr, 0, 1, 0);
+  err = fxd18_ln (&dr, fxd18_from_uint (1));
+  check_d ("fxd18_ln (1)", err, dr, 0, 0);
+  err = fxd18_exp (&dr, d (0));
+  check_d ("fxd18_exp (0)", err, dr, 0, 1000000000000000000ULL);
+  err = fxd18_pow (&dr, d (123), d (0));
+  check_d ("fxd18_pow (x, 0)", err, dr, 0, 1000000000000000000ULL);
+  err = fxd18_pow (&dr, fxd18_from_uint (3), fxd18_from_uint (2));
+  check_d ("fxd18_pow (3, 2)", err, dr, 0, 9000000000000000000ULL);
+
+  /* The rounding modes, on 1/3 and -1/3 and on a product whose last
+     bit is exactly half.  */
+  err = fxq64_div (&qr, q (1, 0), q (3, 0), FX_TONEAREST);
+  check_q ("1/3 nearest", err, qr, 0, 0, 0x5555555555555555ULL);
+  err = fxq64_div (&qr, q (2, 0), q (3, 0), FX_TONEAREST);
+  check_q ("2/3 nearest", err, qr, 0, 0, 0xaaaaaaaaaaaaaaabULL);
+  err = fxq64_div (&qr, q (1, 0), q (3, 0), FX_UPWARD);
+  check_q ("1/3 upward", err, qr, 0, 0, 0x5555555555555556ULL);
+  err = fxq64_div (&qr, q (-1, 0), q (3, 0), FX_UPWARD);
+  check_q ("-1/3 upward", err, qr, 0, -1, 0xaaaaaaaaaaaaaaabULL);
+  err = fxq64_div (&qr, q (-1, 0), q (3, 0), FX_DOWNWARD);
+  check_q ("-1/3 downward", err, qr, 0, -1, 0xaaaaaaaaaaaaaaaaULL);
+  err = fxq64_div (&qr, q (-1, 0), q (3, 0), FX_TOWARDZERO);
+  check_q ("-1/3 toward zero", err, qr, 0, -1, 0xaaaaaaaaaaaaaaabULL);
+  err = fxq64_mul (&qr, q (0, 3), q (0, 1ULL << 63), FX_TONEAREST);
+  check_q ("1.5 ulp nearest", err, qr, 0, 0, 2);
+  err = fxq64_mul (&qr, q (0, 5), q (0, 1ULL << 63), FX_TONEAREST);
+  check_q ("2.5 ulp nearest", err, qr, 0, 0, 2);
+  err = fxq64_mul (&qr, q (0, 5), q (-1, 1ULL << 63), FX_TONEAREST);
+  check_q ("-2.5 ulp nearest", err, qr, 0, -1, -2ULL);
+  err = fxq64_mul (&qr, q (0, 5), q (-1, 1ULL << 63), FX_DOWNWARD);
+  check_q ("-2.5 ulp downward", err, qr, 0, -1, -3ULL);
+  err = fxd18_div (&dr, fxd18_from_uint (2), fxd18_from_uint (3),
+		   FX_TOWARDZERO);
+  check_d ("fxd18 2/3 toward zero", err, dr, 0, 666666666666666666ULL);
+  err = fxd18_div (&dr, fxd18_from_uint (2), fxd18_from_uint (3),
+		   FX_TONEAREST);
+  check_d ("fxd18 2/3 nearest", err, dr, 0, 666666666666666667ULL);
+  err = fxd18_mul (&dr, d (5), d (100000000000000000ULL), FX_TONEAREST);
+  check_d ("fxd18 0.5 ulp nearest", err, dr, 0, 0);
+  err = fxd18_mul (&dr, d (15), d (100000000000000000ULL), FX_TONEAREST);
+  check_d ("fxd18 1.5 ulp nearest", err, dr, 0, 2);
+  err = fxd18_mul (&dr, d (5), d (100000000000000000ULL), FX_UPWARD);
+  check_d ("fxd18 0.5 ulp upward", err, dr, 0, 1);
+  err = fxd18_sqrt (&dr, fxd18_from_uint (2), FX_TONEAREST);
+  check_d ("fxd18_sqrt (2) nearest", err, dr, 0, 1414213562373095049ULL);
+  err = fxd18_sqrt (&dr, fxd18_from_uint (2), FX_DOWNWARD);
+  check_d ("fxd18_sqrt (2) downward", err, dr, 0, 1414213562373095048ULL);
+  err = fxq64_sqrt (&qr, q (2, 0), FX_UPWARD);
+  check_q ("fxq64_sqrt (2) upward", err, qr, 0, 1, 0x6a09e667f3bcc909ULL);
+  err = fxq64_from_d18 (&qr, d (1), FX_UPWARD);
+  check_q ("fxq64_from_d18 (1e-18)", err, qr, 0, 0, 19);
+  err = fxd18_from_q64 (&dr, q (0, 1ULL << 63), FX_TONEAREST);
+  check_d ("fxd18_from_q64 (0.5)", err, dr, 0, 500000000000000000ULL);
+
+  /* Multiplication and division are exact where they can be, and
+     sqrt gives back the root of a square.  */
+  for (i = 0; i < 20000; i++)
+    {
+      qx = q ((long long) rnd () >> 33, rnd () & ~0xffffffffULL);
+      qy = q ((long long) rnd () >> 33, rnd () & ~0xffffffffULL);
+      err = fxq64_mul (&qr, qx, qy, FX_TOWARDZERO);
+      if (err == 0 && (qx.lo | qx.hi) != 0)
+	{
+	  fxq64_t back;
+
+	  err = fxq64_div (&back, qr, qx, FX_TOWARDZERO);
+	  check_q ("fxq64_div (x y, x)", err, back, 0, qy.hi, qy.lo);
+	}
+      qx.hi = qx.hi < 0 ? -qx.hi >> 1 : qx.hi >> 1;
+      qx.lo &= ~0xffffffffULL;
+      err = fxq64_mul (&qr, qx, qx, FX_TOWARDZERO);
+      err |= fxq64_sqrt (&qy, qr, FX_DOWNWARD);
+      check_q ("fxq64_sqrt (x x)", err, qy, 0, qx.hi, qx.lo);
+      dx = d ((rnd () >> 4) + 1000000000000000000ULL);
+      err = fxd18_mul (&dr, dx, dx, FX_TONEAREST);
+      err |= fxd18_sqrt (&dy, dr, FX_TONEAREST);
+      check_d ("fxd18_sqrt (x x)", err, dy, 0, dx.lo);
+    }
+
+  /* Errors.  */
+  qr = q (7, 7);
+  check_q ("fxq64_add overflow", fxq64_add (&qr, q (0x7fffffffffffffffLL, 0),
+					    q (1, 0)), qr, ERANGE, 7, 7);
+  check_q ("fxq64_sub overflow", fxq64_sub (&qr, q (-0x7fffffffffffffffLL - 1,
+						    0), q (0, 1)),
+	   qr, ERANGE, 7, 7);
+  check_q ("fxq64_mul overflow", fxq64_mul (&qr, q (1LL << 32, 0),
+					    q (1LL << 31, 0), FX_TONEAREST),
+	   qr, ERANGE, 7, 7);
+  check_q ("fxq64_mul -2^63", fxq64_mul (&qr, q (-(1LL << 32), 0),
+					 q (1LL << 31, 0), FX_TONEAREST),
+	   qr, 0, -0x7fffffffffffffffLL - 1, 0);
+  check_q ("fxq64_div by zero", fxq64_div (&qr, q (1, 0), q (0, 0),
+					   FX_TONEAREST), qr, EDOM, 0, 0);
+  check_q ("fxq64_mul mode", fxq64_mul (&qr, q (1, 0), q (1, 0), 4),
+	   qr, EDOM, 0, 0);
+  check_q ("fxq64_sqrt (-1)", fxq64_sqrt (&qr, q (-1, 0), FX_TONEAREST),
+	   qr, EDOM, 0, 0);
+  check_q ("fxq64_ln (0)", fxq64_ln (&qr, q (0, 0)), qr, ERANGE, 0, 0);
+  check_q ("fxq64_ln (-1)", fxq64_ln (&qr, q (-1, 0)), qr, EDOM, 0, 0);
+  check_q ("fxq64_exp (44)", fxq64_exp (&qr, q (44, 0)), qr, ERANGE, 0, 0);
+  check_q ("fxq64_exp (-46)", fxq64_exp (&qr, q (-46, 0)), qr, 0, 0, 0);
+  check_q ("fxq64_exp2 (63)", fxq64_exp2 (&qr, q (63, 0)), qr, ERANGE, 0, 0);
+  check_q ("fxq64_exp2 (-1e9)", fxq64_exp2 (&qr, q (-1000000000, 0)),
+	   qr, 0, 0, 0);
+  check_q ("fxq64_pow (0, -1)", fxq64_pow (&qr, q (0, 0), q (-1, 0)),
+	   qr, ERANGE, 0, 0);
+  check_q ("fxq64_pow (-2, 2)", fxq64_pow (&qr, q (-2, 0), q (2, 0)),
+	   qr, EDOM, 0, 0);
+  check_q ("fxq64_pow (2, 64)", fxq64_pow (&qr, q (2, 0), q (64, 0)),
+	   qr, ERANGE, 0, 0);
+  dr = d (7);
+  check_d ("fxd18_sub below zero", fxd18_sub (&dr, d (1), d (2)),
+	   dr, ERANGE, 7);
+  check_d ("fxd18_ln (0.5)", fxd18_ln (&dr, d (500000000000000000ULL)),
+	   dr, ERANGE, 7);
+  check_d ("fxd18_ln (0)", fxd18_ln (&dr, d (0)), dr, ERANGE, 7);
+  check_d ("fxd18_exp (100)", fxd18_exp (&dr, fxd18_from_uint (100)),
+	   dr, ERANGE, 7);
+  check_d ("fxd18_div by zero", fxd18_div (&dr, d (1), d (0), FX_TONEAREST),
+	   dr, EDOM, 7);
+  check_d ("fxd18_from_q64 (-1)", fxd18_from_q64 (&dr, q (-1, 0),
+						  FX_TONEAREST), dr, ERANGE, 7);
+  check_d ("fxd18_pow (0.5, 100)", fxd18_pow (&dr, d (500000000000000000ULL),
+					     fxd18_from_uint (100)), dr, 0, 0);
+
+  exit (0);
+}
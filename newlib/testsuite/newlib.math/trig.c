@@ -0,0 +1,188 @@
+/* Test sin, cos, tan and sincos against correctly rounded results,
+   allowing one ulp, on arguments from below pi/4 up to the largest
+   doubles.  Also check that sincos gives the same results as sin and
+   cos, the symmetries, and the special cases.  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include "check.h"
+#include "rnd.h"
+
+struct pair
+{
+  double x, want;
+};
+
+static const struct pair sin_vec[] = {
+  { 0x1.bf64a43948b5fp-1, 0x1.8897ce9570468p-1 },
+  { 0x1.10a7a7069d372p-1, 0x1.03f311624838ep-1 },
+  { -0x1.081b1f28acc63p-2, -0x1.0530058eeb48dp-2 },
+  { 0x1.20a5bc6605aeep+2, -0x1.f58fc2480f0d4p-1 },
+  { 0x1.89ec3bac29b8dp+2, -0x1.05b77d1478d6ap-3 },
+  { -0x1.d73b5bc94d0d0p-1, -0x1.9776d8605a866p-1 },
+  { 0x1.00e8126f86b7ep+3, 0x1.f83cf0cd7b390p-1 },
+  { -0x1.e08b9a4a8e8aap+3, -0x1.46455cb2a38bbp-1 },
+  { -0x1.6f926efe36e8fp+2, 0x1.072e85add6dd1p-1 },
+  { -0x1.8ad941217f175p+6, 0x1.f055b1ed9810ap-1 },
+  { -0x1.3d131990e2911p+5, -0x1.de60ae6a660a9p-1 },
+  { 0x1.e9e80d631b778p+3, 0x1.8d3dfc6cebf8fp-2 },
+  { 0x1.761ab5dbbb441p+10, 0x1.b413caabe344dp-1 },
+  { -0x1.1186fd1071c8fp+13, -0x1.8b65ee1558580p-2 },
+  { -0x1.6c88a531eaf32p+11, -0x1.880e608ff2bd8p-1 },
+  { -0x1.d5f74e7825294p+18, 0x1.645b971e7dcbfp-2 },
+  { 0x1.41d2428ce42d6p+19, 0x1.6025e123421f8p-2 },
+  { 0x1.86b97f5088fefp+19, 0x1.f4c7d37311caap-2 },
+  { -0x1.3ce2dd6e6dadep+32, -0x1.6479b62b6a802p-3 },
+  { 0x1.eeee76fe0e5c2p+31, -0x1.4c5fdc8aa196ap-3 },
+  { 0x1.34466544c5efdp+31, 0x1.8c4ffde400939p-1 },
+  { 0x1.e2d0231a95741p+67, -0x1.ecf974cc449e4p-1 },
+  { 0x1.f6de1f1900912p+66, 0x1.e9e5c98373309p-1 },
+  { -0x1.a964421d0dd55p+68, -0x1.fd7e8d08633c4p-1 },
+  { 0x1.48ca14374ffd5p+334, 0x1.c49ca4f40b157p-4 },
+  { -0x1.2a5310627305cp+334, -0x1.ffa3337da0de1p-1 },
+  { 0x1.5df0da6d3acaep+335, -0x1.fc9d4779a495bp-1 },
+  { 0x1.64f1d0b8f1a76p+999, -0x1.baab8091f0475p-1 },
+  { -0x1.16657f4748e86p+999, -0x1.076b87749036fp-1 },
+  { 0x1.720149d6d2e67p+999, -0x1.c8856b2b93c94p-1 },
+};
+
+static const struct pair cos_vec[] = {
+  { 0x1.3e8b613d22054p-2, 0x1.e76d11245cd6bp-1 },
+  { -0x1.b9b57a5b7f17cp-1, 0x1.4cfe83371133cp-1 },
+  { -0x1.95a17dd9b6c79p-2, 0x1.d85a3eac47579p-1 },
+  { 0x1.1e0912cdd7fa4p+2, -0x1.ecf3336449176p-3 },
+  { -0x1.6bb0ec30f1d44p+1, -0x1.e917f2ab02388p-1 },
+  { 0x1.35bdc55c39b43p+2, 0x1.040b7b224d3e3p-3 },
+  { -0x1.de0d840bfb91cp+2, 0x1.80026923cdac8p-2 },
+  { 0x1.c6c9d02c17718p+1, -0x1.d545702ebec23p-1 },
+  { 0x1.168700dfee5f4p+2, -0x1.691c7753d79acp-2 },
+  { -0x1.92192f4913c7cp+3, 0x1.fffff55c86bf0p-1 },
+  { 0x1.8623c81f3aadap+6, -0x1.fa95afa0b75a8p-1 },
+  { -0x1.3007512f8fee2p+5, 0x1.e873d35c8ea72p-1 },
+  { 0x1.c31318dfeadfbp+12, -0x1.27a1d68ce0037p-1 },
+  { -0x1.cbcedecf0e2aep+12, 0x1.8decb4a4663c1p-1 },
+  { 0x1.92cb0d66c6e2bp+12, -0x1.216f5794069dbp-2 },
+  { 0x1.dc044f04cf2f8p+19, -0x1.4fffaa8c50d4fp-1 },
+  { 0x1.b44abf15f818dp+19, 0x1.c7ffbb78e38f5p-1 },
+  { -0x1.ff718ccf3b5a9p+18, -0x1.1344b61ddfb89p-1 },
+  { 0x1.1fa197ace5cb3p+33, 0x1.9da35faee07f8p-3 },
+  { -0x1.78a53dc08c0a0p+30, -0x1.87245f3efda22p-4 },
+  { 0x1.8f9e4973a9ec2p+31, -0x1.34866c0303681p-1 },
+  { -0x1.0c90c049b4d09p+69, -0x1.fd23135500622p-1 },
+  { -0x1.60f86037c2486p+67, -0x1.a39909c86d1f7p-1 },
+  { -0x1.0cdfd6a95d17cp+69, 0x1.7105bc5194d08p-1 },
+  { 0x1.68b1cc6266dc6p+335, -0x1.0e6758a780ebap-2 },
+  { -0x1.09ee2b84fdf7ep+335, -0x1.fb0eef73fe25bp-1 },
+  { 0x1.fe9aba4513e7dp+334, -0x1.e1da8738e3e96p-1 },
+  { -0x1.90f4bf6b09137p+996, 0x1.8c56b6ed28da4p-2 },
+  { 0x1.68d4541b019a7p+999, 0x1.62b6ff2215f9cp-1 },
+  { 0x1.26e7738028c19p+997, -0x1.cdf890e1b0874p-2 },
+};
+
+static const struct pair tan_vec[] = {
+  { 0x1.45704a22e29bep-2, 0x1.50db66be879cep-2 },
+  { -0x1.df89654a7286ap-2, -0x1.02fba1033fcfap-1 },
+  { -0x1.8008b0816464dp-1, -0x1.dd0a716a24784p-1 },
+  { 0x1.ebce99f17783dp+1, 0x1.afd219f827e73p-1 },
+  { -0x1.c7ac1220273aep+1, -0x1.c742a6ccf40e4p-2 },
+  { 0x1.1e0cd252dccc9p+2, 0x1.02542aeff41dbp+2 },
+  { -0x1.21d1a70fcf92cp+3, 0x1.8abdeaa701022p-2 },
+  { -0x1.98ffb06dd96fbp+3, -0x1.bee469c1d7635p-3 },
+  { 0x1.3243045fa6298p+4, 0x1.3396e5bfb8f9fp-2 },
+  { 0x1.3a080d350ffdfp+5, 0x1.f4af88414cbf1p+5 },
+  { 0x1.dd7deab26c2eap+5, -0x1.ef244325ad59cp-9 },
+  { -0x1.8054de6cb2402p+6, 0x1.d8f61b5af7893p+1 },
+  { -0x1.01b37350378bcp+12, -0x1.fe8c201bf952fp+2 },
+  { -0x1.1ef67a7250b2bp+10, -0x1.2dff692d3af40p+1 },
+  { 0x1.bc495b9226852p+12, -0x1.1d35f6e0a76b3p+0 },
+  { 0x1.eb22de37c69a2p+18, -0x1.822d750c48ffcp+4 },
+  { 0x1.64ef0d2d7024cp+18, 0x1.ad998804f1cb4p+0 },
+  { -0x1.fcb6499b30443p+17, -0x1.3bf7fbb722781p-1 },
+  { 0x1.e05b70b97ca45p+30, 0x1.824d311d4bdf4p+3 },
+  { -0x1.713c68bd834efp+31, 0x1.597a018b65765p+0 },
+  { 0x1.de0f5edce3cb9p+32, 0x1.a320093192f4ep+2 },
+  { -0x1.aa2f64b7233b5p+68, -0x1.675e76c42199bp-2 },
+  { 0x1.3f78873a4254dp+69, -0x1.c24787cc01b05p+0 },
+  { -0x1.27b4baa2a5a90p+69, 0x1.d4f39162d2f7ep-2 },
+  { 0x1.cf80fb32fef44p+333, 0x1.b781dbb4e5836p+0 },
+  { 0x1.6ffce0a88602cp+334, -0x1.5f23570b72a20p+2 },
+  { 0x1.3fb4d0a4597f9p+334, -0x1.c61abc3db32f0p-3 },
+  { -0x1.a9d8d60ad2e57p+998, 0x1.707287247f05ap+3 },
+  { 0x1.99f91108c4977p+999, 0x1.7d9097108c353p+4 },
+  { -0x1.911828920aaf3p+998, -0x1.0e4528e6b92a4p-2 },
+};
+
+/* The distance between A and B in units in the last place.  */
+static unsigned long long
+ulps (double a, double b)
+{
+  long long ia, ib;
+
+  memcpy (&ia, &a, sizeof (ia));
+  memcpy (&ib, &b, sizeof (ib));
+  if ((ia < 0) != (ib < 0))
+    return a == b ? 0 : ~0ULL;
+  return ia > ib ? ia - ib : ib - ia;
+}
+
+static void
+check (const char *name, double x, double got, double want,
+       unsigned long long tol)
+{
+  if (ulps (got, want) > tol)
+    printf ("%s (%a) = %a, want %a\n", name, x, got, want);
+  CHECK (ulps (got, want) <= tol);
+}
+
+#define N(a) (sizeof (a) / sizeof ((a)[0]))
+
+int
+main (void)
+{
+  union { double d; unsigned long long u; } v;
+  double s, c;
+  int i;
+
+  for (i = 0; i < N (sin_vec); i++)
+    check ("sin", sin_vec[i].x, sin (sin_vec[i].x), sin_vec[i].want, 1);
+  for (i = 0; i < N (cos_vec); i++)
+    check ("cos", cos_vec[i].x, cos (cos_vec[i].x), cos_vec[i].want, 1);
+  for (i = 0; i < N (tan_vec); i++)
+    check ("tan", tan_vec[i].x, tan (tan_vec[i].x), tan_vec[i].want, 1);
+
+  /* sincos is sin and cos, and the functions are odd and even, on
+     arguments of every size.  */
+  for (i = 0; i < 100000; i++)
+    {
+      v.u = rnd () & 0x7fffffffffffffffULL;
+      v.u = (v.u & 0x800fffffffffffffULL) | ((v.u >> 52) % 1100 + 923) << 52;
+      sincos (v.d, &s, &c);
+      check ("sincos", v.d, s, sin (v.d), 0);
+      check ("sincos", v.d, c, cos (v.d), 0);
+      check ("sin", -v.d, sin (-v.d), -s, 0);
+      check ("cos", -v.d, cos (-v.d), c, 0);
+      check ("tan", -v.d, tan (-v.d), -tan (v.d), 0);
+    }
+
+  /* Exact results and the tiny arguments.  */
+  check ("sin", 0, sin (0), 0, 0);
+  check ("cos", 0, cos (0), 1, 0);
+  check ("tan", -0.0, tan (-0.0), -0.0, 0);
+  check ("sin", 0x1p-30, sin (0x1p-30), 0x1p-30, 0);
+  check ("cos", 0x1p-30, cos (0x1p-30), 1, 0);
+  check ("tan", 0x1p-1074, tan (0x1p-1074), 0x1p-1074, 0);
+  check ("sin", M_PI, sin (M_PI), 0x1.1a62633145c07p-53, 0);
+  check ("cos", M_PI_2, cos (M_PI_2), 0x1.1a62633145c07p-54, 0);
+
+  /* Special cases.  */
+  CHECK (isnan (sin (INFINITY)) && isnan (cos (-INFINITY)));
+  CHECK (isnan (tan (INFINITY)) && isnan (sin (NAN)));
+  sincos (INFINITY, &s, &c);
+  CHECK (isnan (s) && isnan (c));
+
+  exit (0);
+}
@@ -0,0 +1,543 @@
+/* Test sqrt, exp, exp2, log, log2 and pow against correctly rounded
+   results, allowing one ulp, which both the fdlibm code and the
+   integer kernels of --enable-newlib-integer-math meet.  Also check
+   the results that have to be exact, that sqrt is correctly rounded on
+   squares, and the errors reported for the special cases.
+
+   The fdlibm functions that call exp, log or pow internally are
+   checked too, since with the integer kernels those calls go to
+   different code; the tolerances are what the fdlibm algorithms
+   reach with either.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include "check.h"
+#include "rnd.h"
+
+struct pair
+{
+  double x, want;
+};
+
+struct triple
+{
+  double x, y, want;
+};
+
+static const struct pair exp_vec[] = {
+  { -0x1.be3aac4881ddep+8, 0x1.2bb24fb40de0cp-644 },
+  { 0x1.c4016acb16c44p+7, 0x1.0997c4a37516ap+326 },
+  { -0x1.cf3b9ad22d22ap+7, 0x1.ccd8fb39313dcp-335 },
+  { -0x1.a6e272246a4e1p+8, 0x1.dfe3106029414p-611 },
+  { -0x1.d5b67ac2260c0p+3, 0x1.c4ffc365cce51p-22 },
+  { -0x1.0b3f127f58480p+3, 0x1.ef0a9df06664cp-13 },
+  { -0x1.c5185884ad440p+4, 0x1.1b17455bde3cbp-41 },
+  { -0x1.d2b1072668ea0p+5, 0x1.c9b73bd731f96p-85 },
+  { -0x1.49a856edadeaap+8, 0x1.52e2664ed69abp-476 },
+  { -0x1.58adbeaaa255fp+8, 0x1.a9b86b940975bp-498 },
+  { 0x1.0ca1d3f5a6662p+8, 0x1.77e9db25797e5p+387 },
+  { -0x1.eb92bd15434fap+7, 0x1.52f10a1871634p-355 },
+  { 0x1.660853c32f950p-2, 0x1.6b26a4977fc59p+0 },
+  { 0x1.2610fe9650836p-1, 0x1.c6a6299d169c1p+0 },
+  { 0x1.76ba6dfbcb77ap-1, 0x1.0a1cf34be0ef2p+1 },
+  { 0x1.c6af6267d17cep-1, 0x1.37176cbd1bf5dp+1 },
+  { -0x1.0fd00fea5d494p-1, 0x1.2d1970ad6a2bep-1 },
+  { -0x1.0ce7dee65f012p-1, 0x1.2ed0552228b44p-1 },
+  { 0x1.e0ec4b5d93bf4p-2, 0x1.9974abf51ba51p+0 },
+  { 0x1.356cc303f6b10p-3, 0x1.29c0bb1de62a6p+0 },
+  { 0x1.b7cdfd9d7bdbbp-34, 0x1.000000006df38p+0 },
+  { -0x1.9c511dc3a41dfp-29, 0x1.ffffffe63aee2p-1 },
+  { 0x1.0000000000000p-1, 0x1.a61298e1e069cp+0 },
+  { 0x1.0000000000000p+0, 0x1.5bf0a8b145769p+1 },
+};
+
+static const struct pair exp2_vec[] = {
+  { -0x1.3017d5f928d5ap+9, 0x1.c2001bda28493p-609 },
+  { 0x1.6a5071b666254p+8, 0x1.3e4c55c6be12fp+362 },
+  { 0x1.7cb71991e7232p+9, 0x1.5900ef7b41bb8p+761 },
+  { 0x1.56808cd9f13f2p+9, 0x1.00c38d768907ep+685 },
+  { -0x1.2194f6f5ac47ap+9, 0x1.c90d38bca235bp-580 },
+  { -0x1.9a24a4576d128p+8, 0x1.cfa457eba49b1p-411 },
+  { -0x1.f7342cf9ccd8cp+9, 0x1.81fa8c7bd6c76p-1007 },
+  { 0x1.e53178a2b0134p+9, 0x1.4ea57f5229fe4p+970 },
+  { -0x1.1d269147189f8p+9, 0x1.9f7f07074b1ddp-571 },
+  { 0x1.cf4aee5d82f50p+8, 0x1.3995084cb98f6p+463 },
+  { 0x1.353ded00d58c0p+6, 0x1.3d78345d65553p+77 },
+  { 0x1.7d53c68c55f78p+7, 0x1.9584c11d89e0ep+190 },
+  { 0x1.b609fa2d5c300p-5, 0x1.09aa943bc5b61p+0 },
+  { 0x1.4d577522816f8p-1, 0x1.920070e464475p+0 },
+  { 0x1.99505b6ade930p-3, 0x1.2609ce5bf1ac6p+0 },
+  { -0x1.9311b872b9f60p-2, 0x1.85be1925dbf4ep-1 },
+  { -0x1.8a69f35bfd7bep-1, 0x1.2c2cd22af9b55p-1 },
+  { -0x1.7232a374f3760p-5, 0x1.f036028ab015ap-1 },
+  { 0x1.b11ab14018cbep-1, 0x1.cc22050e7b5dbp+0 },
+  { -0x1.6b5016c081fd0p-1, 0x1.39156d7245171p-1 },
+  { 0x1.19799812dea11p-40, 0x1.0000000000c32p+0 },
+  { -0x1.8000000000000p-1, 0x1.306fe0a31b715p-1 },
+  { 0x1.999999999999ap-4, 0x1.125fbee250664p+0 },
+  { 0x1.c000000000000p+1, 0x1.6a09e667f3bcdp+3 },
+};
+
+static const struct pair log_vec[] = {
+  { 0x1.d334a226b7099p+367, 0x1.fdf9249572d85p+7 },
+  { 0x1.2afb32fb71f22p+262, 0x1.6b84ffe16a51ap+7 },
+  { 0x1.6fc6aaf645b4dp-680, -0x1.d6fa502fa30ffp+8 },
+  { 0x1.98e0c1fdeeb75p-587, -0x1.9668be6dafcb8p+8 },
+  { 0x1.681d39590ef25p+372, 0x1.02312692542f8p+8 },
+  { 0x1.f72694867930ep-127, -0x1.5d6a79a38bc81p+6 },
+  { 0x1.035263ef71a1ep-186, -0x1.01d330fce6388p+7 },
+  { 0x1.9a9e64d2d4020p-40, -0x1.b40decb1a4a9cp+4 },
+  { 0x1.5c3819e32a0dap-798, -0x1.14697221b6497p+9 },
+  { 0x1.2607ce5ab0c37p+409, 0x1.1ba2bd6c91c05p+8 },
+  { 0x1.b140ee9be7b2cp+176, 0x1.ea1487e654046p+6 },
+  { 0x1.578b9a69f3aa9p+68, 0x1.7b6cd9d90dad1p+5 },
+  { 0x1.ffd5f6170361bp-1, -0x1.505d172821516p-12 },
+  { 0x1.0028d717dc7eep+0, 0x1.469eb1f87afbdp-11 },
+  { 0x1.002a767abae57p+0, 0x1.5397ac97e8f53p-11 },
+  { 0x1.0005e1594f5eap+0, 0x1.7852016d32851p-14 },
+  { 0x1.ff942d1b953b3p-1, -0x1.af790204fe25dp-11 },
+  { 0x1.ffa3b3c3a5271p-1, -0x1.71523c4dced06p-11 },
+  { 0x1.0000000001000p+0, 0x1.ffffffffff000p-41 },
+  { 0x1.fffffffffff00p-1, -0x1.0000000000040p-45 },
+  { 0x1.999999999999ap-4, -0x1.26bb1bbb55515p+1 },
+  { 0x1.4000000000000p+3, 0x1.26bb1bbb55516p+1 },
+  { 0x1.8000000000000p+1, 0x1.193ea7aad030bp+0 },
+  { 0x0.012688b70e62bp-1022, -0x1.64e69394d9508p+9 },
+};
+
+static const struct pair log2_vec[] = {
+  { 0x1.d334a226b7099p+367, 0x1.6fde2f9885944p+8 },
+  { 0x1.2afb32fb71f22p+262, 0x1.0639523e52270p+8 },
+  { 0x1.6fc6aaf645b4dp-680, -0x1.53bd18b344d59p+9 },
+  { 0x1.98e0c1fdeeb75p-587, -0x1.25298859180e7p+9 },
+  { 0x1.681d39590ef25p+372, 0x1.747e080fa8a58p+8 },
+  { 0x1.f72694867930ep-127, -0x1.f819c1c4a1b78p+6 },
+  { 0x1.035263ef71a1ep-186, -0x1.73f67a13428d4p+7 },
+  { 0x1.9a9e64d2d4020p-40, -0x1.3a8bf82484f70p+5 },
+  { 0x1.5c3819e32a0dap-798, -0x1.8ec72fddf6114p+9 },
+  { 0x1.2607ce5ab0c37p+409, 0x1.993327884f38cp+8 },
+  { 0x1.b140ee9be7b2cp+176, 0x1.6184a491b4400p+7 },
+  { 0x1.578b9a69f3aa9p+68, 0x1.11b28a8c0f1a0p+6 },
+  { 0x1.ffd5f6170361bp-1, -0x1.e545286409b0fp-12 },
+  { 0x1.0028d717dc7eep+0, 0x1.d73681903eaa0p-11 },
+  { 0x1.002a767abae57p+0, 0x1.e9edaa813d19cp-11 },
+  { 0x1.0005e1594f5eap+0, 0x1.0f752e7321aa4p-13 },
+  { 0x1.ff942d1b953b3p-1, -0x1.373de385870c4p-10 },
+  { 0x1.ffa3b3c3a5271p-1, -0x1.0a68b14d973ecp-10 },
+  { 0x1.0000000001000p+0, 0x1.71547652b7773p-40 },
+  { 0x1.fffffffffff00p-1, -0x1.71547652b835ap-45 },
+  { 0x1.999999999999ap-4, -0x1.a934f0979a371p+1 },
+  { 0x1.4000000000000p+3, 0x1.a934f0979a371p+1 },
+  { 0x1.8000000000000p+1, 0x1.95c01a39fbd68p+0 },
+  { 0x0.012688b70e62bp-1022, -0x1.01730dabca5f6p+10 },
+};
+
+static const struct triple pow_vec[] = {
+  { 0x1.9b4ea19e460a6p+0, -0x1.944fb33a0d4b8p+4, 0x1.a3e372d8f6a85p-18 },
+  { 0x1.a12b2031bc260p+2, 0x1.4df33b1255bd0p+1, 0x1.0a203953c0303p+7 },
+  { 0x1.0f23a6e21a0e1p+1, 0x1.89f155e608850p+4, 0x1.95252c84373e8p+26 },
+  { 0x1.956ebda3f365bp+2, 0x1.187a419d75bbcp+4, 0x1.9c4db18ef856cp+46 },
+  { 0x1.065b277b17f79p+3, 0x1.5c88e355f88bcp+3, 0x1.0af6ec97ce908p+33 },
+  { 0x1.542a74394cbeep+2, 0x1.d158277eb9196p+4, 0x1.11786005b4ccdp+70 },
+  { 0x1.6a6b01db4a95dp+0, 0x1.6b67f65b63de8p+3, 0x1.9e8afa5f6a40ep+5 },
+  { 0x1.1b53be8f0d2ddp+3, -0x1.4bef8b7f9dd80p+0, 0x1.e4840a754fc20p-5 },
+  { 0x1.00000aa4ad5dap+0, -0x1.e6359c5ca575fp+25, 0x1.986b44e1e7bc7p-59 },
+  { 0x1.fffffa60fa8c6p-1, -0x1.5d9ad4144b1c6p+25, 0x1.0da398e83a099p+11 },
+  { 0x1.fffff915a740fp-1, 0x1.340979cc866c0p+25, 0x1.fe4a436fb6af3p-13 },
+  { 0x1.ffffe813e4288p-1, -0x1.ecf5cbc822020p+24, 0x1.2c1298863fb05p+33 },
+  { 0x1.00000b9caea5ap+0, -0x1.2f0532d85eb82p+25, 0x1.4432d64a6eeb7p-40 },
+  { 0x1.ffffe6e7b30adp-1, 0x1.792a7c19dac4ap+26, 0x1.3f9133915459dp-107 },
+  { 0x1.eb1c3456d0cb7p+4, -0x1.ce9927e42a17fp+3, 0x1.80c14ce1bf0d7p-72 },
+  { 0x1.783bd5cdc3011p+8, -0x1.53cf2f8bc8175p+3, 0x1.1bd7bcadcc8d5p-91 },
+  { 0x1.73091f3de1e07p-41, 0x1.ca6dab91c70b0p+2, 0x1.1ced37a5e9a5ep-290 },
+  { 0x1.330c4d67e4f9dp+18, -0x1.1aaabd3d4281cp+1, 0x1.9780db91ce7c2p-41 },
+  { 0x1.a8adc58bdf15ap+1, 0x1.c2833b9a551c0p+0, 0x1.0816d6cde3559p+3 },
+  { 0x1.0cec4fa50c65dp-5, -0x1.7ed7557ef343cp+3, 0x1.f51523860079cp+58 },
+  { -0x1.985d0299fe80ap+1, -0x1.0000000000000p+3, 0x1.86cf66a8fd0c0p-14 },
+  { -0x1.fa1c2513313a2p+0, 0x1.6000000000000p+3, -0x1.c2cf76d752b96p+10 },
+  { -0x1.16e058622f682p+1, 0x1.f000000000000p+4, -0x1.c66fc0f350c68p+34 },
+  { -0x1.1372f578a74f0p+1, 0x1.a000000000000p+3, -0x1.4b9c149a2513dp+14 },
+};
+
+static const struct pair cosh_vec[] = {
+  { 0x1.79cce30f2a0a0p+2, 0x1.6e2f466e2776cp+7 },
+  { -0x1.3148916387540p+4, 0x1.70dc75d2e8db0p+26 },
+  { 0x1.ab762733d2af0p+3, 0x1.3510d4500b124p+18 },
+  { 0x1.5a6c3badeeba0p+3, 0x1.88f324036957cp+14 },
+  { 0x1.02cc340705a40p+1, 0x1.ebd2da2135ca3p+1 },
+  { 0x1.68a0f09f5fd80p+2, 0x1.18034ec82bb36p+7 },
+  { -0x1.3d022c3a08268p+4, 0x1.7fc9631e6812ep+27 },
+  { -0x1.5df4bd0c1e920p+3, 0x1.b6d290579493ap+14 },
+  { -0x1.45962c382ff30p+3, 0x1.99cfe01ae6b3bp+13 },
+  { -0x1.56e20f1a4972cp+8, 0x1.98eadb2dad9f1p+493 },
+  { 0x1.4e7e823baf36ap+9, 0x1.1b4c295e4f454p+964 },
+  { -0x1.52e74fb5f8980p+9, 0x1.d38c4cd65421cp+976 },
+};
+
+static const struct pair sinh_vec[] = {
+  { 0x1.2b5aa346d2788p+4, 0x1.fd45391feec52p+25 },
+  { 0x1.c1c8b15781a80p+2, 0x1.19e854eb4694fp+9 },
+  { 0x1.2e4ad5e7c93d8p+4, 0x1.31f74b8424e58p+26 },
+  { -0x1.b6414f403ed40p+2, -0x1.d6df6c0f3047fp+8 },
+  { 0x1.5c91e2e164150p+3, 0x1.a4384a8cf5ccbp+14 },
+  { 0x1.0677c99f3d940p+4, 0x1.964721c772102p+22 },
+  { -0x1.d70be5bf3f820p+2, -0x1.88ffad324fa85p+9 },
+  { 0x1.b934255654280p+1, 0x1.f5f04f865e30cp+3 },
+  { 0x1.d10bdd1ee2f20p+2, 0x1.65d422c95ce99p+9 },
+  { -0x1.4883ff0d5479ep+9, -0x1.dc4937a81de8bp+946 },
+  { 0x1.7d8c90ef6c59dp+8, 0x1.5fe37bdb95400p+549 },
+  { -0x1.a27fa096a648cp+8, -0x1.b345b2525afa6p+602 },
+};
+
+static const struct pair acosh_vec[] = {
+  { 0x1.000000e263ba1p+0, 0x1.54752c82d78fdp-12 },
+  { 0x1.00000014b8fc9p+0, 0x1.9c04d65465cb1p-14 },
+  { 0x1.001cb4555550bp+0, 0x1.e4e6cb4d85979p-6 },
+  { 0x1.000a3f87ca502p+0, 0x1.21be1c588a6c3p-6 },
+  { 0x1.37c0f19df2418p+6, 0x1.43233a0d4c573p+2 },
+  { 0x1.23327506d8c14p+6, 0x1.3ec58682413adp+2 },
+  { 0x1.19add146510c9p+6, 0x1.3ca4fe783a290p+2 },
+  { 0x1.3ac3aee03261ap+5, 0x1.1762328517e61p+2 },
+  { 0x1.695af740a11fdp+6, 0x1.4c967859e2edap+2 },
+  { 0x1.a93a7f42e5bcdp+499, 0x1.5b14bf017c346p+8 },
+  { 0x1.b1560440ffbbap+370, 0x1.01af16b06595dp+8 },
+  { 0x1.f9920ea3ab7b0p+395, 0x1.132ab2fca343cp+8 },
+};
+
+static const struct pair log10_vec[] = {
+  { 0x1.6b769ac7c2502p+709, 0x1.ab2a3bce0bd85p+7 },
+  { 0x1.8e030f701d574p+217, 0x1.060f877805bc5p+6 },
+  { 0x1.90cbee02d8c5ap+201, 0x1.e59d1bce64a0ap+5 },
+  { 0x1.67ea83f51d83bp+948, 0x1.1d863ee494cc6p+8 },
+  { 0x1.68a8826b787a3p+869, 0x1.05be71ae30ea2p+8 },
+  { 0x1.246ca0c31367fp-606, -0x1.6cbb9948a2bcap+7 },
+  { 0x1.d175f696bf746p-393, -0x1.d82e3a8817083p+6 },
+  { 0x1.a2e4a7c21caf5p-503, -0x1.2e68901cc0448p+7 },
+  { 0x1.3d14e621a72f6p+4, 0x1.4c0b8a9ba5211p+0 },
+  { 0x1.52c3cfbb08bc0p-1, -0x1.6f5a5c8f4ef19p-3 },
+  { 0x1.607ac91cba1b9p+3, 0x1.0abf776d55125p+0 },
+  { 0x1.e760b8b8c1372p+3, 0x1.2ec6762215b42p+0 },
+};
+
+static const struct pair asinh_vec[] = {
+  { 0x1.d1afaf0768e09p-20, 0x1.d1afaf0767dfcp-20 },
+  { -0x1.323edcbcad245p-12, -0x1.323edc73a226dp-12 },
+  { 0x1.52fdbf3af7cb4p-27, 0x1.52fdbf3af7cb4p-27 },
+  { -0x1.5c5e7e843cf81p-3, -0x1.5ab5ebc5af9fdp-3 },
+  { 0x1.778aa40a40005p+6, 0x1.4f0e5770ccd8fp+2 },
+  { -0x1.acbb8c594f262p+5, -0x1.2b2d12ffbd14ap+2 },
+  { 0x1.4153a9ffb6a2ap+4, 0x1.d8c9143c1d195p+1 },
+  { -0x1.5e296f0784b72p+6, -0x1.4a93f66a7a489p+2 },
+  { 0x1.ffb558ff6c66ep+1, 0x1.0c0d6e170c106p+1 },
+  { -0x1.93e2232b71b89p+758, -0x1.0746ff0e6223cp+9 },
+  { 0x1.32f7f7e652653p+878, 0x1.30ba9dc59a7eap+9 },
+  { -0x1.4a19369f91acep+360, -0x1.f4f5efe287074p+7 },
+};
+
+static const struct pair erf_vec[] = {
+  { 0x1.a76ec82b16d00p-1, 0x1.8402397b57987p-1 },
+  { -0x1.acd94ed0d1800p-2, -0x1.c90aaded9c371p-2 },
+  { -0x1.d582269119100p-1, -0x1.9c525ad9a2fb9p-1 },
+  { 0x1.25101e79fa700p+0, 0x1.ca01ac3ba15bap-1 },
+  { -0x1.7c78b7e7defc0p+1, -0x1.fffc8ebc33b38p-1 },
+  { 0x1.9353479fa6e00p+1, 0x1.fffee804009e0p-1 },
+  { 0x1.491305674d8c0p+1, 0x1.ffdbad1f07252p-1 },
+  { 0x1.20ac06df33200p-1, 0x1.264603e817c3ap-1 },
+  { -0x1.526dd4c43d580p+0, -0x1.e07d6f383f2c5p-1 },
+  { 0x1.b5413c34d1e00p+0, 0x1.f7f47744af5aep-1 },
+  { 0x1.030efd18c9cb8p+2, 0x1.ffffffa6db6f7p-1 },
+  { 0x1.07980974c0ab0p+2, 0x1.ffffffced7004p-1 },
+};
+
+static const struct pair erfc_vec[] = {
+  { -0x1.b0075fdea9c06p+0, 0x1.fba5b249ed404p+0 },
+  { -0x1.ec359c2bdf334p-1, 0x1.d37688204a65fp+0 },
+  { 0x1.6102063910a40p-5, 0x1.e71eb6de129aap-1 },
+  { -0x1.0aa203745990dp+0, 0x1.dbf6e61f73692p+0 },
+  { 0x1.08ac5382bb050p+1, 0x1.c4922840821bep-9 },
+  { 0x1.ec9927b285a40p+1, 0x1.c3508a9b1b317p-25 },
+  { 0x1.5b8bb6443ef0ap+1, 0x1.02275d87d6f24p-13 },
+  { 0x1.2b6afe8114e0ap+2, 0x1.4409e563897b3p-35 },
+  { 0x1.c3004d8a8e92ap+1, 0x1.5046b6ae6c492p-21 },
+  { 0x1.a32454b9b5340p+3, 0x1.ed5b74ee1a933p-253 },
+  { 0x1.257887e76f9fcp+4, 0x1.87f3dae8d8d46p-491 },
+  { 0x1.5163f7321b250p+3, 0x1.5036a467650fcp-165 },
+};
+
+static const struct pair lgamma_vec[] = {
+  { 0x1.80b13076beeadp-1, 0x1.9d515e4793f1fp-3 },
+  { 0x1.027118710f756p-1, 0x1.2048f3e01042ap-1 },
+  { 0x1.afff917fa9afbp-1, 0x1.cab04332f9e6dp-4 },
+  { 0x1.480b49e5bb57ap+3, 0x1.abe0901da8127p+3 },
+  { 0x1.ce44f5d51fdebp+6, 0x1.afe7c3f3b4d14p+8 },
+  { 0x1.43d8044685207p+7, 0x1.4a15a8f588bedp+9 },
+  { 0x1.f741c5489bf0ap+4, 0x1.30d8d43287efep+6 },
+  { 0x1.06077de3df36bp+6, 0x1.9e9169e62de7ap+7 },
+  { 0x1.53fff00fdc760p+7, 0x1.5eb7e3cefeae0p+9 },
+  { -0x1.d87ae505899ddp+0, 0x1.5a36327694875p+0 },
+  { -0x1.3ea6039a9d7e2p+4, -0x1.3cc7b6f749569p+5 },
+  { -0x1.28bcee5b7568ap+4, -0x1.26bbcb347a23bp+5 },
+};
+
+static const struct pair tgamma_vec[] = {
+  { 0x1.91c32501b3854p-2, 0x1.219baa6eb0614p+1 },
+  { 0x1.a99ce1e1a707dp-1, 0x1.218046f60f157p+0 },
+  { 0x1.01b8a69cd7b40p-1, 0x1.c2c67bbfdee4ap+0 },
+  { 0x1.8003841556094p+3, 0x1.30dc46fe89804p+25 },
+  { 0x1.b93ffcd1e3304p+2, 0x1.27ba70027ccc3p+9 },
+  { 0x1.d8756fdd8556cp+4, 0x1.6b9ddb5b2091ep+100 },
+  { 0x1.b10b8d96b683bp+4, 0x1.9d428662be774p+88 },
+  { 0x1.39d32a588c8bcp+3, 0x1.cbdf163f8f802p+17 },
+  { 0x1.a4c85d3998a28p+1, 0x1.530715982f047p+1 },
+  { -0x1.53e6809af5667p-5, -0x1.8b897d317316dp+4 },
+  { -0x1.c0d9415f7870dp+2, 0x1.dd8251ebdbef2p-7 },
+  { -0x1.19bcb087ce063p+2, -0x1.2db0b3dda8082p-4 },
+};
+
+static const struct pair j0_vec[] = {
+  { 0x1.f9c94f2e66292p-3, 0x1.f839036203123p-1 },
+  { 0x1.1f698ddc75226p-2, 0x1.f5f73ff4e3acbp-1 },
+  { 0x1.f66e6a9cb8b90p+1, -0x1.9aa3181517371p-2 },
+  { 0x1.f689f59e6e75cp+2, 0x1.a31faa7007b8fp-3 },
+  { 0x1.a58e9cbfd2b60p+2, 0x1.16e8a98ed2899p-2 },
+  { 0x1.15ab28c43b914p+2, -0x1.6aa4ca01e16fdp-2 },
+  { 0x1.eae5c878dc6b8p+2, 0x1.eb38df6a4946cp-3 },
+  { 0x1.c539bb30ddb18p+1, -0x1.8aa2c77ce5ecbp-2 },
+  { 0x1.6c4ccd7ec7d80p+4, -0x1.566196b46fd34p-3 },
+  { 0x1.66b8f1a7270e0p+4, -0x1.42b3f14a12f98p-3 },
+  { 0x1.318b9b151a860p+5, 0x1.fa0348ab99138p-4 },
+  { 0x1.3b629562bc640p+3, -0x1.e588a5721ff9ep-3 },
+};
+
+static const struct pair j1_vec[] = {
+  { 0x1.76fa88ee209b3p-1, 0x1.5e649471e4c3cp-2 },
+  { 0x1.a7bf35f8bdaf2p-1, 0x1.847c637b857a7p-2 },
+  { 0x1.6211ea1040f60p+1, 0x1.aee0edf3c2effp-2 },
+  { 0x1.38f27f0a74388p+2, -0x1.40b5bfb1e3920p-2 },
+  { 0x1.50ea1ef43f21cp+2, -0x1.61a8d07b2c8a7p-2 },
+  { 0x1.df10d65433f20p+2, 0x1.0d87935392e95p-3 },
+  { 0x1.7e23b1422c0f0p+1, 0x1.60bae677d665bp-2 },
+  { 0x1.ab85ba41a5c68p+2, -0x1.9ef3f01bb68d0p-4 },
+  { 0x1.1c6ad8dfd3a40p+3, 0x1.072d632a385a6p-2 },
+  { 0x1.213561513a800p+4, -0x1.805ea551a1011p-3 },
+  { 0x1.20cb2ef5cbf40p+4, -0x1.80d64b4af35dap-3 },
+  { 0x1.dfdae1aa1df40p+3, 0x1.a44ec5692d28ep-3 },
+};
+
+static const struct pair y0_vec[] = {
+  { 0x1.19ddcfcefcb47p-1, -0x1.7e23068eaf1b7p-2 },
+  { 0x1.69a7a7849d8b9p-2, -0x1.6351640afb79cp-1 },
+  { 0x1.74bf2cf35c2e0p+2, -0x1.4255400eae732p-2 },
+  { 0x1.c9bb77ebba8e0p+0, 0x1.e619eab9f6979p-2 },
+  { 0x1.fc1b3df880b0cp+2, 0x1.b52a98b6699ccp-3 },
+  { 0x1.356a4fde97d50p+2, -0x1.1e36a81cc61d1p-2 },
+  { 0x1.441b591807888p+1, 0x1.f8fff996ce976p-2 },
+  { 0x1.b00a56d5d8450p+1, 0x1.ea740d92bf281p-3 },
+  { 0x1.55f8bf689d720p+4, 0x1.5ccd04abb5e00p-3 },
+  { 0x1.57157e1775a00p+4, 0x1.5772c8f482107p-3 },
+  { 0x1.4530f32ad5360p+4, 0x1.c9a4ecb1b9bd6p-4 },
+  { 0x1.eabf66934c140p+4, -0x1.26d4a850cca6ap-3 },
+};
+
+static const struct pair y1_vec[] = {
+  { 0x1.3c1dc407b1925p-1, -0x1.3ade04075f783p+0 },
+  { 0x1.fa20fc54fe4b2p-3, -0x1.5dcb9961b5b3ep+1 },
+  { 0x1.a3399b8fb30a4p+2, -0x1.1f0e9f3fc26eep-2 },
+  { 0x1.30f3c7172979cp+2, 0x1.cbfd1625eb209p-3 },
+  { 0x1.2d7493742da80p+0, -0x1.46a5753e64163p-1 },
+  { 0x1.aa16f05c60d50p+0, -0x1.3a4066bb8ff75p-2 },
+  { 0x1.4e8128584c7f0p+1, 0x1.8cdca4c3b1d0cp-3 },
+  { 0x1.9cba94b3561ccp+2, -0x1.116d1e72257f5p-2 },
+  { 0x1.cf8c00d523380p+4, 0x1.2ecc6a2d9fc56p-3 },
+  { 0x1.383d700227770p+5, -0x1.bca0ca0871445p-4 },
+  { 0x1.93752362b8c00p+4, -0x1.f741c5e1f841cp-4 },
+  { 0x1.bb47280a53ac0p+3, -0x1.7bb146e336fa1p-3 },
+};
+
+/* { n, x, jn (n, x) } and { n, x, yn (n, x) }.  */
+static const struct triple jn_vec[] = {
+  { 2, 0x1.eb0667346f35ep+2, -0x1.8ce065c06bbd7p-3 },
+  { 3, 0x1.1ed1eaca10606p+4, 0x1.8269181196a06p-3 },
+  { 4, 0x1.3eaf0ed80f5d2p+4, 0x1.1fd4657040ba2p-3 },
+  { 5, 0x1.84059888d0170p+2, 0x1.7620ec6c60adfp-2 },
+  { 6, 0x1.1d66d86c3142bp+4, -0x1.193fb81fa08cdp-3 },
+  { 2, 0x1.d7fe086d23994p+4, 0x1.07d482a4ed85fp-3 },
+  { 3, 0x1.f1ab621b85090p+1, 0x1.b27c3e510f77cp-2 },
+  { 4, 0x1.759aa2301ebd1p+4, -0x1.a1594f4e130c0p-4 },
+  { 5, 0x1.650f9116cbd06p+2, 0x1.50e0f89ba7ad5p-2 },
+  { 6, 0x1.102321f79afaep+3, 0x1.24f756eafd2c7p-2 },
+  { 2, 0x1.032a980c4be3dp+4, 0x1.90e6ae77707c0p-3 },
+  { 3, 0x1.4132edb2a7da8p+4, -0x1.c086a5233ae6ap-4 },
+};
+
+static const struct triple yn_vec[] = {
+  { 2, 0x1.c1c49f452e503p+4, -0x1.dca64d3b5256ap-4 },
+  { 3, 0x1.a5448e740d62ep+2, 0x1.4a8a2750392c9p-2 },
+  { 4, 0x1.13ecd835c22aap+4, -0x1.75259c2c4859ep-3 },
+  { 5, 0x1.2375c585dfe9ap+2, -0x1.288d685075e62p-1 },
+  { 6, 0x1.57c2854bbc8a4p+2, -0x1.2ca5987999e4fp-1 },
+  { 2, 0x1.04d9cf1840d00p+2, 0x1.e5c74cfeca780p-3 },
+  { 3, 0x1.8ddb45d39e384p+4, 0x1.a50a63c0356b2p-4 },
+  { 4, 0x1.587ced934ebafp+4, 0x1.11b19f6c1c944p-3 },
+  { 5, 0x1.310cea34e5cd8p+2, -0x1.088c4b358b1e0p-1 },
+  { 6, 0x1.6f3a4423b3795p+4, 0x1.1be2cb22863d7p-3 },
+  { 2, 0x1.84f24da8289b6p+4, 0x1.4bb3341eac807p-3 },
+  { 3, 0x1.12350299fb48cp+4, -0x1.ee659256abd27p-4 },
+};
+
+/* The distance between A and B in units in the last place.  */
+static unsigned long long
+ulps (double a, double b)
+{
+  long long ia, ib;
+
+  memcpy (&ia, &a, sizeof (ia));
+  memcpy (&ib, &b, sizeof (ib));
+  if ((ia < 0) != (ib < 0))
+    return a == b ? 0 : ~0ULL;
+  return ia > ib ? ia - ib : ib - ia;
+}
+
+static void
+check (const char *name, double x, double y, double got, double want,
+       unsigned long long tol)
+{
+  if (ulps (got, want) > tol)
+    printf ("%s (%a, %a) = %a, want %a\n", name, x, y, got, want);
+  CHECK (ulps (got, want) <= tol);
+}
+
+static void
+check_errno (const char *name, double x, double got, double want, int err)
+{
+  int ok = (isnan (want) ? isnan (got) : got == want) && errno == err;
+
+  if (!ok)
+    printf ("%s (%a) = %a, errno %d, want %a, errno %d\n", name, x, got,
+	    errno, want, err);
+  CHECK (ok);
+  errno = 0;
+}
+
+#define N(a) (sizeof (a) / sizeof ((a)[0]))
+
+int
+main (void)
+{
+  union { double d; unsigned long long u; } v;
+  double x;
+  int i;
+
+  for (i = 0; i < N (exp_vec); i++)
+    check ("exp", exp_vec[i].x, 0, exp (exp_vec[i].x), exp_vec[i].want, 1);
+  for (i = 0; i < N (exp2_vec); i++)
+    check ("exp2", exp2_vec[i].x, 0, exp2 (exp2_vec[i].x), exp2_vec[i].want, 1);
+  for (i = 0; i < N (log_vec); i++)
+    check ("log", log_vec[i].x, 0, log (log_vec[i].x), log_vec[i].want, 1);
+  for (i = 0; i < N (log2_vec); i++)
+    check ("log2", log2_vec[i].x, 0, log2 (log2_vec[i].x), log2_vec[i].want, 1);
+  for (i = 0; i < N (pow_vec); i++)
+    check ("pow", pow_vec[i].x, pow_vec[i].y,
+	   pow (pow_vec[i].x, pow_vec[i].y), pow_vec[i].want, 1);
+
+  for (i = 0; i < N (cosh_vec); i++)
+    check ("cosh", cosh_vec[i].x, 0, cosh (cosh_vec[i].x), cosh_vec[i].want, 1);
+  for (i = 0; i < N (sinh_vec); i++)
+    check ("sinh", sinh_vec[i].x, 0, sinh (sinh_vec[i].x), sinh_vec[i].want, 1);
+  for (i = 0; i < N (acosh_vec); i++)
+    check ("acosh", acosh_vec[i].x, 0, acosh (acosh_vec[i].x),
+	   acosh_vec[i].want, 1);
+  for (i = 0; i < N (log10_vec); i++)
+    check ("log10", log10_vec[i].x, 0, log10 (log10_vec[i].x),
+	   log10_vec[i].want, 1);
+  for (i = 0; i < N (asinh_vec); i++)
+    check ("asinh", asinh_vec[i].x, 0, asinh (asinh_vec[i].x),
+	   asinh_vec[i].want, 1);
+  for (i = 0; i < N (erf_vec); i++)
+    check ("erf", erf_vec[i].x, 0, erf (erf_vec[i].x), erf_vec[i].want, 1);
+  for (i = 0; i < N (erfc_vec); i++)
+    check ("erfc", erfc_vec[i].x, 0, erfc (erfc_vec[i].x), erfc_vec[i].want, 1);
+  for (i = 0; i < N (lgamma_vec); i++)
+    check ("lgamma", lgamma_vec[i].x, 0, lgamma (lgamma_vec[i].x),
+	   lgamma_vec[i].want, 4);
+  /* tgamma is exp (lgamma (x)), which loses more as x grows.  */
+  for (i = 0; i < N (tgamma_vec); i++)
+    check ("tgamma", tgamma_vec[i].x, 0, tgamma (tgamma_vec[i].x),
+	   tgamma_vec[i].want, 64);
+  /* The Bessel functions are checked away from their zeros.  */
+  for (i = 0; i < N (j0_vec); i++)
+    check ("j0", j0_vec[i].x, 0, j0 (j0_vec[i].x), j0_vec[i].want, 4);
+  for (i = 0; i < N (j1_vec); i++)
+    check ("j1", j1_vec[i].x, 0, j1 (j1_vec[i].x), j1_vec[i].want, 4);
+  for (i = 0; i < N (y0_vec); i++)
+    check ("y0", y0_vec[i].x, 0, y0 (y0_vec[i].x), y0_vec[i].want, 4);
+  for (i = 0; i < N (y1_vec); i++)
+    check ("y1", y1_vec[i].x, 0, y1 (y1_vec[i].x), y1_vec[i].want, 4);
+  for (i = 0; i < N (jn_vec); i++)
+    check ("jn", jn_vec[i].x, jn_vec[i].y,
+	   jn ((int) jn_vec[i].x, jn_vec[i].y), jn_vec[i].want, 4);
+  for (i = 0; i < N (yn_vec); i++)
+    check ("yn", yn_vec[i].x, yn_vec[i].y,
+	   yn ((int) yn_vec[i].x, yn_vec[i].y), yn_vec[i].want, 4);
+
+  /* Exact results.  */
+  for (i = -1074; i <= 1023; i++)
+    {
+      x = ldexp (1.0, i);
+      check ("exp2", i, 0, exp2 (i), x, 0);
+#ifdef _INTEGER_MATH
+      /* Otherwise math.h makes log2 (x) log (x) / M_LN2, which is
+	 not exact.  */
+      check ("log2", x, 0, log2 (x), i, 0);
+#endif
+      check ("pow", 2, i, pow (2, i), x, 0);
+      if (i >= -537 && i <= 511)
+	check ("sqrt", x * x, 0, sqrt (x * x), x, 0);
+    }
+  check ("exp", 0, 0, exp (0), 1, 0);
+  check ("log", 1, 0, log (1), 0, 0);
+  check ("pow", -2, 3, pow (-2, 3), -8, 0);
+  check ("pow", -3, -2, pow (-3, -2), 1.0 / 9, 1);
+  check ("pow", 10, 15, pow (10, 15), 1e15, 0);
+  check ("sqrt", 2, 0, sqrt (2), 0x1.6a09e667f3bcdp+0, 0);
+
+  /* sqrt of a rounded square gives back the number when sqrt is
+     correctly rounded.  */
+  for (i = 0; i < 100000; i++)
+    {
+      v.u = rnd () & 0x7fffffffffffffffULL;
+      v.u = (v.u & 0x800fffffffffffffULL) | ((v.u >> 52) % 900 + 562) << 52;
+      check ("sqrt", v.d * v.d, 0, sqrt (v.d * v.d), v.d, 0);
+      check ("pow", v.d, 1, pow (v.d, 1), v.d, 0);
+      check ("pow", v.d, 2, pow (v.d, 2), v.d * v.d, 1);
+    }
+  for (i = 0; i < 100000; i++)
+    {
+      x = (double) (rnd () >> 11);
+      check ("sqrt", x * x, 0, sqrt (x * x), x, 0);
+    }
+
+  /* Special cases.  */
+  errno = 0;
+  check_errno ("log", 0, log (0), -HUGE_VAL, ERANGE);
+  check_errno ("log", -1, log (-1), NAN, EDOM);
+  check_errno ("log", INFINITY, log (INFINITY), INFINITY, 0);
+  check_errno ("log2", 0, log2 (0), -HUGE_VAL, ERANGE);
+  check_errno ("log2", -1, log2 (-1), NAN, EDOM);
+  check_errno ("exp", 1000, exp (1000), HUGE_VAL, ERANGE);
+  check_errno ("exp", -1000, exp (-1000), 0, ERANGE);
+  check_errno ("exp", -INFINITY, exp (-INFINITY), 0, 0);
+  check_errno ("exp2", 1024, exp2 (1024), HUGE_VAL, ERANGE);
+  check_errno ("sqrt", -1, sqrt (-1), NAN, EDOM);
+  check_errno ("sqrt", INFINITY, sqrt (INFINITY), INFINITY, 0);
+  check_errno ("pow", 10, pow (10, 400), HUGE_VAL, ERANGE);
+  check_errno ("pow", -1, pow (-1, 0.5), NAN, EDOM);
+  check_errno ("pow", 0, pow (0, 0), 1, 0);
+  check_errno ("pow", NAN, pow (NAN, 0), 1, 0);
+  check_errno ("pow", 1, pow (1, NAN), 1, 0);
+
+  exit (0);
+}
@@ -0,0 +1,73 @@
+/* Test bsearch and bsearch_batch against a linear scan.  */
+
+#include <stdlib.h>
+#include "check.h"
+
+#define N 1000
+#define K 300
+
+static int
+cmp_int (const void *a, const void *b)
+{
+  int x = *(const int *) a, y = *(const int *) b;
+
+  return x < y ? -1 : x > y;
+}
+
+static int
+linear_find (const int *array, int n, int key)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    if (array[i] == key)
+      return 1;
+  return 0;
+}
+
+int
+main (void)
+{
+  static int array[N], keys[K];
+  void *found[K];
+  int round, n, k, i, key;
+  size_t count, expected;
+  int *p;
+
+  srand (1);
+  for (round = 0; round < 50; round++)
+    {
+      n = round == 0 ? 0 : rand () % N;
+      k = rand () % K;
+      for (i = 0; i < n; i++)
+	array[i] = rand () % (2 * N);
+      qsort (array, n, sizeof array[0], cmp_int);
+
+      for (key = -1; key <= 2 * N; key++)
+	{
+	  p = bsearch (&key, array, n, sizeof array[0], cmp_int);
+	  CHECK ((p != NULL) == linear_find (array, n, key));
+	  CHECK (p == NULL || *p == key);
+	}
+
+      /* Unsorted keys on odd rounds, sorted ones on even rounds.  */
+      for (i = 0; i < k; i++)
+	keys[i] = round & 1 ? rand () % (2 * N + 2) - 1 : i * 2 * N / K;
+
+      count = bsearch_batch (keys, k, array, n, sizeof array[0], cmp_int,
+			     found);
+      expected = 0;
+      for (i = 0; i < k; i++)
+	{
+	  CHECK (i == 0 || keys[i - 1] <= keys[i]);
+	  CHECK ((found[i] != NULL) == linear_find (array, n, keys[i]));
+	  CHECK (found[i] == NULL || *(int *) found[i] == keys[i]);
+	  expected += found[i] != NULL;
+	}
+      CHECK (count == expected);
+      CHECK (bsearch_batch (keys, k, array, n, sizeof array[0], cmp_int, NULL)
+	     == expected);
+    }
+
+  exit (0);
+}
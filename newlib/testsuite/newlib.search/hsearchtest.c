@@ -47,6 +47,10 @@ __COPYRIGHT(
 #include <stdio.h>
 #include <string.h>
 
+#define	NKEYS	2000
+
+static ENTRY *entered[NKEYS];
+
 #define	TEST(e)	((e) ? (void)0 : testfail(__FILE__, __LINE__, #e))
 
 static void
@@ -62,8 +66,10 @@ int
 main(int argc, char *argv[])
 {
 	ENTRY e, *ep, *ep2;
+	struct hsearch_data htab;
 	int created_ok;
 	char ch[2];
+	char buf[16];
 	int i;
 
 	created_ok = hcreate(16);
@@ -121,5 +127,41 @@ main(int argc, char *argv[])
 
 	hdestroy();
 
+	/* Reentrant interface, entering far more keys than announced. */
+	memset(&htab, 0, sizeof htab);
+	TEST(hcreate_r(10, &htab));
+	TEST(!hcreate_r(10, &htab));
+	for (i = 0; i < NKEYS; i++) {
+		sprintf(buf, "key%d", i);
+		e.key = strdup(buf);
+		TEST(e.key != NULL);
+		e.data = (void *)(long)i;
+		TEST(hsearch_r(e, ENTER, &ep, &htab));
+		TEST(ep != NULL && (long)ep->data == i);
+		entered[i] = ep;
+	}
+	/* Entries do not move when the table grows. */
+	entered[0]->data = (void *)(long)-2;
+	e.key = buf;
+	sprintf(buf, "key%d", 0);
+	TEST(hsearch_r(e, FIND, &ep, &htab));
+	TEST(ep == entered[0] && (long)ep->data == -2);
+	entered[0]->data = (void *)0L;
+	for (i = 0; i < NKEYS; i++) {
+		sprintf(buf, "key%d", i);
+		TEST(hsearch_r(e, FIND, &ep, &htab));
+		TEST(ep == entered[i] && strcmp(ep->key, buf) == 0);
+		TEST((long)ep->data == i);
+		sprintf(buf, "yek%d", i);
+		TEST(!hsearch_r(e, FIND, &ep, &htab));
+		TEST(ep == NULL);
+	}
+	/* Entering an existing key returns the original entry. */
+	sprintf(buf, "key%d", 7);
+	e.data = (void *)(long)-1;
+	TEST(hsearch_r(e, ENTER, &ep, &htab));
+	TEST(ep != NULL && ep->key != buf && (long)ep->data == 7);
+	hdestroy_r(&htab);
+
 	exit(0);
 }
@@ -0,0 +1,159 @@
+/* Test qsort and qsort_r on several element sizes and input orders,
+   including an adversarial comparison function that drives plain
+   quicksort quadratic.  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#define N 2000
+
+struct elt12 { int key; int pad[2]; };
+struct elt32 { long long key; long long pad[3]; };
+
+static unsigned long ncmp;
+
+static int
+cmp_int (const void *a, const void *b)
+{
+  int x = *(const int *) a, y = *(const int *) b;
+
+  ncmp++;
+  return x < y ? -1 : x > y;
+}
+
+static int
+cmp_ll (const void *a, const void *b)
+{
+  long long x = *(const long long *) a, y = *(const long long *) b;
+
+  ncmp++;
+  return x < y ? -1 : x > y;
+}
+
+static int
+cmp_char (const void *a, const void *b)
+{
+  return *(const unsigned char *) a - *(const unsigned char *) b;
+}
+
+static int
+cmp_int_r (void *thunk, const void *a, const void *b)
+{
+  (*(int *) thunk)++;
+  return cmp_int (a, b);
+}
+
+/* Fill KEYS according to PATTERN.  */
+static void
+fill (int *keys, int n, int pattern)
+{
+  int i;
+
+  srand (n + pattern);
+  for (i = 0; i < n; i++)
+    switch (pattern)
+      {
+      case 0: keys[i] = rand (); break;
+      case 1: keys[i] = i; break;
+      case 2: keys[i] = n - i; break;
+      case 3: keys[i] = rand () % 4; break;
+      case 4: keys[i] = i < n / 2 ? i : n - i; break;
+      default: keys[i] = 7; break;
+      }
+}
+
+/* McIlroy's "A Killer Adversary for Quicksort": decide the order of
+   elements lazily so that every pivot turns out to be near the minimum.  */
+static int *val;
+static int gas, nsolid, candidate;
+
+static int
+cmp_adversary (const void *a, const void *b)
+{
+  int x = *(const int *) a, y = *(const int *) b;
+
+  ncmp++;
+  if (val[x] == gas && val[y] == gas)
+    {
+      if (x == candidate)
+	val[x] = nsolid++;
+      else
+	val[y] = nsolid++;
+    }
+  if (val[x] == gas)
+    candidate = x;
+  else if (val[y] == gas)
+    candidate = y;
+  return val[x] - val[y];
+}
+
+static void
+test_adversary (void)
+{
+  static int ptr[N], v[N];
+  int i;
+
+  val = v;
+  gas = N - 1;
+  nsolid = candidate = 0;
+  for (i = 0; i < N; i++)
+    {
+      ptr[i] = i;
+      val[i] = gas;
+    }
+  ncmp = 0;
+  qsort (ptr, N, sizeof ptr[0], cmp_adversary);
+  for (i = 1; i < N; i++)
+    CHECK (val[ptr[i - 1]] <= val[ptr[i]]);
+  /* A few times N log2 N; without the depth limit this adversary costs
+     about N * N / 10 comparisons.  */
+  CHECK (ncmp <= 8UL * N * 11);
+}
+
+int
+main (void)
+{
+  static int keys[N], ints[N];
+  static long long lls[N];
+  static struct elt12 e12[N];
+  static struct elt32 e32[N];
+  static char chars[N];
+  int pattern, n, i, calls;
+
+  for (pattern = 0; pattern < 6; pattern++)
+    for (n = 0; n <= N; n = n ? n * 3 + 1 : 1)
+      {
+	fill (keys, n, pattern);
+	for (i = 0; i < n; i++)
+	  {
+	    ints[i] = keys[i];
+	    lls[i] = keys[i];
+	    e12[i].key = keys[i];
+	    e32[i].key = keys[i];
+	    chars[i] = keys[i];
+	  }
+
+	qsort (ints, n, sizeof ints[0], cmp_int);
+	qsort (lls, n, sizeof lls[0], cmp_ll);
+	qsort (e12, n, sizeof e12[0], cmp_int);
+	qsort (e32, n, sizeof e32[0], cmp_ll);
+	qsort (chars, n, 1, cmp_char);
+	calls = 0;
+	qsort_r (keys, n, sizeof keys[0], &calls, cmp_int_r);
+
+	for (i = 1; i < n; i++)
+	  {
+	    CHECK (ints[i - 1] <= ints[i]);
+	    CHECK (lls[i - 1] <= lls[i]);
+	    CHECK (e12[i - 1].key <= e12[i].key);
+	    CHECK (e32[i - 1].key <= e32[i].key);
+	    CHECK ((unsigned char) chars[i - 1] <= (unsigned char) chars[i]);
+	    CHECK (keys[i - 1] <= keys[i]);
+	  }
+	CHECK (n <= 1 || calls != 0);
+      }
+
+  test_adversary ();
+  exit (0);
+}
@@ -0,0 +1,128 @@
+/* Test tsearch, tfind, tdelete, twalk and tdestroy and their pool
+   variants: keys inserted in order must still give a shallow tree,
+   an in-order walk must see exactly the keys left, and deletions in
+   random order must keep both true.  */
+
+#include <search.h>
+#include <stdlib.h>
+#include "check.h"
+#include "rnd.h"
+
+#define N 20000
+
+static int keys[N];
+static int order[N];
+static int present[N];
+static int depth, count, last;
+
+static int
+cmp (const void *a, const void *b)
+{
+  int x = *(const int *) a, y = *(const int *) b;
+
+  return (x > y) - (x < y);
+}
+
+static void
+visit (const void *node, VISIT v, int level)
+{
+  int key = **(int *const *) node;
+
+  if (level > depth)
+    depth = level;
+  if (v == postorder || v == leaf)
+    {
+      CHECK (key > last && present[key]);
+      last = key;
+      count++;
+    }
+}
+
+/* Walk the tree, check the order and the number of nodes, and check
+   that its height is within the AVL bound of 1.44 log2 (n + 2).  */
+static void
+check (void *root, int n)
+{
+  int bound = 0, m;
+
+  depth = count = 0;
+  last = -1;
+  twalk (root, visit);
+  CHECK (count == n);
+  for (m = n + 2; m > 1; m >>= 1)
+    bound++;
+  CHECK (n == 0 || depth + 1 <= bound * 3 / 2 + 1);
+}
+
+static void
+nothing (void *key)
+{
+}
+
+static void
+run (struct tpool *pool)
+{
+  void *root = NULL;
+  int i, j, t, n = 0;
+  void *p;
+
+  /* Sorted insertion, the worst case for an unbalanced tree.  */
+  for (i = 0; i < N; i++)
+    {
+      keys[i] = i;
+      p = pool ? tsearch_pool (&keys[i], &root, cmp, pool)
+	: tsearch (&keys[i], &root, cmp);
+      CHECK (p != NULL && *(int **) p == &keys[i]);
+      present[i] = 1;
+      n++;
+    }
+  check (root, n);
+
+  /* Inserting again finds the old node.  */
+  t = N / 2;
+  p = tsearch (&t, &root, cmp);
+  CHECK (p != NULL && *(int **) p == &keys[t]);
+
+  /* Delete two thirds in random order.  */
+  for (i = 0; i < N; i++)
+    order[i] = i;
+  for (i = N - 1; i > 0; i--)
+    {
+      j = rnd () % (i + 1);
+      t = order[i];
+      order[i] = order[j];
+      order[j] = t;
+    }
+  for (i = 0; i < 2 * N / 3; i++)
+    {
+      t = order[i];
+      p = pool ? tdelete_pool (&t, &root, cmp, pool)
+	: tdelete (&t, &root, cmp);
+      CHECK (p != NULL);
+      present[t] = 0;
+      n--;
+      CHECK (tfind (&t, &root, cmp) == NULL);
+      if (i % 1000 == 0)
+	check (root, n);
+    }
+  check (root, n);
+  for (i = 0; i < N; i++)
+    CHECK ((tfind (&i, &root, cmp) != NULL) == present[i]);
+  CHECK (tdelete (&order[0], &root, cmp) == NULL);
+
+  if (pool)
+    tdestroy_pool (root, nothing, pool);
+  else
+    tdestroy (root, nothing);
+}
+
+int
+main (void)
+{
+  struct tpool pool = { 0 };
+
+  run (NULL);
+  run (&pool);
+  tpool_destroy (&pool);
+  exit (0);
+}
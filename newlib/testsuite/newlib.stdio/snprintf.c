@@ -0,0 +1,115 @@
+/* snprintf and vsnprintf: the integer, pointer, string and fixed-point
+   conversions with their flags, widths and precisions, and truncation,
+   checked against the output C asks for.  */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include "check.h"
+
+static char buf[128];
+
+/* Format into buf and check the output and the length returned.  */
+static void
+expect (const char *want, const char *fmt, ...)
+{
+  va_list ap;
+  int n;
+
+  memset (buf, 'Z', sizeof (buf));
+  va_start (ap, fmt);
+  n = vsnprintf (buf, sizeof (buf), fmt, ap);
+  va_end (ap);
+  if (strcmp (buf, want) != 0 || n != (int) strlen (want))
+    printf ("\"%s\": got \"%s\" (%d), want \"%s\"\n", fmt, buf, n, want);
+  CHECK (strcmp (buf, want) == 0);
+  CHECK (n == (int) strlen (want));
+}
+
+int
+main (void)
+{
+  static const char unterminated[4] = { 'a', 'b', 'c', 'd' };
+  char small[8];
+
+  /* %d and the flags and lengths that go with it.  */
+  expect ("0", "%d", 0);
+  expect ("-42", "%d", -42);
+  expect ("-2147483648 2147483647", "%d %i", INT_MIN, INT_MAX);
+  expect ("   42|42   |", "%5d|%-5d|", 42, 42);
+  expect ("-0042 00042", "%05d %05d", -42, 42);
+  expect ("+42 -42  42", "%+d %+d % d", 42, -42, 42);
+  expect ("007|     007|     007", "%.3d|%8.3d|%08.3d", 7, 7, 7);
+  expect ("||0", "%.0d|%.d|%d", 0, 0, 0);
+  expect ("   42|1   |1   |", "%*d|%-*d|%*d|", 5, 42, 4, 1, -4, 1);
+  expect ("  007", "%*.*d", 5, 3, 7);
+  expect ("44 4464", "%hhd %hd", 300, 70000);
+  expect ("-9223372036854775808", "%lld", LLONG_MIN);
+  expect ("-123456789 -1", "%ld %jd", -123456789L, (intmax_t) -1);
+
+  /* %u, %x, %X and %o.  */
+  expect ("4294967295", "%u", UINT_MAX);
+  expect ("18446744073709551615", "%llu", ULLONG_MAX);
+  expect ("12345", "%zu", (size_t) 12345);
+  expect ("ff FF 0xff 0XFF 0", "%x %X %#x %#X %#x", 255, 255, 255, 255, 0);
+  expect ("0000beef|beef    |0x0000beef", "%08x|%-8x|%#010x",
+	  0xbeef, 0xbeef, 0xbeef);
+  expect ("123456789abcdef0", "%llx", 0x123456789abcdef0ULL);
+  expect ("00ab", "%.4x", 0xab);
+  expect ("10 010 0", "%o %#o %#o", 8, 8, 0);
+
+  /* %p, %s, %c and %%.  */
+  expect ("0x1234", "%p", (void *) 0x1234);
+  expect ("  0x1234|0x1234  |", "%8p|%-8p|", (void *) 0x1234,
+	  (void *) 0x1234);
+  expect ("abc|  abc|abc  |ab|    ab", "%s|%5s|%-5s|%.2s|%*.*s",
+	  "abc", "abc", "abc", "abc", 6, 2, "abc");
+  expect ("abcd", "%.*s", 4, unterminated);
+  expect ("|", "%s|", "");
+  expect ("x|  x|x  |", "%c|%3c|%-3c|", 'x', 'x', 'x');
+  expect ("100%", "%d%%", 100);
+
+  /* Fixed-point floating point.  */
+  expect ("1.500000", "%f", 1.5);
+  expect ("-0.000000", "%f", -0.0);
+  expect ("3.14|3|3.", "%.2f|%.0f|%#.0f", 3.14159, 3.14159, 3.14159);
+  expect ("  -1.500|-1.5    |", "%8.3f|%-8.1f|", -1.5, -1.5);
+  expect ("-0003.50 +2.50  2.50", "%08.2f %+.2f % .2f", -3.5, 2.5, 2.5);
+  expect ("    1.25", "%*.*f", 8, 2, 1.25);
+  expect ("0.000 0.1", "%.3f %.1f", 1e-4, 0.05);
+  expect ("100000000000000000000.000000", "%f", 1e20);
+  expect ("0.333333", "%f", 1.0 / 3);
+
+  /* Truncation: the output is cut and terminated, the return value is
+     the length the whole output would have had, and nothing past the
+     size given is touched.  */
+  memset (small, 'Z', sizeof (small));
+  CHECK (snprintf (small, 5, "%d", 1234567) == 7);
+  CHECK (strcmp (small, "1234") == 0 && small[5] == 'Z');
+  CHECK (snprintf (small, 4, "%-6s|", "ab") == 7);
+  CHECK (strcmp (small, "ab ") == 0);
+  CHECK (snprintf (small, 6, "%#x %s", 0xbeef, "tail") == 11);
+  CHECK (strcmp (small, "0xbee") == 0);
+  CHECK (snprintf (small, 4, "%.3f", 2.0) == 5);
+  CHECK (strcmp (small, "2.0") == 0);
+  memset (small, 'Z', sizeof (small));
+  CHECK (snprintf (small, 1, "%d", 42) == 2);
+  CHECK (small[0] == '\0' && small[1] == 'Z');
+  CHECK (snprintf (small, 0, "%s", "abcdef") == 6);
+  CHECK (small[0] == '\0' && small[1] == 'Z');
+  CHECK (snprintf (NULL, 0, "%*d", 20, 1) == 20);
+
+  /* A long double conversion, supported or not, takes its argument,
+     so that the ones after it still line up, however they are
+     passed.  */
+  CHECK (snprintf (buf, sizeof (buf), "%Lf|%d %d %d %d %d %d %d %d", 2.5L,
+		   1, 2, 3, 4, 5, 6, 7, 8) > 0);
+  CHECK (strcmp (strchr (buf, '|'), "|1 2 3 4 5 6 7 8") == 0);
+  CHECK (snprintf (buf, sizeof (buf), "%Le|%d %d %d %d %d %d %d %d", 2.5L,
+		   1, 2, 3, 4, 5, 6, 7, 8) > 0);
+  CHECK (strcmp (strchr (buf, '|'), "|1 2 3 4 5 6 7 8") == 0);
+
+  exit (0);
+}
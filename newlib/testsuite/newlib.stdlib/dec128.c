@@ -0,0 +1,91 @@
+/* Test the 128-bit decimal core, __dec_len128 and __dec_put128, against
+   a reference that builds the digits bit by bit with decimal doubling,
+   on 0, around every power of ten and of two, at the 64-bit boundary,
+   at the largest value and on random values of every length.  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "rnd.h"
+
+#ifdef __SIZEOF_INT128__
+
+typedef unsigned __int128 u128;
+
+extern int __dec_len128 (u128);
+extern char *__dec_put128 (u128, char *);
+
+/* Write the digits of V to OUT, most significant first.  */
+static void
+reference (u128 v, char *out)
+{
+  unsigned char dig[40];
+  int n = 1, i, bit, carry;
+
+  memset (dig, 0, sizeof (dig));
+  for (bit = 127; bit >= 0; bit--)
+    {
+      carry = (int) (v >> bit) & 1;
+      for (i = 0; i < n; i++)
+	{
+	  carry += dig[i] * 2;
+	  dig[i] = carry % 10;
+	  carry /= 10;
+	}
+      if (carry != 0)
+	dig[n++] = carry;
+    }
+  for (i = 0; i < n; i++)
+    out[i] = '0' + dig[n - 1 - i];
+  out[n] = '\0';
+}
+
+static void
+check (u128 v)
+{
+  char buf[48], want[41], *p, *end = buf + 44;
+
+  reference (v, want);
+  memset (buf, 'x', sizeof (buf));
+  p = __dec_put128 (v, end);
+  CHECK (end - p == (int) strlen (want));
+  CHECK (memcmp (p, want, end - p) == 0);
+  CHECK (p[-1] == 'x' && *end == 'x');
+  CHECK (__dec_len128 (v) == (int) strlen (want));
+}
+
+#endif /* __SIZEOF_INT128__ */
+
+int
+main (void)
+{
+#ifdef __SIZEOF_INT128__
+  u128 p, v;
+  int i;
+
+  check (0);
+  for (p = 1, i = 0; i <= 38; i++, p *= 10)
+    {
+      check (p - 1);
+      check (p);
+      check (p + 1);
+    }
+  for (i = 0; i < 128; i++)
+    {
+      p = (u128) 1 << i;
+      check (p - 1);
+      check (p);
+      check (p + 1);
+    }
+  check (~(u128) 0);
+  check (~(u128) 0 - 1);
+
+  for (i = 0; i < 100000; i++)
+    {
+      v = (u128) rnd () << 64 | rnd ();
+      check (v >> (rnd () % 128));
+    }
+#endif /* __SIZEOF_INT128__ */
+
+  exit (0);
+}
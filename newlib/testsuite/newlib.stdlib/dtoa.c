@@ -0,0 +1,104 @@
+/* Test the shortest output of _dtoa_r (mode 0): the digits read back
+   as the same double, no shorter string would, and they are the
+   correctly rounded digits of that length.  Random doubles cover the
+   whole exponent range, including subnormals and the values the
+   table-driven path leaves to the general code.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <reent.h>
+#include "check.h"
+#include "rnd.h"
+
+extern char *_dtoa_r (struct _reent *, double, int, int, int *, int *,
+		      char **);
+
+/* Read back DIGITS scaled so that the decimal point is after DECPT of
+   them.  */
+static double
+readback (const char *digits, int decpt)
+{
+  char buf[64];
+
+  sprintf (buf, ".%se%d", digits, decpt);
+  return strtod (buf, NULL);
+}
+
+static void
+check (double d)
+{
+  char digits[32], e[32], *p, *end;
+  int decpt, sign, n, i;
+
+  p = _dtoa_r (_REENT, d, 0, 0, &decpt, &sign, &end);
+  n = end - p;
+  CHECK (n >= 1 && n <= 17 && (n == 1 || p[n - 1] != '0') && sign == 0);
+  strcpy (digits, p);
+  CHECK (readback (digits, decpt) == d);
+
+  /* The same number of digits correctly rounded.  */
+  sprintf (e, "%.*e", n - 1, d);
+  for (i = 0, p = e; i < n; p++)
+    if (*p != '.')
+      CHECK (*p == digits[i++]);
+
+  /* One digit fewer does not read back.  */
+  if (n > 1)
+    {
+      sprintf (e, "%.*e", n - 2, d);
+      CHECK (strtod (e, NULL) != d);
+    }
+}
+
+static const struct
+{
+  double d;
+  const char *digits;
+  int decpt;
+} cases[] = {
+  { 1.0, "1", 1 },
+  { 0.1, "1", 0 },
+  { 0.3, "3", 0 },
+  { 2.5, "25", 1 },
+  { 123.456, "123456", 3 },
+  { 1e23, "1", 24 },
+  { 9007199254740993.0, "9007199254740992", 16 },
+  { 1.7976931348623157e308, "17976931348623157", 309 },
+  { 2.2250738585072014e-308, "22250738585072014", -307 },
+  { 4.9406564584124654e-324, "5", -323 },
+  { 5e-100, "5", -99 },
+  { 1e100, "1", 101 },
+};
+
+int
+main (void)
+{
+  union { double d; unsigned long long u; } v;
+  int decpt, sign, i;
+  char *p, *end;
+
+  for (i = 0; i < sizeof (cases) / sizeof (cases[0]); i++)
+    {
+      p = _dtoa_r (_REENT, cases[i].d, 0, 0, &decpt, &sign, &end);
+      CHECK (strcmp (p, cases[i].digits) == 0 && decpt == cases[i].decpt);
+    }
+
+  for (i = 0; i < 200000; i++)
+    {
+      v.u = rnd () & ~(1ULL << 63);
+      if ((v.u >> 52) == 0x7ff || v.u == 0)
+	continue;
+      check (v.d);
+    }
+
+  /* Short decimals, as prices and ratios tend to be.  */
+  for (i = 0; i < 100000; i++)
+    {
+      v.d = (double) (rnd () % 100000000) / 100;
+      if (v.d != 0)
+	check (v.d);
+    }
+
+  exit (0);
+}
@@ -0,0 +1,62 @@
+/* Test itoa, utoa, ltoa and ultoa against snprintf and a digit-by-digit
+   reference conversion in every base.  */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "rnd.h"
+
+static void
+reference (unsigned long value, int base, char *str)
+{
+  char tmp[sizeof (long) * CHAR_BIT + 1];
+  int i = 0, j = 0;
+
+  do
+    {
+      tmp[i++] = "0123456789abcdefghijklmnopqrstuvwxyz"[value % base];
+      value /= base;
+    }
+  while (value != 0);
+  while (i > 0)
+    str[j++] = tmp[--i];
+  str[j] = '\0';
+}
+
+int
+main (void)
+{
+  static const long edge[] = {
+    0, 1, 9, 10, 99, 100, 4294967295L, LONG_MAX, LONG_MIN, -1, -10
+  };
+  char got[sizeof (long) * CHAR_BIT + 2], want[sizeof got];
+  long value;
+  int i, base;
+
+  for (i = 0; i < 20000; i++)
+    {
+      if (i < (int) (sizeof edge / sizeof edge[0]))
+	value = edge[i];
+      else
+	value = (long) (rnd () >> (i % (sizeof (long) * CHAR_BIT)));
+
+      snprintf (want, sizeof want, "%ld", value);
+      CHECK (strcmp (ltoa (value, got, 10), want) == 0);
+      snprintf (want, sizeof want, "%d", (int) value);
+      CHECK (strcmp (itoa ((int) value, got, 10), want) == 0);
+
+      for (base = 2; base <= 36; base++)
+	{
+	  reference ((unsigned long) value, base, want);
+	  CHECK (strcmp (ultoa ((unsigned long) value, got, base), want) == 0);
+	  reference ((unsigned) value, base, want);
+	  CHECK (strcmp (utoa ((unsigned) value, got, base), want) == 0);
+	}
+    }
+
+  CHECK (utoa (1, got, 37) == NULL && got[0] == '\0');
+  CHECK (ltoa (1, got, 1) == NULL && got[0] == '\0');
+  exit (0);
+}
@@ -0,0 +1,122 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <reent.h>
+#include "check.h"
+
+#ifdef _MALLOC_STATS
+
+static struct mallstats s0, s;
+
+static size_t
+blocks (struct mallstats *m)
+{
+  return m->nmalloc - m->nfree;
+}
+
+static size_t count[8];
+
+/* Drain the trace, counting the events by type in count[] and leaving
+   the last one in *LAST.  Return the number of events.  */
+static size_t
+drain (struct malloc_event *last)
+{
+  struct malloc_event e[8];
+  size_t i, n, total = 0;
+
+  memset (count, 0, sizeof (count));
+  while ((n = malloc_trace_read (e, 8)) > 0)
+    for (i = 0; i < n; i++, total++)
+      {
+	count[e[i].type & 7]++;
+	*last = e[i];
+      }
+  return total;
+}
+
+#endif
+
+/* Counters, peak and the trace across malloc, realloc, memalign and
+   free.  Blocks resized in place are neither allocated nor freed.  */
+int main()
+{
+#ifdef _MALLOC_STATS
+  struct malloc_event e, ev[4];
+  char *a, *b, *c, *p;
+  size_t inuse, n, i;
+
+  malloc_trace (1);
+  drain (&e);
+  _mallstats_r (_REENT, &s0);
+
+  a = malloc (100);
+  b = malloc (200);
+  CHECK (a && b);
+  _mallstats_r (_REENT, &s);
+  CHECK (s.nmalloc == s0.nmalloc + 2 && s.nfree == s0.nfree);
+  CHECK (s.requested == s0.requested + 300);
+  CHECK (s.inuse >= s0.inuse + 300 && s.peak_inuse >= s.inuse);
+  inuse = s.inuse;
+
+  /* Shrinking in place gives the tail back without a free.  */
+  CHECK (realloc (a, 20) == a);
+  _mallstats_r (_REENT, &s);
+  CHECK (s.nrealloc == s0.nrealloc + 1);
+  CHECK (s.nmalloc == s0.nmalloc + 2 && s.nfree == s0.nfree);
+  CHECK (s.inuse <= inuse);
+
+  a = realloc (a, 4000);
+  CHECK (a != NULL);
+  c = memalign (64, 100);
+  CHECK (c != NULL && (uintptr_t) c % 64 == 0);
+  _mallstats_r (_REENT, &s);
+  CHECK (blocks (&s) == blocks (&s0) + 3);
+  CHECK (s.peak_inuse >= s.inuse && s.inuse >= s0.inuse + 4300);
+  inuse = s.peak_inuse;
+
+  CHECK (malloc (SIZE_MAX / 2) == NULL);
+
+  free (a);
+  free (b);
+  free (c);
+  _mallstats_r (_REENT, &s);
+  CHECK (blocks (&s) == blocks (&s0));
+  CHECK (s.inuse == s0.inuse && s.peak_inuse == inuse);
+  CHECK (s.nfail == s0.nfail + 1);
+
+  /* The trace shows the same.  */
+  drain (&e);
+  CHECK (count[MALLOC_EVENT_ALLOC] == count[MALLOC_EVENT_FREE]);
+  CHECK (count[MALLOC_EVENT_REALLOC] == 2 && count[MALLOC_EVENT_FAIL] == 1);
+  CHECK (e.type == MALLOC_EVENT_FREE && e.ptr == c);
+
+  a = malloc (10);
+  free (a);
+  n = malloc_trace_read (ev, 4);
+  CHECK (n == 2);
+  CHECK (ev[0].type == MALLOC_EVENT_ALLOC && ev[0].ptr == a);
+  CHECK (ev[1].type == MALLOC_EVENT_FREE && ev[1].ptr == a);
+  CHECK (ev[0].size == ev[1].size && ev[0].size >= 10);
+
+  /* Once the ring is full the oldest events are lost.  */
+  _mallstats_r (_REENT, &s0);
+  for (i = 0; i < 100; i++)
+    {
+      p = malloc (i + 1);
+      free (p);
+    }
+  n = drain (&e);
+  _mallstats_r (_REENT, &s);
+  CHECK (n > 0 && n <= 200 && s.trace_lost - s0.trace_lost == 200 - n);
+  CHECK (e.type == MALLOC_EVENT_FREE && e.ptr == p);
+  CHECK (malloc_trace_read (ev, 4) == 0);
+
+  CHECK (malloc_trace (0) == 1);
+  a = malloc (10);
+  free (a);
+  CHECK (malloc_trace_read (ev, 4) == 0);
+#endif
+
+  exit (0);
+}
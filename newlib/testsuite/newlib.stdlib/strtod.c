@@ -0,0 +1,107 @@
+/* Test that strtod rounds correctly on both sides of its fast path:
+   17-digit round trips of random doubles, exact decimal expansions of
+   the midpoints between neighbouring doubles, which have to round to
+   even, and the same midpoints nudged a hair up or down.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "rnd.h"
+
+#define MAXDIG 1200
+
+static double
+make (unsigned long long mant, int exp2)
+{
+  union { double d; unsigned long long u; } v;
+
+  v.u = ((unsigned long long) (exp2 + 1075) << 52) | (mant & ((1ULL << 52) - 1));
+  return v.d;
+}
+
+/* Write the digits of M * 2^K, for odd M, exactly into OUT and return
+   the power of ten they are to be scaled by.  */
+static int
+exact (unsigned long long m, int k, char *out)
+{
+  static unsigned char dig[MAXDIG];
+  int n = 0, i, carry, mul = k > 0 ? 2 : 5, times = k > 0 ? k : -k;
+
+  /* Least significant digit first.  */
+  while (m != 0)
+    {
+      dig[n++] = m % 10;
+      m /= 10;
+    }
+  while (times-- > 0)
+    {
+      for (carry = i = 0; i < n; i++)
+	{
+	  carry += dig[i] * mul;
+	  dig[i] = carry % 10;
+	  carry /= 10;
+	}
+      if (carry != 0)
+	dig[n++] = carry;
+    }
+  for (i = 0; i < n; i++)
+    out[i] = '0' + dig[n - 1 - i];
+  out[n] = '\0';
+  return k > 0 ? 0 : k;
+}
+
+/* Subtract one from the last digit of DIGITS.  */
+static void
+decrement (char *digits)
+{
+  char *p = digits + strlen (digits) - 1;
+
+  while (*p == '0')
+    *p-- = '9';
+  --*p;
+}
+
+int
+main (void)
+{
+  static char digits[MAXDIG], buf[MAXDIG + 32];
+  unsigned long long mant;
+  double d, next, want;
+  int i, exp2, exp10;
+
+  for (i = 0; i < 200000; i++)
+    {
+      mant = (1ULL << 52) | (rnd () & ((1ULL << 52) - 1));
+      exp2 = (int) (rnd () % 2046) - 1074;
+      d = make (mant, exp2);
+      sprintf (buf, "%.16e", d);
+      CHECK (strtod (buf, NULL) == d);
+    }
+
+  for (i = 0; i < 20000; i++)
+    {
+      mant = (1ULL << 52) | (rnd () & ((1ULL << 52) - 1));
+      exp2 = (int) (rnd () % 800) - 400;
+      d = make (mant, exp2);
+      if (mant + 1 == 1ULL << 53)
+	next = make (1ULL << 52, exp2 + 1);
+      else
+	next = make (mant + 1, exp2);
+
+      /* Half way between D and NEXT is (2 * MANT + 1) * 2^(EXP2 - 1).  */
+      exp10 = exact (2 * mant + 1, exp2 - 1, digits);
+      sprintf (buf, "%se%d", digits, exp10);
+      want = mant & 1 ? next : d;
+      CHECK (strtod (buf, NULL) == want);
+
+      /* A little more rounds up, a little less rounds down.  */
+      sprintf (buf, "%s0000001e%d", digits, exp10 - 7);
+      CHECK (strtod (buf, NULL) == next);
+      decrement (digits);
+      sprintf (buf, "%s9999999e%d", digits, exp10 - 7);
+      CHECK (strtod (buf, NULL) == d);
+    }
+
+  exit (0);
+}
@@ -0,0 +1,81 @@
+/* Test the strtoll and strtoull results, end pointers and errno on
+   inputs around the decimal and hexadecimal fast path limits.  UVAL is
+   the magnitude strtoull returns, before it negates a leading '-'.  */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct test
+{
+  const char *str;
+  int base;
+  long long sval;
+  unsigned long long uval;
+  int len;
+  int serr, uerr;
+};
+
+static const struct test tests[] = {
+  { "0", 10, 0, 0, 1, 0, 0 },
+  { "-12x", 10, -12, 12, 3, 0, 0 },
+  { "+7", 0, 7, 7, 2, 0, 0 },
+  { "  42", 10, 42, 42, 4, 0, 0 },
+  { "017", 0, 15, 15, 3, 0, 0 },
+  { "0x1fG", 0, 31, 31, 4, 0, 0 },
+  { "0x1f", 16, 31, 31, 4, 0, 0 },
+  { "1fG", 16, 31, 31, 2, 0, 0 },
+  { "", 10, 0, 0, 0, 0, 0 },
+  { "-", 10, 0, 0, 0, 0, 0 },
+  { "9223372036854775807", 10, LLONG_MAX, 9223372036854775807ULL, 19, 0, 0 },
+  { "9223372036854775808", 10, LLONG_MAX, 9223372036854775808ULL, 19,
+    ERANGE, 0 },
+  { "-9223372036854775808", 10, LLONG_MIN, 9223372036854775808ULL, 20,
+    0, 0 },
+  { "-9223372036854775809", 10, LLONG_MIN, 9223372036854775809ULL, 20,
+    ERANGE, 0 },
+  { "18446744073709551615", 10, LLONG_MAX, ULLONG_MAX, 20, ERANGE, 0 },
+  { "18446744073709551616", 10, LLONG_MAX, ULLONG_MAX, 20, ERANGE, ERANGE },
+  { "00000000000000000000042", 10, 42, 42, 23, 0, 0 },
+  { "7fffffffffffffff", 16, LLONG_MAX, 0x7fffffffffffffffULL, 16, 0, 0 },
+  { "-8000000000000000", 16, LLONG_MIN, 0x8000000000000000ULL, 17, 0, 0 },
+  { "FFFFFFFFFFFFFFFF", 16, LLONG_MAX, ULLONG_MAX, 16, ERANGE, 0 },
+  { "10000000000000000", 16, LLONG_MAX, ULLONG_MAX, 17, ERANGE, ERANGE },
+  { "zz", 36, 1295, 1295, 2, 0, 0 },
+};
+
+int
+main (void)
+{
+  const struct test *t;
+  long long sval;
+  unsigned long long uval;
+  char *end;
+  int failed = 0;
+
+  for (t = tests; t < tests + sizeof tests / sizeof tests[0]; t++)
+    {
+      errno = 0;
+      sval = strtoll (t->str, &end, t->base);
+      if (sval != t->sval || end != t->str + t->len || errno != t->serr)
+	{
+	  printf ("strtoll (\"%s\", %d) = %lld, %d chars, errno %d\n",
+		  t->str, t->base, sval, (int) (end - t->str), errno);
+	  failed = 1;
+	}
+
+      errno = 0;
+      uval = strtoull (t->str, &end, t->base);
+      if (t->str[0] == '-')
+	uval = -uval;
+      if (uval != t->uval || end != t->str + t->len || errno != t->uerr)
+	{
+	  printf ("strtoull (\"%s\", %d) = %llu, %d chars, errno %d\n",
+		  t->str, t->base, uval, (int) (end - t->str), errno);
+	  failed = 1;
+	}
+    }
+
+  exit (failed);
+}
@@ -0,0 +1,95 @@
+/* strnlen, strrchr, rawmemchr and stpcpy scan a word at a time on some
+   targets.  Sweep the start of the string over the bytes of a word and
+   the length over several words, so that the terminator, the limit and
+   the match fall on every byte of a word, the last one included.  */
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdint.h>
+#include "check.h"
+
+#define WORD 8
+#define MAXLEN (5 * WORD)
+
+static union
+{
+  uint64_t align;
+  char buf[MAXLEN + 3 * WORD];
+} u, v;
+
+/* Put a string of LEN bytes at offset ALIGN of u.buf, with 'X' in every
+   other byte, and return it.  The 'X' after the terminator must never
+   be found.  */
+static char *
+make (int align, int len)
+{
+  char *s = u.buf + align;
+  int i;
+
+  for (i = 0; i < (int) sizeof (u.buf); i++)
+    u.buf[i] = 'X';
+  for (i = 0; i < len; i++)
+    s[i] = 'a' + i % 23;
+  s[len] = '\0';
+  return s;
+}
+
+int
+main (void)
+{
+  int align, dalign, len, pos;
+  size_t n;
+  char *s, *d;
+
+  for (align = 0; align < WORD; align++)
+    for (len = 0; len <= MAXLEN; len++)
+      {
+	s = make (align, len);
+
+	/* Every limit below, at and past the terminator, including those
+	   that end inside a word.  */
+	for (n = 0; n <= (size_t) len + WORD + 1; n++)
+	  CHECK (strnlen (s, n) == (n < (size_t) len ? n : (size_t) len));
+	CHECK (strnlen (s, SIZE_MAX) == (size_t) len);
+
+	CHECK (strrchr (s, 'X') == NULL);
+	CHECK (strrchr (s, '\0') == s + len);
+	CHECK (rawmemchr (s, '\0') == s + len);
+
+	/* The last match wins, wherever the earlier one is.  */
+	for (pos = 0; pos < len; pos++)
+	  {
+	    s[pos] = 'X';
+	    CHECK (rawmemchr (s, 'X') == s + pos);
+	    CHECK (strrchr (s, 'X') == s + pos);
+	    if (pos > 0)
+	      {
+		s[pos / 2] = 'X';
+		CHECK (strrchr (s, 'X') == s + pos);
+		CHECK (rawmemchr (s, 'X') == s + pos / 2);
+		s[pos / 2] = 'a' + pos / 2 % 23;
+	      }
+	    s[pos] = 'a' + pos % 23;
+	  }
+
+	for (dalign = 0; dalign < WORD; dalign++)
+	  {
+	    memset (v.buf, '#', sizeof (v.buf));
+	    d = v.buf + dalign;
+	    CHECK (stpcpy (d, s) == d + len);
+	    CHECK (memcmp (d, s, len + 1) == 0);
+	    CHECK (d[len + 1] == '#');
+	    CHECK (dalign == 0 || d[-1] == '#');
+	  }
+      }
+
+  /* The cases above that matter most, spelled out: a limit ending in
+     the middle of a word, and a match in the last byte of one.  */
+  s = make (0, 3 * WORD);
+  CHECK (strnlen (s + 1, WORD + 2) == WORD + 2);
+  s[2 * WORD - 1] = 'X';
+  CHECK (strrchr (s, 'X') == s + 2 * WORD - 1);
+  CHECK (rawmemchr (s + 1, 'X') == s + 2 * WORD - 1);
+
+  exit (0);
+}
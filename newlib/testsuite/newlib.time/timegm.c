@@ -0,0 +1,107 @@
+/* Test timegm: it inverts gmtime_r across a wide range of years,
+   normalizes out of range fields the way mktime does, and agrees with
+   mktime when the time zone is UTC.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "check.h"
+#include "rnd.h"
+
+static int
+same (const struct tm *a, const struct tm *b)
+{
+  return a->tm_sec == b->tm_sec && a->tm_min == b->tm_min
+    && a->tm_hour == b->tm_hour && a->tm_mday == b->tm_mday
+    && a->tm_mon == b->tm_mon && a->tm_year == b->tm_year
+    && a->tm_wday == b->tm_wday && a->tm_yday == b->tm_yday;
+}
+
+int
+main (void)
+{
+  struct tm tm, ref;
+  time_t t;
+  int i, n;
+
+  /* Roughly years 1700 to 2300.  */
+  for (i = 0; i < 100000; i++)
+    {
+      t = (time_t) (rnd () % 19000000000ULL) - 8500000000LL;
+      gmtime_r (&t, &ref);
+      tm = ref;
+      tm.tm_wday = tm.tm_yday = -1;
+      tm.tm_isdst = 1;
+      CHECK (timegm (&tm) == t && same (&tm, &ref) && tm.tm_isdst == 0);
+    }
+
+  /* Fields out of range, including days far outside the month.  */
+  for (i = 0; i < 100000; i++)
+    {
+      t = (time_t) (rnd () % 4000000000ULL);
+      gmtime_r (&t, &ref);
+      memset (&tm, 0, sizeof (tm));
+      tm.tm_year = 70;
+      tm.tm_mday = 1 + t / 86400;
+      tm.tm_sec = t % 86400;
+      /* Move some of it between the fields.  */
+      n = (int) (rnd () % 2000) - 1000;
+      tm.tm_mday -= n;
+      tm.tm_hour += 24 * n;
+      n = (int) (rnd () % 2000) - 1000;
+      tm.tm_hour -= n;
+      tm.tm_min += 60 * n;
+      n = (int) (rnd () % 2000) - 1000;
+      tm.tm_min -= n;
+      tm.tm_sec += 60 * n;
+      n = (int) (rnd () % 200) - 100;
+      tm.tm_year -= n;
+      tm.tm_mon += 12 * n;
+      CHECK (timegm (&tm) == t && same (&tm, &ref));
+    }
+
+  /* Without a TZ, mktime is timegm.  */
+  unsetenv ("TZ");
+  tzset ();
+  for (i = 0; i < 10000; i++)
+    {
+      memset (&tm, 0, sizeof (tm));
+      tm.tm_year = (int) (rnd () % 1000) - 200;
+      tm.tm_mon = (int) (rnd () % 40) - 20;
+      tm.tm_mday = (int) (rnd () % 1000) - 500;
+      tm.tm_sec = (int) (rnd () % 1000000);
+      ref = tm;
+      t = timegm (&ref);
+      CHECK (mktime (&tm) == t && same (&tm, &ref));
+    }
+
+  /* Years up to 10000 from 1900 either way, after normalization, and
+     no further.  */
+  memset (&tm, 0, sizeof (tm));
+  tm.tm_mday = 1;
+  tm.tm_year = 10000;
+  CHECK (timegm (&tm) == 313360531200LL && tm.tm_year == 10000);
+  tm.tm_year = -10000;
+  CHECK (timegm (&tm) == -317778508800LL && tm.tm_year == -10000);
+  tm.tm_year = 10001;
+  CHECK (timegm (&tm) == (time_t) -1);
+  CHECK (mktime (&tm) == (time_t) -1);
+  tm.tm_year = -10001;
+  CHECK (timegm (&tm) == (time_t) -1);
+  tm.tm_year = 10001;
+  tm.tm_mon = -1;
+  CHECK (timegm (&tm) == 313389388800LL);
+  tm.tm_year = 10000;
+  tm.tm_mon = 11;
+  tm.tm_mday = 32;
+  CHECK (timegm (&tm) == (time_t) -1);
+  memset (&tm, 0, sizeof (tm));
+  tm.tm_year = 2000000000;
+  tm.tm_mday = 1;
+  CHECK (timegm (&tm) == (time_t) -1);
+  tm.tm_year = -2000000000;
+  CHECK (mktime (&tm) == (time_t) -1);
+
+  exit (0);
+}
@@ -0,0 +1,41 @@
+#define _GNU_SOURCE
+#include <wctype.h>
+#include <wchar.h>
+#include <locale.h>
+#include <newlib.h>
+#include "check.h"
+
+/* Categories, case conversion and widths of characters outside
+   ASCII, from the first and last blocks of the tables and beyond
+   them.  */
+int main()
+{
+#ifdef _MB_CAPABLE
+  CHECK (setlocale (LC_CTYPE, "C.UTF-8") != 0);
+
+  CHECK (iswalpha (0x3b1) && iswlower (0x3b1) && !iswupper (0x3b1));
+  CHECK (iswalpha (0x4e00) && !iswlower (0x4e00));
+  CHECK (iswalpha (0x2b740) && iswalpha (0x30000));
+  CHECK (iswspace (0x3000) && iswspace (0x2028) && !iswspace (0x4e00));
+  CHECK (iswalnum (0x660) && iswalpha (0x16ee));
+  CHECK (!iswalpha (0x110000) && !iswprint (0x110000));
+
+  CHECK (towupper (0x3b1) == 0x391 && towlower (0x391) == 0x3b1);
+  CHECK (towupper (0x101) == 0x100 && towlower (0x100) == 0x101);
+  CHECK (towupper (0x1c5) == 0x1c4 && towlower (0x1c5) == 0x1c6);
+  CHECK (towupper (0xff) == 0x178 && towupper (0xdf) == 0xdf);
+  CHECK (towupper (0x10428) == 0x10400 && towlower (0x10400) == 0x10428);
+  CHECK (towupper (0x1e922) == 0x1e900 && towlower (0x1e900) == 0x1e922);
+  CHECK (towupper (0x4e00) == 0x4e00 && towlower (0x10ffff) == 0x10ffff);
+  CHECK (towupper (0x110000) == 0x110000);
+
+  CHECK (wcwidth (0x41) == 1 && wcwidth (0xa1) == 1);
+  CHECK (wcwidth (0x300) == 0 && wcwidth (0x1160) == 0);
+  CHECK (wcwidth (0xe0001) == 0);
+  CHECK (wcwidth (0x4e00) == 2 && wcwidth (0xac00) == 2);
+  CHECK (wcwidth (0x3000) == 2 && wcwidth (0x1f600) == 2);
+  CHECK (wcwidth (0x20000) == 2 && wcwidth (0x10fffd) == 1);
+#endif
+
+  exit (0);
+}
@@ -0,0 +1,251 @@
+/* xdr_array, xdr_vector and the xdr_*_array functions convert whole
+   runs of integers and IEEE numbers in the stream's buffer.  Check that
+   they write the same bytes as the element filter called once per
+   element and read them back the same, on aligned and unaligned memory
+   streams, on buffers too short for the array, and on record streams
+   whose fragments split the runs.  */
+
+#include <string.h>
+#include <stdint.h>
+#include <rpc/types.h>
+#include <rpc/xdr.h>
+#include "check.h"
+
+/* 6000 or 12000 bytes: more than one run of XDR_ARRAY_CHUNK.  */
+#define NELEM 1500
+#define NBYTES (NELEM * 8)
+
+struct filter
+{
+  xdrproc_t proc;
+  u_int size;
+};
+
+static const struct filter filters[] = {
+  { (xdrproc_t) xdr_int32_t, sizeof (int32_t) },
+  { (xdrproc_t) xdr_uint32_t, sizeof (uint32_t) },
+  { (xdrproc_t) xdr_u_int32_t, sizeof (u_int32_t) },
+  { (xdrproc_t) xdr_int, sizeof (int) },
+  { (xdrproc_t) xdr_u_int, sizeof (u_int) },
+  { (xdrproc_t) xdr_float, sizeof (float) },
+#if defined(___int64_t_defined)
+  { (xdrproc_t) xdr_int64_t, sizeof (int64_t) },
+  { (xdrproc_t) xdr_uint64_t, sizeof (uint64_t) },
+  { (xdrproc_t) xdr_u_int64_t, sizeof (u_int64_t) },
+  { (xdrproc_t) xdr_hyper, sizeof (quad_t) },
+  { (xdrproc_t) xdr_u_hyper, sizeof (u_quad_t) },
+  { (xdrproc_t) xdr_longlong_t, sizeof (quad_t) },
+  { (xdrproc_t) xdr_u_longlong_t, sizeof (u_quad_t) },
+#endif
+#if !defined(_DOUBLE_IS_32BITS)
+  { (xdrproc_t) xdr_double, sizeof (double) },
+#endif
+};
+
+/* Kept aligned for every element type; the streams start 0 or 1 byte
+   into them.  */
+static double src[NELEM], dst[NELEM], ref_dst[NELEM];
+static double ref[NBYTES / 8 + 2], out[NBYTES / 8 + 2];
+
+/* The two ends of a record stream, kept in memory.  */
+static struct rec
+{
+  char buf[NBYTES * 2];
+  size_t len, pos;
+} recs[2];
+
+static int
+rec_write (void *handle, void *buf, int len)
+{
+  struct rec *rec = handle;
+
+  memcpy (rec->buf + rec->len, buf, len);
+  rec->len += len;
+  return len;
+}
+
+static int
+rec_read (void *handle, void *buf, int len)
+{
+  struct rec *rec = handle;
+
+  if ((size_t) len > rec->len - rec->pos)
+    len = rec->len - rec->pos;
+  if (len == 0)
+    return -1;
+  memcpy (buf, rec->buf + rec->pos, len);
+  rec->pos += len;
+  return len;
+}
+
+/* XDR the first N elements of ADDR one at a time, as the code did
+   before runs.  Return whether all went through.  */
+static bool_t
+per_element (XDR *xdrs, const struct filter *f, char *addr, u_int n)
+{
+  u_int i;
+
+  for (i = 0; i < n; i++)
+    if (!f->proc (xdrs, addr + i * f->size))
+      return FALSE;
+  return TRUE;
+}
+
+/* Encode and decode N elements through memory streams of SIZE bytes,
+   OFF bytes into the buffers, with xdr_vector and element by element,
+   and compare everything that can be seen.  */
+static void
+check_mem (const struct filter *f, u_int n, u_int size, int off)
+{
+  XDR x, r;
+  bool_t ok, ref_ok;
+
+  memset (ref, 0x5a, sizeof (ref));
+  memset (out, 0x5a, sizeof (out));
+  xdrmem_create (&r, (char *) ref + off, size, XDR_ENCODE);
+  xdrmem_create (&x, (char *) out + off, size, XDR_ENCODE);
+  ref_ok = per_element (&r, f, (char *) src, n);
+  ok = xdr_vector (&x, (char *) src, n, f->size, f->proc);
+  CHECK (ok == ref_ok);
+  CHECK (ok == (size >= n * f->size));
+  CHECK (XDR_GETPOS (&x) == XDR_GETPOS (&r));
+  CHECK (memcmp (ref, out, sizeof (ref)) == 0);
+
+  /* Read back what a full encoding gives, through a stream cut at
+     SIZE.  */
+  if (!ok)
+    {
+      xdrmem_create (&r, (char *) ref + off, n * f->size, XDR_ENCODE);
+      CHECK (per_element (&r, f, (char *) src, n));
+    }
+  memset (dst, 0xa5, sizeof (dst));
+  memset (ref_dst, 0xa5, sizeof (ref_dst));
+  xdrmem_create (&r, (char *) ref + off, size, XDR_DECODE);
+  xdrmem_create (&x, (char *) ref + off, size, XDR_DECODE);
+  ref_ok = per_element (&r, f, (char *) ref_dst, n);
+  CHECK (xdr_vector (&x, (char *) dst, n, f->size, f->proc) == ref_ok);
+  CHECK (XDR_GETPOS (&x) == XDR_GETPOS (&r));
+  CHECK (memcmp (dst, ref_dst, sizeof (dst)) == 0);
+  if (ref_ok)
+    CHECK (memcmp (dst, src, n * f->size) == 0);
+}
+
+/* The same through record streams with SENDSIZE byte fragments.  */
+static void
+check_rec (const struct filter *f, u_int sendsize)
+{
+  XDR x, r;
+
+  memset (recs, 0, sizeof (recs));
+  xdrrec_create (&r, sendsize, sendsize, &recs[0], rec_read, rec_write);
+  xdrrec_create (&x, sendsize, sendsize, &recs[1], rec_read, rec_write);
+  r.x_op = x.x_op = XDR_ENCODE;
+  CHECK (per_element (&r, f, (char *) src, NELEM));
+  CHECK (xdr_vector (&x, (char *) src, NELEM, f->size, f->proc));
+  CHECK (xdrrec_endofrecord (&r, TRUE) && xdrrec_endofrecord (&x, TRUE));
+  CHECK (recs[0].len == recs[1].len);
+  CHECK (memcmp (recs[0].buf, recs[1].buf, recs[0].len) == 0);
+
+  memset (dst, 0xa5, sizeof (dst));
+  x.x_op = XDR_DECODE;
+  CHECK (xdrrec_skiprecord (&x));
+  CHECK (xdr_vector (&x, (char *) dst, NELEM, f->size, f->proc));
+  CHECK (memcmp (dst, src, NELEM * f->size) == 0);
+  XDR_DESTROY (&r);
+  XDR_DESTROY (&x);
+}
+
+int
+main (void)
+{
+  static const u_int sendsizes[] = { 100, 1000, 4004 };
+  const struct filter *f;
+  unsigned char *p;
+  uint32_t seed = 1;
+  u_int i, j, n, len;
+  char *arr;
+  XDR x;
+
+  for (p = (unsigned char *) src; p < (unsigned char *) (src + NELEM); p++)
+    {
+      seed = seed * 1103515245 + 12345;
+      *p = seed >> 16;
+    }
+
+  for (f = filters; f < filters + sizeof (filters) / sizeof (filters[0]); f++)
+    {
+      len = NELEM * f->size;
+      for (i = 0; i < 2; i++)
+	{
+	  check_mem (f, NELEM, len, i);
+	  check_mem (f, 1, f->size, i);
+	  check_mem (f, 0, 0, i);
+	  /* Short buffers: nothing, part of the first element, and cut
+	     in the last run and in the middle of an element.  */
+	  check_mem (f, NELEM, 0, i);
+	  check_mem (f, NELEM, 4, i);
+	  check_mem (f, NELEM, len - 4, i);
+	  check_mem (f, NELEM, len / 2 + 4, i);
+	  check_mem (f, NELEM, 4096 + 4, i);
+	}
+      for (j = 0; j < sizeof (sendsizes) / sizeof (sendsizes[0]); j++)
+	check_rec (f, sendsizes[j]);
+
+      /* xdr_array: the count, then the same bytes; decoding allocates
+	 and XDR_FREE gives it back.  */
+      xdrmem_create (&x, (char *) out, sizeof (out), XDR_ENCODE);
+      arr = (char *) src;
+      n = NELEM;
+      CHECK (xdr_array (&x, &arr, &n, NELEM, f->size, f->proc));
+      CHECK (XDR_GETPOS (&x) == 4 + len);
+      xdrmem_create (&x, (char *) ref, sizeof (ref), XDR_ENCODE);
+      CHECK (per_element (&x, f, (char *) src, NELEM));
+      CHECK (memcmp ((char *) out + 4, ref, len) == 0);
+      xdrmem_create (&x, (char *) out, sizeof (out), XDR_DECODE);
+      arr = NULL;
+      CHECK (xdr_array (&x, &arr, &n, NELEM, f->size, f->proc));
+      CHECK (n == NELEM && arr != NULL && memcmp (arr, src, len) == 0);
+      x.x_op = XDR_FREE;
+      CHECK (xdr_array (&x, &arr, &n, NELEM, f->size, f->proc));
+      CHECK (arr == NULL);
+      xdrmem_create (&x, (char *) out, 4 + len - 1, XDR_DECODE);
+      CHECK (!xdr_array (&x, &arr, &n, NELEM, f->size, f->proc));
+      x.x_op = XDR_FREE;
+      CHECK (xdr_array (&x, &arr, &n, NELEM, f->size, f->proc));
+      xdrmem_create (&x, (char *) out, 4 + len, XDR_DECODE);
+      CHECK (!xdr_array (&x, &arr, &n, NELEM - 1, f->size, f->proc));
+    }
+
+  /* The fixed length array functions match xdr_vector.  */
+  xdrmem_create (&x, (char *) out, sizeof (out), XDR_ENCODE);
+  CHECK (xdr_int32_array (&x, (int32_t *) src, NELEM));
+  CHECK (xdr_uint32_array (&x, (uint32_t *) src, NELEM));
+  CHECK (xdr_float_array (&x, (float *) src, 2));
+  xdrmem_create (&x, (char *) ref, sizeof (ref), XDR_ENCODE);
+  CHECK (per_element (&x, &filters[0], (char *) src, NELEM));
+  CHECK (per_element (&x, &filters[1], (char *) src, NELEM));
+  CHECK (per_element (&x, &filters[5], (char *) src, 2));
+  CHECK (memcmp (out, ref, NELEM * 8 + 8) == 0);
+#if defined(___int64_t_defined)
+  xdrmem_create (&x, (char *) out, sizeof (out), XDR_ENCODE);
+  CHECK (xdr_int64_array (&x, (int64_t *) src, NELEM / 2));
+  CHECK (xdr_uint64_array (&x, (uint64_t *) src, NELEM / 2));
+  xdrmem_create (&x, (char *) ref, sizeof (ref), XDR_ENCODE);
+  CHECK (per_element (&x, &filters[6], (char *) src, NELEM / 2));
+  CHECK (per_element (&x, &filters[7], (char *) src, NELEM / 2));
+  CHECK (memcmp (out, ref, NELEM * 8) == 0);
+#endif
+#if !defined(_DOUBLE_IS_32BITS)
+  xdrmem_create (&x, (char *) out, sizeof (out), XDR_ENCODE);
+  CHECK (xdr_double_array (&x, src, NELEM));
+  xdrmem_create (&x, (char *) ref, sizeof (ref), XDR_ENCODE);
+  CHECK (per_element (&x, &filters[sizeof (filters) / sizeof (filters[0]) - 1],
+		      (char *) src, NELEM));
+  CHECK (memcmp (out, ref, NELEM * 8) == 0);
+  xdrmem_create (&x, (char *) out, sizeof (out), XDR_DECODE);
+  CHECK (xdr_double_array (&x, dst, NELEM));
+  CHECK (memcmp (dst, src, sizeof (src)) == 0);
+#endif
+
+  exit (0);
+}
@@ -0,0 +1,151 @@
+/* The iovec stream reads and writes the same bytes as a memory stream
+   across segments of any length, lends out runs that are aligned and
+   within one segment, and xdr_opaque_ref and xdr_bytes_ref point into
+   them on decode.  */
+
+#include <string.h>
+#include <stdint.h>
+#include <rpc/types.h>
+#include <rpc/xdr.h>
+#include "check.h"
+
+/* Aligned storage for the segments; they are cut into the lengths
+   below, one segment in each.  */
+static int32_t seg[6][8];
+static const size_t seglen[6] = { 8, 6, 2, 12, 0, 20 };
+#define SIZE 48
+
+static struct xdr_iovec iov[6];
+static char ref[SIZE], flat[SIZE];
+
+/* Gather the segments into flat[].  */
+static void
+gather (void)
+{
+  size_t i, pos = 0;
+
+  for (i = 0; i < 6; i++)
+    {
+      memcpy (flat + pos, iov[i].iov_base, iov[i].iov_len);
+      pos += iov[i].iov_len;
+    }
+}
+
+/* The sequence below at the positions noted:  an int and a u_int fill
+   the first segment, a hyper crosses the next two, counted bytes sit in
+   the fourth, an empty count is followed by an empty segment, and
+   opaque data and two ints fill the last.  */
+static bool_t
+xdr_seq (XDR *xdrs, int *i, u_int *u, quad_t *h, char **b, u_int *blen,
+	 char **e, u_int *elen, char **o, int32_t *w)
+{
+  return (xdr_int (xdrs, i)				/* 0 */
+	  && xdr_u_int (xdrs, u)			/* 4 */
+	  && xdr_hyper (xdrs, h)			/* 8 */
+	  && xdr_bytes_ref (xdrs, b, blen, 5)		/* 16 */
+	  && xdr_bytes_ref (xdrs, e, elen, 5)		/* 28 */
+	  && xdr_opaque_ref (xdrs, o, 6)		/* 32 */
+	  && xdr_int32_t (xdrs, &w[0])			/* 40 */
+	  && xdr_int32_t (xdrs, &w[1]));		/* 44 */
+}
+
+int
+main (void)
+{
+  int i = -5, di;
+  u_int u = 0xdeadbeef, du, blen = 5, elen = 0, dblen, delen;
+  quad_t h = 0x0102030405060708LL, dh;
+  char *b = "hello", *e = "", *o = "abcdef", *db, *de, *dob;
+  int32_t w[2] = { 7, -8 }, dw[2];
+  u_int32_t v[SIZE / 4], dv[SIZE / 4];
+  struct xdr_iovec one;
+  XDR x, m;
+  size_t k;
+
+  for (k = 0; k < 6; k++)
+    {
+      iov[k].iov_base = seg[k];
+      iov[k].iov_len = seglen[k];
+    }
+
+  /* Encoding writes what a memory stream writes; the opaque data go
+     through xdr_opaque and get zero padding.  */
+  memset (seg, 0x5a, sizeof (seg));
+  memset (ref, 0xa5, sizeof (ref));
+  xdriov_create (&x, iov, 6, XDR_ENCODE);
+  xdrmem_create (&m, ref, SIZE, XDR_ENCODE);
+  CHECK (xdr_seq (&x, &i, &u, &h, &b, &blen, &e, &elen, &o, w));
+  CHECK (xdr_seq (&m, &i, &u, &h, &b, &blen, &e, &elen, &o, w));
+  CHECK (XDR_GETPOS (&x) == SIZE);
+  CHECK (!xdr_int (&x, &i));
+  gather ();
+  CHECK (memcmp (flat, ref, SIZE) == 0);
+  CHECK (memcmp (flat + 20, "hello\0\0\0", 8) == 0);
+  XDR_DESTROY (&x);
+
+  /* Decoding gets it back; the data are not copied but pointed at.  */
+  xdriov_create (&x, iov, 6, XDR_DECODE);
+  de = e;
+  CHECK (xdr_seq (&x, &di, &du, &dh, &db, &dblen, &de, &delen, &dob, dw));
+  CHECK (di == i && du == u && dh == h && dw[0] == w[0] && dw[1] == w[1]);
+  CHECK (dblen == 5 && db == (char *) seg[3] + 4);
+  CHECK (memcmp (db, "hello", 5) == 0);
+  CHECK (delen == 0 && de == NULL);
+  CHECK (dob == (char *) seg[5] + 4 && memcmp (dob, "abcdef", 6) == 0);
+  CHECK (!xdr_int (&x, &di));
+
+  /* Positions move between segments, and a run which crosses one is
+     not lent out and leaves the stream where it was.  */
+  CHECK (XDR_SETPOS (&x, 16));
+  CHECK (xdr_bytes_ref (&x, &db, &dblen, 5) && db == (char *) seg[3] + 4);
+  CHECK (XDR_GETPOS (&x) == 28);
+  CHECK (XDR_SETPOS (&x, 8));
+  CHECK (!xdr_opaque_ref (&x, &db, 8));
+  CHECK (XDR_GETPOS (&x) == 8);
+  CHECK (xdr_hyper (&x, &dh) && dh == h);
+  CHECK (XDR_SETPOS (&x, 16));
+  CHECK (!xdr_bytes_ref (&x, &db, &dblen, 4));
+  CHECK (XDR_SETPOS (&x, SIZE) && XDR_GETPOS (&x) == SIZE);
+  CHECK (!XDR_SETPOS (&x, SIZE + 1));
+  CHECK (!xdr_opaque_ref (&x, &db, 4));
+  XDR_DESTROY (&x);
+
+  /* Arrays are converted in place where they can be and element by
+     element across the segment boundaries.  */
+  for (k = 0; k < SIZE / 4; k++)
+    v[k] = 0x01020304u * (k + 1);
+  memset (seg, 0x5a, sizeof (seg));
+  xdriov_create (&x, iov, 6, XDR_ENCODE);
+  xdrmem_create (&m, ref, SIZE, XDR_ENCODE);
+  CHECK (xdr_uint32_array (&x, v, SIZE / 4));
+  CHECK (xdr_uint32_array (&m, v, SIZE / 4));
+  gather ();
+  CHECK (memcmp (flat, ref, SIZE) == 0);
+  XDR_DESTROY (&x);
+  xdriov_create (&x, iov, 6, XDR_DECODE);
+  CHECK (xdr_uint32_array (&x, dv, SIZE / 4));
+  CHECK (memcmp (dv, v, sizeof (v)) == 0);
+  CHECK (!xdr_uint32_array (&x, dv, 1));
+  XDR_DESTROY (&x);
+
+  /* An unaligned segment is read through copies only.  */
+  one.iov_base = (char *) seg[0] + 1;
+  one.iov_len = 8;
+  xdriov_create (&x, &one, 1, XDR_ENCODE);
+  CHECK (xdr_opaque_ref (&x, &o, 6));
+  XDR_DESTROY (&x);
+  xdriov_create (&x, &one, 1, XDR_DECODE);
+  CHECK (!xdr_opaque_ref (&x, &dob, 6));
+  CHECK (XDR_GETPOS (&x) == 0);
+  CHECK (xdr_opaque (&x, flat, 6) && memcmp (flat, "abcdef", 6) == 0);
+  XDR_DESTROY (&x);
+
+  /* No segments at all.  */
+  xdriov_create (&x, NULL, 0, XDR_DECODE);
+  CHECK (XDR_GETPOS (&x) == 0);
+  CHECK (!xdr_int (&x, &di));
+  CHECK (xdr_opaque_ref (&x, &dob, 0) && dob == NULL);
+  XDR_DESTROY (&x);
+
+  exit (0);
+}